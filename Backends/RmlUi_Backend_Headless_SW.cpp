@@ -0,0 +1,130 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#include "RmlUi_Backend.h"
+#include "RmlUi_Renderer_SW.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/Log.h>
+#include <RmlUi/Core/SystemInterface.h>
+#include <chrono>
+
+/**
+    System interface without any windowing, the elapsed time is measured from the creation of the interface.
+ */
+class SystemInterface_Headless : public Rml::SystemInterface {
+public:
+	SystemInterface_Headless() : start_time(std::chrono::steady_clock::now()) {}
+
+	double GetElapsedTime() override
+	{
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+		return elapsed.count();
+	}
+
+private:
+	std::chrono::steady_clock::time_point start_time;
+};
+
+/**
+    Global data used by this backend.
+
+    Lifetime governed by the calls to Backend::Initialize() and Backend::Shutdown().
+ */
+struct BackendData {
+	SystemInterface_Headless system_interface;
+	RenderInterface_SW render_interface;
+
+	bool running = true;
+};
+static Rml::UniquePtr<BackendData> data;
+
+bool Backend::Initialize(const char* window_name, int width, int height, bool /*allow_resize*/)
+{
+	RMLUI_ASSERT(!data);
+
+	data = Rml::MakeUnique<BackendData>();
+	data->render_interface.SetViewport(width, height);
+
+	data->system_interface.LogMessage(Rml::Log::LT_INFO,
+		Rml::CreateString("Rendering '%s' headless in software at %dx%d.", window_name ? window_name : "", width, height));
+
+	return true;
+}
+
+void Backend::Shutdown()
+{
+	RMLUI_ASSERT(data);
+	data.reset();
+}
+
+Rml::SystemInterface* Backend::GetSystemInterface()
+{
+	RMLUI_ASSERT(data);
+	return &data->system_interface;
+}
+
+Rml::RenderInterface* Backend::GetRenderInterface()
+{
+	RMLUI_ASSERT(data);
+	return &data->render_interface;
+}
+
+bool Backend::ProcessEvents(Rml::Context* context, KeyDownCallback /*key_down_callback*/, bool /*power_save*/)
+{
+	RMLUI_ASSERT(data && context);
+
+	// There are no input events without a window, only keep the context dimensions in sync with the framebuffer.
+	const Rml::Vector2i dimensions = data->render_interface.GetFramebufferDimensions();
+	if (context->GetDimensions() != dimensions)
+		context->SetDimensions(dimensions);
+
+	bool result = data->running;
+	data->running = true;
+	return result;
+}
+
+void Backend::RequestExit()
+{
+	RMLUI_ASSERT(data);
+	data->running = false;
+}
+
+void Backend::BeginFrame()
+{
+	RMLUI_ASSERT(data);
+	data->render_interface.BeginFrame();
+	data->render_interface.Clear();
+}
+
+void Backend::PresentFrame()
+{
+	RMLUI_ASSERT(data);
+	data->render_interface.EndFrame();
+}
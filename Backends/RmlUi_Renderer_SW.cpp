@@ -0,0 +1,1311 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "RmlUi_Renderer_SW.h"
+#include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/Dictionary.h>
+#include <RmlUi/Core/FileInterface.h>
+#include <RmlUi/Core/Log.h>
+#include <RmlUi/Core/Math.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+
+using Rml::byte;
+using Pixel = Rml::ColourbPremultiplied;
+using Framebuffer = RenderInterface_SW::Framebuffer;
+
+// Draw calls covering fewer pixels than this are rasterized on the calling thread only.
+static constexpr int ParallelPixelThreshold = 128 * 128;
+// Sub-pixel precision of vertex positions during rasterization.
+static constexpr int SubpixelBits = 8;
+static constexpr int SubpixelScale = 1 << SubpixelBits;
+
+// Exact division of x by 255 for x in [0, 255*255].
+static inline int Div255(int x)
+{
+	x += 128;
+	return (x + (x >> 8)) >> 8;
+}
+
+static inline int64_t FloorDiv(int64_t a, int64_t b)
+{
+	RMLUI_ASSERT(b > 0);
+	return (a >= 0 ? a / b : -((-a + b - 1) / b));
+}
+
+static inline int64_t CeilDiv(int64_t a, int64_t b)
+{
+	return -FloorDiv(-a, b);
+}
+
+struct GeometrySW {
+	Rml::Vector<Rml::Vertex> vertices;
+	Rml::Vector<int> indices;
+	// True if all vertices share the same colour, enabling the constant colour span fill.
+	bool uniform_colour = false;
+};
+
+struct TextureSW {
+	Rml::Vector2i dimensions;
+	Rml::Vector<Pixel> pixels;
+};
+
+enum class FilterType { Invalid = 0, Passthrough, Blur, DropShadow, ColorMatrix, MaskImage };
+struct CompiledFilter {
+	FilterType type;
+
+	// Passthrough
+	float blend_factor;
+
+	// Blur
+	float sigma;
+
+	// Drop shadow
+	Rml::Vector2f offset;
+	Rml::ColourbPremultiplied color;
+
+	// ColorMatrix
+	Rml::Matrix4f color_matrix;
+};
+
+/*
+    A triangle prepared for scanline rasterization.
+
+    The edge functions are evaluated at pixel centers in fixed-point, using a top-left fill rule so that adjacent triangles never
+    cover the same pixel twice. The attributes are interpolated in floating-point through plane equations evaluated at pixel centers.
+*/
+struct TriangleSW {
+	enum Attribute { Red, Green, Blue, Alpha, U, V, Q, NumAttributes };
+
+	int x_begin, x_end, y_begin, y_end;
+
+	// Pixel (x, y) is covered iff: a*x + b*y + c >= 0, for each edge.
+	int64_t a[3], b[3], c[3];
+
+	// Attribute value at pixel (x, y): plane[i][0] + x * plane[i][1] + y * plane[i][2].
+	float plane[NumAttributes][3];
+
+	// Determine the covered span [x_begin, x_end) of the given row, restricted to the given column range.
+	bool GetSpan(int y, int clip_x_begin, int clip_x_end, int& out_begin, int& out_end) const
+	{
+		int64_t lo = Rml::Math::Max(x_begin, clip_x_begin);
+		int64_t hi = Rml::Math::Min(x_end, clip_x_end);
+
+		for (int i = 0; i < 3 && lo < hi; i++)
+		{
+			const int64_t k = b[i] * y + c[i];
+			if (a[i] > 0)
+				lo = std::max(lo, CeilDiv(-k, a[i]));
+			else if (a[i] < 0)
+				hi = std::min(hi, FloorDiv(k, -a[i]) + 1);
+			else if (k < 0)
+				return false;
+		}
+
+		out_begin = (int)lo;
+		out_end = (int)hi;
+		return lo < hi;
+	}
+
+	float Evaluate(int attribute, float x, float y) const { return plane[attribute][0] + x * plane[attribute][1] + y * plane[attribute][2]; }
+};
+
+// A vertex projected to screen space, with a perspective divisor q = 1/w.
+struct ScreenVertex {
+	float x, y, q;
+};
+
+// Prepares the triangle, returns false if it is degenerate or does not cover any part of the clip region.
+static bool SetupTriangle(TriangleSW& tri, const ScreenVertex* sv[3], const Rml::Vertex* v[3], bool perspective, Rml::Rectanglei clip)
+{
+	constexpr float max_coordinate = 1.0e6f;
+	int64_t X[3], Y[3];
+	for (int i = 0; i < 3; i++)
+	{
+		X[i] = (int64_t)std::lround(Rml::Math::Clamp(sv[i]->x, -max_coordinate, max_coordinate) * SubpixelScale);
+		Y[i] = (int64_t)std::lround(Rml::Math::Clamp(sv[i]->y, -max_coordinate, max_coordinate) * SubpixelScale);
+	}
+
+	int64_t area = (X[1] - X[0]) * (Y[2] - Y[0]) - (Y[1] - Y[0]) * (X[2] - X[0]);
+	if (area == 0)
+		return false;
+	if (area < 0)
+	{
+		std::swap(X[1], X[2]);
+		std::swap(Y[1], Y[2]);
+		std::swap(sv[1], sv[2]);
+		std::swap(v[1], v[2]);
+		area = -area;
+	}
+
+	// Pixel bounds, conservatively including any pixel center inside the triangle's bounding box.
+	const int64_t min_x = std::min({X[0], X[1], X[2]}), max_x = std::max({X[0], X[1], X[2]});
+	const int64_t min_y = std::min({Y[0], Y[1], Y[2]}), max_y = std::max({Y[0], Y[1], Y[2]});
+	tri.x_begin = (int)Rml::Math::Max<int64_t>(FloorDiv(min_x, SubpixelScale), clip.Left());
+	tri.x_end = (int)Rml::Math::Min<int64_t>(FloorDiv(max_x, SubpixelScale) + 1, clip.Right());
+	tri.y_begin = (int)Rml::Math::Max<int64_t>(FloorDiv(min_y, SubpixelScale), clip.Top());
+	tri.y_end = (int)Rml::Math::Min<int64_t>(FloorDiv(max_y, SubpixelScale) + 1, clip.Bottom());
+	if (tri.x_begin >= tri.x_end || tri.y_begin >= tri.y_end)
+		return false;
+
+	for (int i = 0; i < 3; i++)
+	{
+		const int j = (i + 1) % 3;
+		const int64_t A = Y[i] - Y[j];
+		const int64_t B = X[j] - X[i];
+		const int64_t C = X[i] * Y[j] - Y[i] * X[j];
+
+		// Top-left rule: Exactly one of two opposing edges owns the pixels centered on the edge.
+		const bool owns_edge = (A > 0 || (A == 0 && B < 0));
+		const int64_t bias = (owns_edge ? 0 : -1);
+
+		// Pixel centers are located at (x + 0.5, y + 0.5).
+		tri.a[i] = A * SubpixelScale;
+		tri.b[i] = B * SubpixelScale;
+		tri.c[i] = (A + B) * (SubpixelScale / 2) + C + bias;
+	}
+
+	// Set up the attribute planes, using the snapped positions for consistency with the coverage.
+	const float x0 = float(X[0]) / SubpixelScale, y0 = float(Y[0]) / SubpixelScale;
+	const float dx1 = float(X[1] - X[0]) / SubpixelScale, dy1 = float(Y[1] - Y[0]) / SubpixelScale;
+	const float dx2 = float(X[2] - X[0]) / SubpixelScale, dy2 = float(Y[2] - Y[0]) / SubpixelScale;
+	const float inv_area = 1.f / (dx1 * dy2 - dx2 * dy1);
+
+	float values[3][TriangleSW::NumAttributes];
+	for (int i = 0; i < 3; i++)
+	{
+		const float q = (perspective ? sv[i]->q : 1.f);
+		values[i][TriangleSW::Red] = v[i]->colour.red;
+		values[i][TriangleSW::Green] = v[i]->colour.green;
+		values[i][TriangleSW::Blue] = v[i]->colour.blue;
+		values[i][TriangleSW::Alpha] = v[i]->colour.alpha;
+		values[i][TriangleSW::U] = v[i]->tex_coord.x * q;
+		values[i][TriangleSW::V] = v[i]->tex_coord.y * q;
+		values[i][TriangleSW::Q] = q;
+	}
+
+	for (int attribute = 0; attribute < TriangleSW::NumAttributes; attribute++)
+	{
+		const float f0 = values[0][attribute];
+		const float df1 = values[1][attribute] - f0;
+		const float df2 = values[2][attribute] - f0;
+		const float dfdx = (df1 * dy2 - df2 * dy1) * inv_area;
+		const float dfdy = (df2 * dx1 - df1 * dx2) * inv_area;
+
+		// Offset the plane to evaluate at pixel centers given integer pixel coordinates.
+		tri.plane[attribute][0] = f0 + (0.5f - x0) * dfdx + (0.5f - y0) * dfdy;
+		tri.plane[attribute][1] = dfdx;
+		tri.plane[attribute][2] = dfdy;
+	}
+
+	return true;
+}
+
+static inline Pixel SampleBilinear(const TextureSW& texture, float u, float v)
+{
+	const int width = texture.dimensions.x;
+	const int height = texture.dimensions.y;
+
+	// Convert to 8-bit fixed-point texel coordinates relative to texel centers.
+	const int tx = int(std::floor((u * width - 0.5f) * 256.f));
+	const int ty = int(std::floor((v * height - 0.5f) * 256.f));
+	const int fx = tx & 255;
+	const int fy = ty & 255;
+	const int x0 = Rml::Math::Clamp(tx >> 8, 0, width - 1);
+	const int y0 = Rml::Math::Clamp(ty >> 8, 0, height - 1);
+	const int x1 = Rml::Math::Min(x0 + 1, width - 1);
+	const int y1 = Rml::Math::Min(y0 + 1, height - 1);
+
+	const byte* p00 = &texture.pixels[y0 * width + x0].red;
+	const byte* p10 = &texture.pixels[y0 * width + x1].red;
+	const byte* p01 = &texture.pixels[y1 * width + x0].red;
+	const byte* p11 = &texture.pixels[y1 * width + x1].red;
+
+	Pixel result;
+	byte* out = &result.red;
+	for (int i = 0; i < 4; i++)
+	{
+		const int top = p00[i] * (256 - fx) + p10[i] * fx;
+		const int bottom = p01[i] * (256 - fx) + p11[i] * fx;
+		out[i] = byte((top * (256 - fy) + bottom * fy + (1 << 15)) >> 16);
+	}
+	return result;
+}
+
+// Source-over blending of premultiplied colors.
+static inline void BlendPixel(Pixel& destination, Pixel source)
+{
+	const int inv_alpha = 255 - source.alpha;
+	destination.red = byte(source.red + Div255(destination.red * inv_alpha));
+	destination.green = byte(source.green + Div255(destination.green * inv_alpha));
+	destination.blue = byte(source.blue + Div255(destination.blue * inv_alpha));
+	destination.alpha = byte(source.alpha + Div255(destination.alpha * inv_alpha));
+}
+
+// Fills a span with a constant color. Written as a flat loop over bytes so that it can be vectorized by the compiler.
+static void FillSpanConstant(Pixel* destination, int count, Pixel color, const byte* mask, byte mask_test_value)
+{
+	byte* dst = &destination->red;
+	const byte src[4] = {color.red, color.green, color.blue, color.alpha};
+	const int inv_alpha = 255 - color.alpha;
+
+	if (!mask)
+	{
+		if (color.alpha == 255)
+		{
+			for (int i = 0; i < count; i++)
+				destination[i] = color;
+			return;
+		}
+
+		for (int i = 0; i < count * 4; i++)
+			dst[i] = byte(src[i & 3] + Div255(dst[i] * inv_alpha));
+	}
+	else
+	{
+		for (int i = 0; i < count * 4; i++)
+		{
+			const byte blended = byte(src[i & 3] + Div255(dst[i] * inv_alpha));
+			dst[i] = (mask[i >> 2] == mask_test_value ? blended : dst[i]);
+		}
+	}
+}
+
+/*
+    A minimal pool of worker threads for splitting rasterization work into bands.
+*/
+class RenderInterface_SW::WorkerPool {
+public:
+	explicit WorkerPool(int num_workers)
+	{
+		for (int i = 0; i < num_workers; i++)
+			threads.emplace_back([this] { WorkerLoop(); });
+	}
+
+	~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			exit = true;
+		}
+		wake_condition.notify_all();
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+
+	int GetNumThreads() const { return (int)threads.size() + 1; }
+
+	// Calls the function once for every index in [0, count), and returns when all calls have finished. The calling thread participates.
+	void ParallelFor(int count, const Rml::Function<void(int)>& function)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			job = &function;
+			job_count = count;
+			next_index = 0;
+			num_active_workers = (int)threads.size();
+			generation += 1;
+		}
+		wake_condition.notify_all();
+
+		RunJob(function, count);
+
+		std::unique_lock<std::mutex> lock(mutex);
+		done_condition.wait(lock, [this] { return num_active_workers == 0; });
+		job = nullptr;
+	}
+
+private:
+	void RunJob(const Rml::Function<void(int)>& function, int count)
+	{
+		for (int i = next_index++; i < count; i = next_index++)
+			function(i);
+	}
+
+	void WorkerLoop()
+	{
+		uint64_t seen_generation = 0;
+		while (true)
+		{
+			const Rml::Function<void(int)>* function = nullptr;
+			int count = 0;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake_condition.wait(lock, [&] { return exit || generation != seen_generation; });
+				if (exit)
+					return;
+				seen_generation = generation;
+				function = job;
+				count = job_count;
+			}
+
+			RunJob(*function, count);
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				num_active_workers -= 1;
+			}
+			done_condition.notify_one();
+		}
+	}
+
+	Rml::Vector<std::thread> threads;
+
+	std::mutex mutex;
+	std::condition_variable wake_condition;
+	std::condition_variable done_condition;
+
+	const Rml::Function<void(int)>* job = nullptr;
+	int job_count = 0;
+	std::atomic<int> next_index{0};
+	int num_active_workers = 0;
+	uint64_t generation = 0;
+	bool exit = false;
+};
+
+/*
+    Describes where a rasterized geometry is written.
+*/
+struct RenderInterface_SW::Target {
+	enum class Type { Color, ClipMaskReplace, ClipMaskIncrement };
+	Type type = Type::Color;
+	Framebuffer* framebuffer = nullptr;
+	// Value written by ClipMaskReplace, or the value which is incremented by ClipMaskIncrement.
+	byte mask_value = 0;
+};
+
+RenderInterface_SW::RenderInterface_SW(int num_threads)
+{
+	if (num_threads <= 0)
+		num_threads = Rml::Math::Max((int)std::thread::hardware_concurrency(), 1);
+
+	if (num_threads > 1)
+		worker_pool = Rml::MakeUnique<WorkerPool>(num_threads - 1);
+
+	transform = Rml::Matrix4f::Identity();
+}
+
+RenderInterface_SW::~RenderInterface_SW() {}
+
+void RenderInterface_SW::SetViewport(int width, int height)
+{
+	viewport_width = Rml::Math::Max(width, 0);
+	viewport_height = Rml::Math::Max(height, 0);
+}
+
+void RenderInterface_SW::BeginFrame()
+{
+	clip_mask.assign(size_t(viewport_width * viewport_height), byte(0));
+	clip_mask_enabled = false;
+	clip_mask_test_value = 0;
+	scissor_enabled = false;
+	SetTransform(nullptr);
+
+	layers_size = 0;
+	PushLayer();
+}
+
+void RenderInterface_SW::EndFrame()
+{
+	RMLUI_ASSERTMSG(layers_size == 1, "Layer stack should only contain the base layer at the end of the frame.");
+}
+
+void RenderInterface_SW::Clear()
+{
+	Framebuffer& framebuffer = GetTopLayer();
+	std::fill(framebuffer.pixels.begin(), framebuffer.pixels.end(), Pixel(0, 0, 0, 255));
+}
+
+Rml::CompiledGeometryHandle RenderInterface_SW::CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices)
+{
+	GeometrySW* geometry = new GeometrySW;
+	geometry->vertices.assign(vertices.begin(), vertices.end());
+	geometry->indices.assign(indices.begin(), indices.end());
+	geometry->uniform_colour = std::all_of(vertices.begin(), vertices.end(),
+		[&](const Rml::Vertex& vertex) { return vertex.colour == vertices[0].colour; });
+
+	return reinterpret_cast<Rml::CompiledGeometryHandle>(geometry);
+}
+
+void RenderInterface_SW::RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture)
+{
+	Target target;
+	target.type = Target::Type::Color;
+	target.framebuffer = &GetTopLayer();
+	Rasterize(target, handle, translation, texture);
+}
+
+void RenderInterface_SW::ReleaseGeometry(Rml::CompiledGeometryHandle handle)
+{
+	delete reinterpret_cast<GeometrySW*>(handle);
+}
+
+void RenderInterface_SW::Rasterize(const Target& target, Rml::CompiledGeometryHandle handle, Rml::Vector2f translation,
+	Rml::TextureHandle texture_handle)
+{
+	const GeometrySW& geometry = *reinterpret_cast<const GeometrySW*>(handle);
+	const TextureSW* texture = reinterpret_cast<const TextureSW*>(texture_handle);
+
+	const Rml::Rectanglei clip = GetActiveRegion();
+	if (clip.Width() <= 0 || clip.Height() <= 0 || geometry.indices.empty())
+		return;
+
+	// Project all vertices to screen space.
+	const size_t num_vertices = geometry.vertices.size();
+	Rml::Vector<ScreenVertex> screen_vertices(num_vertices);
+	bool perspective = false;
+
+	for (size_t i = 0; i < num_vertices; i++)
+	{
+		const Rml::Vector2f position = geometry.vertices[i].position + translation;
+		ScreenVertex& sv = screen_vertices[i];
+		if (transform_enabled)
+		{
+			const Rml::Vector4f p = transform * Rml::Vector4f(position.x, position.y, 0.f, 1.f);
+			sv.q = (p.w > 0.f ? 1.f / p.w : 0.f);
+			sv.x = p.x * sv.q;
+			sv.y = p.y * sv.q;
+			perspective |= (p.w != 1.f);
+		}
+		else
+		{
+			sv = ScreenVertex{position.x, position.y, 1.f};
+		}
+	}
+
+	// Set up all triangles up front, so that each band only needs to find the triangles overlapping it.
+	Rml::Vector<TriangleSW> triangles;
+	triangles.reserve(geometry.indices.size() / 3);
+	int64_t covered_pixels = 0;
+
+	for (size_t i = 0; i + 2 < geometry.indices.size(); i += 3)
+	{
+		const ScreenVertex* sv[3];
+		const Rml::Vertex* v[3];
+		bool behind_viewer = false;
+		for (int j = 0; j < 3; j++)
+		{
+			const int index = geometry.indices[i + j];
+			sv[j] = &screen_vertices[index];
+			v[j] = &geometry.vertices[index];
+			behind_viewer |= (sv[j]->q <= 0.f);
+		}
+		if (behind_viewer)
+			continue;
+
+		TriangleSW tri;
+		if (SetupTriangle(tri, sv, v, perspective, clip))
+		{
+			covered_pixels += int64_t(tri.x_end - tri.x_begin) * int64_t(tri.y_end - tri.y_begin);
+			triangles.push_back(tri);
+		}
+	}
+
+	if (triangles.empty())
+		return;
+
+	const bool use_mask = (clip_mask_enabled && target.type == Target::Type::Color);
+	const byte mask_test_value = clip_mask_test_value;
+	const bool constant_color = (geometry.uniform_colour && !texture && !geometry.vertices.empty());
+	const Pixel uniform_color = (geometry.vertices.empty() ? Pixel() : geometry.vertices[0].colour);
+	const int width = viewport_width;
+
+	auto RasterizeBand = [&](int band_begin, int band_end) {
+		for (const TriangleSW& tri : triangles)
+		{
+			const int y_begin = Rml::Math::Max(tri.y_begin, band_begin);
+			const int y_end = Rml::Math::Min(tri.y_end, band_end);
+
+			for (int y = y_begin; y < y_end; y++)
+			{
+				int x_begin = 0, x_end = 0;
+				if (!tri.GetSpan(y, clip.Left(), clip.Right(), x_begin, x_end))
+					continue;
+
+				const int row_offset = y * width;
+
+				if (target.type != Target::Type::Color)
+				{
+					byte* mask_row = clip_mask.data() + row_offset;
+					if (target.type == Target::Type::ClipMaskReplace)
+					{
+						std::fill(mask_row + x_begin, mask_row + x_end, target.mask_value);
+					}
+					else
+					{
+						for (int x = x_begin; x < x_end; x++)
+							mask_row[x] = (mask_row[x] == target.mask_value ? byte(target.mask_value + 1) : mask_row[x]);
+					}
+					continue;
+				}
+
+				Pixel* dst = target.framebuffer->pixels.data() + row_offset;
+				const byte* mask_row = (use_mask ? clip_mask.data() + row_offset : nullptr);
+
+				if (constant_color)
+				{
+					FillSpanConstant(dst + x_begin, x_end - x_begin, uniform_color, mask_row ? mask_row + x_begin : nullptr, mask_test_value);
+					continue;
+				}
+
+				// Interpolate the attributes incrementally along the span.
+				float attributes[TriangleSW::NumAttributes];
+				float steps[TriangleSW::NumAttributes];
+				for (int i = 0; i < TriangleSW::NumAttributes; i++)
+				{
+					attributes[i] = tri.Evaluate(i, float(x_begin), float(y));
+					steps[i] = tri.plane[i][1];
+				}
+
+				for (int x = x_begin; x < x_end; x++)
+				{
+					if (!mask_row || mask_row[x] == mask_test_value)
+					{
+						Pixel color(byte(Rml::Math::Clamp(attributes[TriangleSW::Red], 0.f, 255.f) + 0.5f),
+							byte(Rml::Math::Clamp(attributes[TriangleSW::Green], 0.f, 255.f) + 0.5f),
+							byte(Rml::Math::Clamp(attributes[TriangleSW::Blue], 0.f, 255.f) + 0.5f),
+							byte(Rml::Math::Clamp(attributes[TriangleSW::Alpha], 0.f, 255.f) + 0.5f));
+
+						if (texture)
+						{
+							const float w = (perspective ? 1.f / attributes[TriangleSW::Q] : 1.f);
+							const Pixel texel = SampleBilinear(*texture, attributes[TriangleSW::U] * w, attributes[TriangleSW::V] * w);
+							color = Pixel(byte(Div255(texel.red * color.red)), byte(Div255(texel.green * color.green)),
+								byte(Div255(texel.blue * color.blue)), byte(Div255(texel.alpha * color.alpha)));
+						}
+
+						BlendPixel(dst[x], color);
+					}
+
+					for (int i = 0; i < TriangleSW::NumAttributes; i++)
+						attributes[i] += steps[i];
+				}
+			}
+		}
+	};
+
+	if (covered_pixels < ParallelPixelThreshold)
+		RasterizeBand(clip.Top(), clip.Bottom());
+	else
+		ForEachBand(clip.Top(), clip.Bottom(), 16, RasterizeBand);
+}
+
+void RenderInterface_SW::ForEachBand(int row_begin, int row_end, int min_rows_per_band, const Rml::Function<void(int, int)>& function)
+{
+	const int num_rows = row_end - row_begin;
+	if (num_rows <= 0)
+		return;
+
+	const int num_threads = (worker_pool ? worker_pool->GetNumThreads() : 1);
+	if (num_threads == 1 || num_rows < 2 * min_rows_per_band)
+	{
+		function(row_begin, row_end);
+		return;
+	}
+
+	// Use a few bands per thread for load balancing, as the work is rarely evenly distributed across the rows.
+	const int rows_per_band = Rml::Math::Max(min_rows_per_band, (num_rows + 4 * num_threads - 1) / (4 * num_threads));
+	const int num_bands = (num_rows + rows_per_band - 1) / rows_per_band;
+
+	worker_pool->ParallelFor(num_bands, [&](int band) {
+		const int band_begin = row_begin + band * rows_per_band;
+		function(band_begin, Rml::Math::Min(band_begin + rows_per_band, row_end));
+	});
+}
+
+// Set to byte packing, or the compiler will expand our struct, which means it won't read correctly from file
+#pragma pack(1)
+struct TGAHeader {
+	char idLength;
+	char colourMapType;
+	char dataType;
+	short int colourMapOrigin;
+	short int colourMapLength;
+	char colourMapDepth;
+	short int xOrigin;
+	short int yOrigin;
+	short int width;
+	short int height;
+	char bitsPerPixel;
+	char imageDescriptor;
+};
+// Restore packing
+#pragma pack()
+
+Rml::TextureHandle RenderInterface_SW::LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source)
+{
+	Rml::FileInterface* file_interface = Rml::GetFileInterface();
+	Rml::FileHandle file_handle = file_interface->Open(source);
+	if (!file_handle)
+	{
+		return false;
+	}
+
+	file_interface->Seek(file_handle, 0, SEEK_END);
+	size_t buffer_size = file_interface->Tell(file_handle);
+	file_interface->Seek(file_handle, 0, SEEK_SET);
+
+	if (buffer_size <= sizeof(TGAHeader))
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Texture file size is smaller than TGAHeader, file is not a valid TGA image.");
+		file_interface->Close(file_handle);
+		return false;
+	}
+
+	Rml::UniquePtr<byte[]> buffer(new byte[buffer_size]);
+	file_interface->Read(buffer.get(), buffer_size, file_handle);
+	file_interface->Close(file_handle);
+
+	TGAHeader header;
+	memcpy(&header, buffer.get(), sizeof(TGAHeader));
+
+	int color_mode = header.bitsPerPixel / 8;
+	const size_t image_size = header.width * header.height * 4; // We always make 32bit textures
+
+	if (header.dataType != 2)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Only 24/32bit uncompressed TGAs are supported.");
+		return false;
+	}
+
+	// Ensure we have at least 3 colors
+	if (color_mode < 3)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Only 24 and 32bit textures are supported.");
+		return false;
+	}
+
+	const byte* image_src = buffer.get() + sizeof(TGAHeader);
+	Rml::UniquePtr<byte[]> image_dest_buffer(new byte[image_size]);
+	byte* image_dest = image_dest_buffer.get();
+
+	// Targa is BGR, swap to RGB, flip Y axis, and convert to premultiplied alpha.
+	for (long y = 0; y < header.height; y++)
+	{
+		long read_index = y * header.width * color_mode;
+		long write_index = ((header.imageDescriptor & 32) != 0) ? read_index : (header.height - y - 1) * header.width * 4;
+		for (long x = 0; x < header.width; x++)
+		{
+			image_dest[write_index] = image_src[read_index + 2];
+			image_dest[write_index + 1] = image_src[read_index + 1];
+			image_dest[write_index + 2] = image_src[read_index];
+			if (color_mode == 4)
+			{
+				const byte alpha = image_src[read_index + 3];
+				for (size_t j = 0; j < 3; j++)
+					image_dest[write_index + j] = byte((image_dest[write_index + j] * alpha) / 255);
+				image_dest[write_index + 3] = alpha;
+			}
+			else
+				image_dest[write_index + 3] = 255;
+
+			write_index += 4;
+			read_index += color_mode;
+		}
+	}
+
+	texture_dimensions.x = header.width;
+	texture_dimensions.y = header.height;
+
+	return GenerateTexture({image_dest, image_size}, texture_dimensions);
+}
+
+Rml::TextureHandle RenderInterface_SW::GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions)
+{
+	RMLUI_ASSERT(source_data.data() && source_data.size() == size_t(source_dimensions.x * source_dimensions.y * 4));
+	if (source_dimensions.x <= 0 || source_dimensions.y <= 0)
+	{
+		Rml::Log::Message(Rml::Log::LT_ERROR, "Failed to generate texture.");
+		return {};
+	}
+
+	TextureSW* texture = new TextureSW;
+	texture->dimensions = source_dimensions;
+	texture->pixels.resize(size_t(source_dimensions.x * source_dimensions.y));
+	memcpy(texture->pixels.data(), source_data.data(), source_data.size());
+
+	return reinterpret_cast<Rml::TextureHandle>(texture);
+}
+
+void RenderInterface_SW::ReleaseTexture(Rml::TextureHandle texture_handle)
+{
+	delete reinterpret_cast<TextureSW*>(texture_handle);
+}
+
+void RenderInterface_SW::EnableScissorRegion(bool enable)
+{
+	scissor_enabled = enable;
+}
+
+void RenderInterface_SW::SetScissorRegion(Rml::Rectanglei region)
+{
+	scissor_region = region;
+}
+
+void RenderInterface_SW::EnableClipMask(bool enable)
+{
+	clip_mask_enabled = enable;
+}
+
+void RenderInterface_SW::RenderToClipMask(Rml::ClipMaskOperation operation, Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation)
+{
+	using Rml::ClipMaskOperation;
+
+	Target target;
+
+	switch (operation)
+	{
+	case ClipMaskOperation::Set:
+	case ClipMaskOperation::SetInverse:
+	{
+		// Like a stencil buffer, the clip mask is only cleared inside the scissor region.
+		const Rml::Rectanglei region = GetActiveRegion();
+		for (int y = region.Top(); y < region.Bottom(); y++)
+			std::fill_n(clip_mask.data() + y * viewport_width + region.Left(), region.Width(), byte(0));
+
+		target.type = Target::Type::ClipMaskReplace;
+		target.mask_value = 1;
+		clip_mask_test_value = (operation == ClipMaskOperation::Set ? 1 : 0);
+	}
+	break;
+	case ClipMaskOperation::Intersect:
+	{
+		target.type = Target::Type::ClipMaskIncrement;
+		target.mask_value = clip_mask_test_value;
+		clip_mask_test_value += 1;
+	}
+	break;
+	}
+
+	Rasterize(target, geometry, translation, {});
+}
+
+void RenderInterface_SW::SetTransform(const Rml::Matrix4f* new_transform)
+{
+	transform_enabled = (new_transform != nullptr);
+	transform = (new_transform ? *new_transform : Rml::Matrix4f::Identity());
+}
+
+Rml::LayerHandle RenderInterface_SW::PushLayer()
+{
+	RMLUI_ASSERT(layers_size <= (int)layers.size());
+	if (layers_size == (int)layers.size())
+		layers.emplace_back();
+
+	const Rml::LayerHandle layer_handle = Rml::LayerHandle(layers_size);
+	layers_size += 1;
+
+	// Only the active region of new layers needs to be cleared, as the remaining pixels are never read.
+	Framebuffer& framebuffer = EnsureFramebuffer(GetLayer(layer_handle));
+	const Rml::Rectanglei region = GetActiveRegion();
+	for (int y = region.Top(); y < region.Bottom(); y++)
+		std::fill_n(framebuffer.pixels.data() + y * framebuffer.width + region.Left(), region.Width(), Pixel(0, 0, 0, 0));
+
+	return layer_handle;
+}
+
+void RenderInterface_SW::CompositeLayers(Rml::LayerHandle source_handle, Rml::LayerHandle destination_handle, Rml::BlendMode blend_mode,
+	Rml::Span<const Rml::CompiledFilterHandle> filters)
+{
+	const Rml::Rectanglei region = GetActiveRegion();
+	if (region.Width() <= 0 || region.Height() <= 0)
+		return;
+
+	const Framebuffer& source = GetLayer(source_handle);
+	Framebuffer& postprocess = EnsureFramebuffer(postprocess_primary);
+
+	for (int y = region.Top(); y < region.Bottom(); y++)
+	{
+		const size_t offset = size_t(y * viewport_width + region.Left());
+		std::copy_n(source.pixels.data() + offset, region.Width(), postprocess.pixels.data() + offset);
+	}
+
+	RenderFilters(filters);
+
+	Framebuffer& destination = GetLayer(destination_handle);
+	const Framebuffer& result = postprocess_primary;
+	const bool use_mask = clip_mask_enabled;
+	const byte mask_test_value = clip_mask_test_value;
+
+	ForEachBand(region.Top(), region.Bottom(), 16, [&](int band_begin, int band_end) {
+		for (int y = band_begin; y < band_end; y++)
+		{
+			const int offset = y * viewport_width;
+			const Pixel* src = result.pixels.data() + offset;
+			Pixel* dst = destination.pixels.data() + offset;
+			const byte* mask = (use_mask ? clip_mask.data() + offset : nullptr);
+
+			for (int x = region.Left(); x < region.Right(); x++)
+			{
+				if (mask && mask[x] != mask_test_value)
+					continue;
+				if (blend_mode == Rml::BlendMode::Replace)
+					dst[x] = src[x];
+				else
+					BlendPixel(dst[x], src[x]);
+			}
+		}
+	});
+}
+
+void RenderInterface_SW::PopLayer()
+{
+	RMLUI_ASSERT(layers_size > 1);
+	layers_size -= 1;
+}
+
+Rml::TextureHandle RenderInterface_SW::SaveLayerAsTexture()
+{
+	RMLUI_ASSERT(scissor_enabled);
+	const Rml::Rectanglei bounds = GetActiveRegion();
+	if (bounds.Width() <= 0 || bounds.Height() <= 0)
+		return {};
+
+	const Framebuffer& source = GetTopLayer();
+
+	TextureSW* texture = new TextureSW;
+	texture->dimensions = bounds.Size();
+	texture->pixels.resize(size_t(bounds.Width() * bounds.Height()));
+
+	for (int y = 0; y < bounds.Height(); y++)
+	{
+		const Pixel* src = source.pixels.data() + (bounds.Top() + y) * source.width + bounds.Left();
+		std::copy_n(src, bounds.Width(), texture->pixels.data() + y * bounds.Width());
+	}
+
+	return reinterpret_cast<Rml::TextureHandle>(texture);
+}
+
+Rml::CompiledFilterHandle RenderInterface_SW::SaveLayerAsMaskImage()
+{
+	const Framebuffer& source = GetTopLayer();
+	Framebuffer& destination = EnsureFramebuffer(blend_mask);
+
+	const Rml::Rectanglei region = GetActiveRegion();
+	for (int y = region.Top(); y < region.Bottom(); y++)
+	{
+		const size_t offset = size_t(y * viewport_width + region.Left());
+		std::copy_n(source.pixels.data() + offset, region.Width(), destination.pixels.data() + offset);
+	}
+
+	CompiledFilter filter = {};
+	filter.type = FilterType::MaskImage;
+	return reinterpret_cast<Rml::CompiledFilterHandle>(new CompiledFilter(std::move(filter)));
+}
+
+Rml::CompiledFilterHandle RenderInterface_SW::CompileFilter(const Rml::String& name, const Rml::Dictionary& parameters)
+{
+	CompiledFilter filter = {};
+
+	if (name == "opacity")
+	{
+		filter.type = FilterType::Passthrough;
+		filter.blend_factor = Rml::Get(parameters, "value", 1.0f);
+	}
+	else if (name == "blur")
+	{
+		filter.type = FilterType::Blur;
+		filter.sigma = Rml::Get(parameters, "sigma", 1.0f);
+	}
+	else if (name == "drop-shadow")
+	{
+		filter.type = FilterType::DropShadow;
+		filter.sigma = Rml::Get(parameters, "sigma", 0.f);
+		filter.color = Rml::Get(parameters, "color", Rml::Colourb()).ToPremultiplied();
+		filter.offset = Rml::Get(parameters, "offset", Rml::Vector2f(0.f));
+	}
+	else if (name == "brightness")
+	{
+		filter.type = FilterType::ColorMatrix;
+		const float value = Rml::Get(parameters, "value", 1.0f);
+		filter.color_matrix = Rml::Matrix4f::Diag(value, value, value, 1.f);
+	}
+	else if (name == "contrast")
+	{
+		filter.type = FilterType::ColorMatrix;
+		const float value = Rml::Get(parameters, "value", 1.0f);
+		const float grayness = 0.5f - 0.5f * value;
+		filter.color_matrix = Rml::Matrix4f::Diag(value, value, value, 1.f);
+		filter.color_matrix.SetColumn(3, Rml::Vector4f(grayness, grayness, grayness, 1.f));
+	}
+	else if (name == "invert")
+	{
+		filter.type = FilterType::ColorMatrix;
+		const float value = Rml::Math::Clamp(Rml::Get(parameters, "value", 1.0f), 0.f, 1.f);
+		const float inverted = 1.f - 2.f * value;
+		filter.color_matrix = Rml::Matrix4f::Diag(inverted, inverted, inverted, 1.f);
+		filter.color_matrix.SetColumn(3, Rml::Vector4f(value, value, value, 1.f));
+	}
+	else if (name == "grayscale")
+	{
+		filter.type = FilterType::ColorMatrix;
+		const float value = Rml::Get(parameters, "value", 1.0f);
+		const float rev_value = 1.f - value;
+		const Rml::Vector3f gray = value * Rml::Vector3f(0.2126f, 0.7152f, 0.0722f);
+		// clang-format off
+		filter.color_matrix = Rml::Matrix4f::FromRows(
+			{gray.x + rev_value, gray.y,             gray.z,             0.f},
+			{gray.x,             gray.y + rev_value, gray.z,             0.f},
+			{gray.x,             gray.y,             gray.z + rev_value, 0.f},
+			{0.f,                0.f,                0.f,                1.f}
+		);
+		// clang-format on
+	}
+	else if (name == "sepia")
+	{
+		filter.type = FilterType::ColorMatrix;
+		const float value = Rml::Get(parameters, "value", 1.0f);
+		const float rev_value = 1.f - value;
+		const Rml::Vector3f r_mix = value * Rml::Vector3f(0.393f, 0.769f, 0.189f);
+		const Rml::Vector3f g_mix = value * Rml::Vector3f(0.349f, 0.686f, 0.168f);
+		const Rml::Vector3f b_mix = value * Rml::Vector3f(0.272f, 0.534f, 0.131f);
+		// clang-format off
+		filter.color_matrix = Rml::Matrix4f::FromRows(
+			{r_mix.x + rev_value, r_mix.y,             r_mix.z,             0.f},
+			{g_mix.x,             g_mix.y + rev_value, g_mix.z,             0.f},
+			{b_mix.x,             b_mix.y,             b_mix.z + rev_value, 0.f},
+			{0.f,                 0.f,                 0.f,                 1.f}
+		);
+		// clang-format on
+	}
+	else if (name == "hue-rotate")
+	{
+		// Hue-rotation and saturation values based on: https://www.w3.org/TR/filter-effects-1/#attr-valuedef-type-huerotate
+		filter.type = FilterType::ColorMatrix;
+		const float value = Rml::Get(parameters, "value", 1.0f);
+		const float s = Rml::Math::Sin(value);
+		const float c = Rml::Math::Cos(value);
+		// clang-format off
+		filter.color_matrix = Rml::Matrix4f::FromRows(
+			{0.213f + 0.787f * c - 0.213f * s,  0.715f - 0.715f * c - 0.715f * s,  0.072f - 0.072f * c + 0.928f * s,  0.f},
+			{0.213f - 0.213f * c + 0.143f * s,  0.715f + 0.285f * c + 0.140f * s,  0.072f - 0.072f * c - 0.283f * s,  0.f},
+			{0.213f - 0.213f * c - 0.787f * s,  0.715f - 0.715f * c + 0.715f * s,  0.072f + 0.928f * c + 0.072f * s,  0.f},
+			{0.f,                               0.f,                               0.f,                               1.f}
+		);
+		// clang-format on
+	}
+	else if (name == "saturate")
+	{
+		filter.type = FilterType::ColorMatrix;
+		const float value = Rml::Get(parameters, "value", 1.0f);
+		// clang-format off
+		filter.color_matrix = Rml::Matrix4f::FromRows(
+			{0.213f + 0.787f * value,  0.715f - 0.715f * value,  0.072f - 0.072f * value,  0.f},
+			{0.213f - 0.213f * value,  0.715f + 0.285f * value,  0.072f - 0.072f * value,  0.f},
+			{0.213f - 0.213f * value,  0.715f - 0.715f * value,  0.072f + 0.928f * value,  0.f},
+			{0.f,                      0.f,                      0.f,                      1.f}
+		);
+		// clang-format on
+	}
+
+	if (filter.type != FilterType::Invalid)
+		return reinterpret_cast<Rml::CompiledFilterHandle>(new CompiledFilter(std::move(filter)));
+
+	Rml::Log::Message(Rml::Log::LT_WARNING, "Unsupported filter type '%s'.", name.c_str());
+	return {};
+}
+
+void RenderInterface_SW::ReleaseFilter(Rml::CompiledFilterHandle filter)
+{
+	delete reinterpret_cast<CompiledFilter*>(filter);
+}
+
+void RenderInterface_SW::RenderFilters(Rml::Span<const Rml::CompiledFilterHandle> filter_handles)
+{
+	const Rml::Rectanglei region = GetActiveRegion();
+
+	// Applies the function to every pixel of the primary postprocess buffer inside the active region.
+	auto ForEachPixel = [&](auto&& function) {
+		ForEachBand(region.Top(), region.Bottom(), 16, [&](int band_begin, int band_end) {
+			for (int y = band_begin; y < band_end; y++)
+			{
+				const int offset = y * viewport_width;
+				for (int x = region.Left(); x < region.Right(); x++)
+					function(postprocess_primary.pixels[offset + x], offset + x);
+			}
+		});
+	};
+
+	for (const Rml::CompiledFilterHandle filter_handle : filter_handles)
+	{
+		const CompiledFilter& filter = *reinterpret_cast<const CompiledFilter*>(filter_handle);
+		const FilterType type = filter.type;
+
+		switch (type)
+		{
+		case FilterType::Passthrough:
+		{
+			const int factor = int(Rml::Math::Clamp(filter.blend_factor, 0.f, 1.f) * 255.f + 0.5f);
+			ForEachPixel([factor](Pixel& pixel, int) {
+				pixel = Pixel(byte(Div255(pixel.red * factor)), byte(Div255(pixel.green * factor)), byte(Div255(pixel.blue * factor)),
+					byte(Div255(pixel.alpha * factor)));
+			});
+		}
+		break;
+		case FilterType::Blur:
+		{
+			RenderBlur(filter.sigma, postprocess_primary, EnsureFramebuffer(postprocess_secondary));
+		}
+		break;
+		case FilterType::DropShadow:
+		{
+			// Render the shadow from the offset alpha channel of the source, then blur it and draw the source on top.
+			Framebuffer& shadow = EnsureFramebuffer(postprocess_secondary);
+			const Rml::Vector2i offset = Rml::Vector2i(int(std::round(filter.offset.x)), int(std::round(filter.offset.y)));
+			const Pixel color = filter.color;
+
+			ForEachBand(region.Top(), region.Bottom(), 16, [&](int band_begin, int band_end) {
+				for (int y = band_begin; y < band_end; y++)
+				{
+					const int source_y = y - offset.y;
+					for (int x = region.Left(); x < region.Right(); x++)
+					{
+						const int source_x = x - offset.x;
+						int alpha = 0;
+						if (source_x >= region.Left() && source_x < region.Right() && source_y >= region.Top() && source_y < region.Bottom())
+							alpha = postprocess_primary.pixels[source_y * viewport_width + source_x].alpha;
+
+						shadow.pixels[y * viewport_width + x] = Pixel(byte(Div255(color.red * alpha)), byte(Div255(color.green * alpha)),
+							byte(Div255(color.blue * alpha)), byte(Div255(color.alpha * alpha)));
+					}
+				}
+			});
+
+			if (filter.sigma >= 0.5f)
+				RenderBlur(filter.sigma, shadow, EnsureFramebuffer(postprocess_tertiary));
+
+			ForEachPixel([&shadow](Pixel& pixel, int index) {
+				Pixel result = shadow.pixels[index];
+				BlendPixel(result, pixel);
+				pixel = result;
+			});
+		}
+		break;
+		case FilterType::ColorMatrix:
+		{
+			// Transform in premultiplied space, see the corresponding shader of the GL3 renderer.
+			const Rml::Matrix4f& m = filter.color_matrix;
+			ForEachPixel([&m](Pixel& pixel, int) {
+				const Rml::Vector4f color = m * Rml::Vector4f(pixel.red, pixel.green, pixel.blue, pixel.alpha);
+				const float max_value = float(pixel.alpha);
+				pixel.red = byte(Rml::Math::Clamp(color.x, 0.f, max_value) + 0.5f);
+				pixel.green = byte(Rml::Math::Clamp(color.y, 0.f, max_value) + 0.5f);
+				pixel.blue = byte(Rml::Math::Clamp(color.z, 0.f, max_value) + 0.5f);
+			});
+		}
+		break;
+		case FilterType::MaskImage:
+		{
+			const Framebuffer& mask = blend_mask;
+			ForEachPixel([&mask](Pixel& pixel, int index) {
+				const int alpha = mask.pixels[index].alpha;
+				pixel = Pixel(byte(Div255(pixel.red * alpha)), byte(Div255(pixel.green * alpha)), byte(Div255(pixel.blue * alpha)),
+					byte(Div255(pixel.alpha * alpha)));
+			});
+		}
+		break;
+		case FilterType::Invalid:
+		{
+			Rml::Log::Message(Rml::Log::LT_WARNING, "Unhandled render filter %d.", (int)type);
+		}
+		break;
+		}
+	}
+}
+
+// Returns the widths of successive box filters approximating a gaussian blur of the given standard deviation.
+static void SigmaToBoxSizes(float sigma, int num_boxes, int* out_sizes)
+{
+	const float ideal_width = Rml::Math::SquareRoot(12.f * sigma * sigma / float(num_boxes) + 1.f);
+	int lower_width = int(ideal_width);
+	if (lower_width % 2 == 0)
+		lower_width -= 1;
+	const int upper_width = lower_width + 2;
+
+	const float ideal_num_lower = (12.f * sigma * sigma - float(num_boxes * lower_width * lower_width) - 4.f * float(num_boxes * lower_width) -
+									  3.f * float(num_boxes)) /
+		(-4.f * float(lower_width) - 4.f);
+	const int num_lower = int(std::round(ideal_num_lower));
+
+	for (int i = 0; i < num_boxes; i++)
+		out_sizes[i] = (i < num_lower ? lower_width : upper_width);
+}
+
+// Box blur of a single line of pixels, pixels outside the line are considered transparent.
+static void BoxBlurLine(const Pixel* source, Pixel* destination, int count, int stride, int radius)
+{
+	const float scale = 1.f / float(2 * radius + 1);
+	float sum[4] = {};
+
+	auto Add = [&](int index, float sign) {
+		if (index < 0 || index >= count)
+			return;
+		const Pixel& pixel = source[index * stride];
+		sum[0] += sign * pixel.red;
+		sum[1] += sign * pixel.green;
+		sum[2] += sign * pixel.blue;
+		sum[3] += sign * pixel.alpha;
+	};
+
+	for (int i = 0; i < radius; i++)
+		Add(i, 1.f);
+
+	for (int i = 0; i < count; i++)
+	{
+		Add(i + radius, 1.f);
+		Add(i - radius - 1, -1.f);
+
+		destination[i * stride] = Pixel(byte(Rml::Math::Clamp(sum[0] * scale + 0.5f, 0.f, 255.f)),
+			byte(Rml::Math::Clamp(sum[1] * scale + 0.5f, 0.f, 255.f)), byte(Rml::Math::Clamp(sum[2] * scale + 0.5f, 0.f, 255.f)),
+			byte(Rml::Math::Clamp(sum[3] * scale + 0.5f, 0.f, 255.f)));
+	}
+}
+
+void RenderInterface_SW::RenderBlur(float sigma, Framebuffer& source_destination, Framebuffer& temp)
+{
+	RMLUI_ASSERT(&source_destination != &temp);
+	if (sigma < 0.5f)
+		return;
+
+	const Rml::Rectanglei region = GetActiveRegion();
+	if (region.Width() <= 0 || region.Height() <= 0)
+		return;
+
+	// Approximate the gaussian by three successive box blurs, making the cost independent of the blur radius.
+	constexpr int num_boxes = 3;
+	int box_sizes[num_boxes];
+	SigmaToBoxSizes(sigma, num_boxes, box_sizes);
+
+	const int stride = viewport_width;
+	for (int box_size : box_sizes)
+	{
+		const int radius = (box_size - 1) / 2;
+		if (radius <= 0)
+			continue;
+
+		ForEachBand(region.Top(), region.Bottom(), 8, [&](int band_begin, int band_end) {
+			for (int y = band_begin; y < band_end; y++)
+			{
+				const int offset = y * stride + region.Left();
+				BoxBlurLine(source_destination.pixels.data() + offset, temp.pixels.data() + offset, region.Width(), 1, radius);
+			}
+		});
+
+		// Process the columns in bands as well, each band being a range of columns.
+		ForEachBand(region.Left(), region.Right(), 8, [&](int column_begin, int column_end) {
+			for (int x = column_begin; x < column_end; x++)
+			{
+				const int offset = region.Top() * stride + x;
+				BoxBlurLine(temp.pixels.data() + offset, source_destination.pixels.data() + offset, region.Height(), stride, radius);
+			}
+		});
+	}
+}
+
+Rml::Rectanglei RenderInterface_SW::GetActiveRegion() const
+{
+	const Rml::Rectanglei viewport = Rml::Rectanglei::FromSize({viewport_width, viewport_height});
+	if (!scissor_enabled)
+		return viewport;
+
+	Rml::Rectanglei region = scissor_region.IntersectIfValid(viewport);
+	if (!region.Valid())
+		region = Rml::Rectanglei::FromSize({0, 0});
+	return region;
+}
+
+Framebuffer& RenderInterface_SW::GetLayer(Rml::LayerHandle layer)
+{
+	RMLUI_ASSERT((int)layer < layers_size);
+	return layers[(size_t)layer];
+}
+
+Framebuffer& RenderInterface_SW::GetTopLayer()
+{
+	RMLUI_ASSERT(layers_size > 0);
+	return layers[layers_size - 1];
+}
+
+Framebuffer& RenderInterface_SW::EnsureFramebuffer(Framebuffer& framebuffer)
+{
+	if (framebuffer.width != viewport_width || framebuffer.height != viewport_height)
+	{
+		framebuffer.width = viewport_width;
+		framebuffer.height = viewport_height;
+		framebuffer.pixels.assign(size_t(viewport_width * viewport_height), Pixel(0, 0, 0, 0));
+	}
+	return framebuffer;
+}
+
+Rml::Span<const Rml::ColourbPremultiplied> RenderInterface_SW::GetFramebuffer() const
+{
+	if (layers.empty())
+		return {};
+	return {layers[0].pixels.data(), layers[0].pixels.size()};
+}
+
+bool RenderInterface_SW::SaveFramebuffer(const Rml::String& path) const
+{
+	const Rml::Span<const Pixel> pixels = GetFramebuffer();
+	if (pixels.empty())
+		return false;
+
+	FILE* file = fopen(path.c_str(), "wb");
+	if (!file)
+		return false;
+
+	TGAHeader header = {};
+	header.dataType = 2;
+	header.width = (short int)viewport_width;
+	header.height = (short int)viewport_height;
+	header.bitsPerPixel = 32;
+	// Top-left origin, with 8 bits of alpha.
+	header.imageDescriptor = 32 | 8;
+
+	Rml::Vector<byte> data(pixels.size() * 4);
+	for (size_t i = 0; i < pixels.size(); i++)
+	{
+		const Rml::Colourb color = pixels[i].ToNonPremultiplied();
+		data[i * 4 + 0] = color.blue;
+		data[i * 4 + 1] = color.green;
+		data[i * 4 + 2] = color.red;
+		data[i * 4 + 3] = color.alpha;
+	}
+
+	const bool result = (fwrite(&header, sizeof(TGAHeader), 1, file) == 1 && fwrite(data.data(), data.size(), 1, file) == 1);
+	fclose(file);
+
+	return result;
+}
@@ -0,0 +1,150 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_BACKENDS_RENDERER_SW_H
+#define RMLUI_BACKENDS_RENDERER_SW_H
+
+#include <RmlUi/Core/RenderInterface.h>
+#include <RmlUi/Core/Types.h>
+
+/**
+    Software renderer rasterizing all geometry on the CPU into an RGBA framebuffer, without the need for a GPU or a window.
+
+    Intended for headless rendering, such as producing images of documents on servers, and for measuring the cost of whole
+    frames on machines without graphics hardware. Rasterization of large draw calls and filters is split into horizontal
+    bands processed by a pool of worker threads.
+
+    Supports textures, scissoring, clip masks, transforms, layers, and the built-in filters. Shaders are not supported.
+ */
+class RenderInterface_SW : public Rml::RenderInterface {
+public:
+	// @param[in] num_threads The number of threads used for rasterization including the calling thread, or zero to use all hardware threads.
+	explicit RenderInterface_SW(int num_threads = 0);
+	~RenderInterface_SW();
+
+	// The viewport should be updated whenever the output dimensions change.
+	void SetViewport(int viewport_width, int viewport_height);
+
+	// Prepares the framebuffer for taking rendering commands from RmlUi.
+	void BeginFrame();
+	// Finishes the frame, the rendered result is available from the framebuffer afterwards.
+	void EndFrame();
+
+	// Optional, can be used to clear the framebuffer.
+	void Clear();
+
+	// -- Inherited from Rml::RenderInterface --
+
+	Rml::CompiledGeometryHandle CompileGeometry(Rml::Span<const Rml::Vertex> vertices, Rml::Span<const int> indices) override;
+	void RenderGeometry(Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture) override;
+	void ReleaseGeometry(Rml::CompiledGeometryHandle handle) override;
+
+	Rml::TextureHandle LoadTexture(Rml::Vector2i& texture_dimensions, const Rml::String& source) override;
+	Rml::TextureHandle GenerateTexture(Rml::Span<const Rml::byte> source_data, Rml::Vector2i source_dimensions) override;
+	void ReleaseTexture(Rml::TextureHandle texture_handle) override;
+
+	void EnableScissorRegion(bool enable) override;
+	void SetScissorRegion(Rml::Rectanglei region) override;
+
+	void EnableClipMask(bool enable) override;
+	void RenderToClipMask(Rml::ClipMaskOperation mask_operation, Rml::CompiledGeometryHandle geometry, Rml::Vector2f translation) override;
+
+	void SetTransform(const Rml::Matrix4f* transform) override;
+
+	Rml::LayerHandle PushLayer() override;
+	void CompositeLayers(Rml::LayerHandle source, Rml::LayerHandle destination, Rml::BlendMode blend_mode,
+		Rml::Span<const Rml::CompiledFilterHandle> filters) override;
+	void PopLayer() override;
+
+	Rml::TextureHandle SaveLayerAsTexture() override;
+
+	Rml::CompiledFilterHandle SaveLayerAsMaskImage() override;
+
+	Rml::CompiledFilterHandle CompileFilter(const Rml::String& name, const Rml::Dictionary& parameters) override;
+	void ReleaseFilter(Rml::CompiledFilterHandle filter) override;
+
+	// -- Utility functions for clients --
+
+	// Returns the pixels of the last rendered frame, stored row by row from the top-left corner with premultiplied alpha.
+	Rml::Span<const Rml::ColourbPremultiplied> GetFramebuffer() const;
+	Rml::Vector2i GetFramebufferDimensions() const { return {viewport_width, viewport_height}; }
+
+	// Writes the last rendered frame to an uncompressed 32-bit TGA image.
+	bool SaveFramebuffer(const Rml::String& path) const;
+
+	struct Framebuffer {
+		int width = 0, height = 0;
+		Rml::Vector<Rml::ColourbPremultiplied> pixels;
+	};
+
+private:
+	struct Target;
+	class WorkerPool;
+
+	// Rasterizes the geometry into the given target, restricted to the current scissor region and clip mask.
+	void Rasterize(const Target& target, Rml::CompiledGeometryHandle handle, Rml::Vector2f translation, Rml::TextureHandle texture);
+
+	void RenderFilters(Rml::Span<const Rml::CompiledFilterHandle> filter_handles);
+	void RenderBlur(float sigma, Framebuffer& source_destination, Framebuffer& temp);
+
+	// Runs the function for every band of rows in the given range, distributing the bands among all threads.
+	void ForEachBand(int row_begin, int row_end, int min_rows_per_band, const Rml::Function<void(int, int)>& function);
+
+	// Returns the region affected by draw calls, that is, the scissor region clamped to the viewport.
+	Rml::Rectanglei GetActiveRegion() const;
+
+	Framebuffer& GetLayer(Rml::LayerHandle layer);
+	Framebuffer& GetTopLayer();
+	Framebuffer& EnsureFramebuffer(Framebuffer& framebuffer);
+
+	int viewport_width = 0;
+	int viewport_height = 0;
+
+	bool scissor_enabled = false;
+	Rml::Rectanglei scissor_region;
+
+	bool clip_mask_enabled = false;
+	Rml::byte clip_mask_test_value = 0;
+	Rml::Vector<Rml::byte> clip_mask;
+
+	bool transform_enabled = false;
+	Rml::Matrix4f transform;
+
+	// The layer stack, framebuffers are kept around for re-use after being popped.
+	int layers_size = 0;
+	Rml::Vector<Framebuffer> layers;
+
+	Framebuffer postprocess_primary;
+	Framebuffer postprocess_secondary;
+	Framebuffer postprocess_tertiary;
+	Framebuffer blend_mask;
+
+	Rml::UniquePtr<WorkerPool> worker_pool;
+};
+
+#endif
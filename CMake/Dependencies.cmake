@@ -6,6 +6,10 @@
 	*_NOTFOUND variables, we check directly for the existence of the target.
 ]]
 
+# The core library uses threads for optional parallel processing.
+find_package("Threads")
+report_dependency_found_or_error("Threads" "Threads" Threads::Threads)
+
 if(RMLUI_FONT_ENGINE STREQUAL "freetype")
 	find_package("Freetype")
 
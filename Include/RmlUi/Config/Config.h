@@ -103,6 +103,8 @@ template <typename T>
 using SmallUnorderedSet = std::unordered_set<T>;
 template <typename T>
 using SmallOrderedSet = std::set<T>;
+template <typename Key, typename Value>
+using SmallOrderedMap = std::map<Key, Value>;
 	#else
 template <typename Key, typename Value>
 using UnorderedMap = robin_hood::unordered_flat_map<Key, Value>;
@@ -114,6 +116,8 @@ template <typename T>
 using SmallUnorderedSet = itlib::flat_set<T>;
 template <typename T>
 using SmallOrderedSet = itlib::flat_set<T>;
+template <typename Key, typename Value>
+using SmallOrderedMap = itlib::flat_map<Key, Value>;
 	#endif // RMLUI_NO_THIRDPARTY_CONTAINERS
 
 // Utilities.
@@ -37,6 +37,7 @@ namespace Rml {
 
 class Stream;
 class URL;
+class XMLPrototype;
 using XMLAttributes = Dictionary;
 
 enum class XMLDataType { Text, CData, InnerXML };
@@ -88,6 +89,12 @@ private:
 	String xml_source;
 	size_t xml_index = 0;
 
+	// When set, all parse events submitted to the handlers are also recorded into this prototype.
+	XMLPrototype* prototype_recording = nullptr;
+
+	// Parses the contents of the xml source.
+	void ParseSource();
+
 	void Next();
 	bool AtEnd() const;
 	char Look() const;
@@ -132,6 +139,8 @@ private:
 
 	SmallUnorderedSet<String> cdata_tags;
 	SmallUnorderedSet<String> attributes_for_inner_xml_data;
+
+	friend class Rml::XMLPrototype;
 };
 
 } // namespace Rml
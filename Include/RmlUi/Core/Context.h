@@ -29,6 +29,7 @@
 #ifndef RMLUI_CORE_CONTEXT_H
 #define RMLUI_CORE_CONTEXT_H
 
+#include "Dictionary.h"
 #include "Header.h"
 #include "Input.h"
 #include "ScriptInterface.h"
@@ -38,6 +39,7 @@
 
 namespace Rml {
 
+class AnimationScheduler;
 class Stream;
 class ContextInstancer;
 class ElementDocument;
@@ -45,7 +47,9 @@ class EventListener;
 class DataModel;
 class DataModelConstructor;
 class DataTypeRegister;
+class ElementArena;
 class ScrollController;
+class ThreadPool;
 class RenderManager;
 class TextInputHandler;
 enum class EventId : uint16_t;
@@ -251,6 +255,7 @@ public:
 
 	/// Retrieves the render manager which can be used to submit changes to the render state.
 	RenderManager& GetRenderManager();
+	const RenderManager& GetRenderManager() const;
 
 	/// Retrieves the text input handler.
 	TextInputHandler* GetTextInputHandler() const;
@@ -277,6 +282,58 @@ public:
 	/// @return True if successfully removed, false if no data model was found.
 	bool RemoveDataModel(const String& name);
 
+	/// Sets the time budget for updating data views during each call to Update(), shared between all data models of this context.
+	/// Dirty data views which do not fit within the budget are deferred to the next update, in which case a new update is requested immediately.
+	/// Views located in visible documents are updated first.
+	/// @param[in] budget The time budget in seconds, or zero to update all dirty data views on every update (default).
+	void SetDataViewUpdateBudget(double budget);
+	/// Returns the time budget for updating data views, in seconds.
+	double GetDataViewUpdateBudget() const;
+
+	struct DataViewCounters {
+		int processed_views;
+		int deferred_views;
+	};
+	/// Returns the number of data views processed during the last call to Update(), and the number of dirty views deferred to later updates.
+	DataViewCounters GetDataViewCounters() const;
+
+	/// Sets the number of worker threads used for computing element styles during Update().
+	/// When enabled, the style of independent subtrees in the document tree are computed in parallel. Property change notifications are deferred
+	/// until the regular, serial update of each element. This is mainly beneficial for large documents where many elements change style at once.
+	/// @param[in] num_threads The number of worker threads, or zero to compute styles serially on the calling thread (default).
+	/// @note When enabled, the font engine interface may be called from worker threads, although never concurrently.
+	void SetStyleUpdateThreads(int num_threads);
+	/// Returns the number of worker threads used for computing element styles.
+	int GetStyleUpdateThreads() const;
+
+	/// Enables or disables the animation scheduler of this context.
+	/// When enabled, simple animations of opacity and colour properties are ticked in batches across all elements during Update(), writing
+	/// their values directly to the computed values of the animated elements. Such animations only update the element's local property when
+	/// they complete. Other animations and all transitions are unaffected.
+	/// @param[in] enable True to enable the scheduler, false to let each element tick all of its animations itself (default).
+	void EnableAnimationScheduler(bool enable);
+	/// Returns true if the animation scheduler is enabled.
+	bool IsAnimationSchedulerEnabled() const;
+
+	/// Enables or disables the element arena of this context.
+	/// When enabled, elements created for this context by the default element instancers, and the internal data of all its elements, are
+	/// allocated from memory chunks owned by the context. This reduces the number of allocations when loading documents and keeps the
+	/// elements of the context close together in memory. Only applies to elements created after the call.
+	/// @param[in] enable True to enable the arena, false to allocate elements from the memory pools shared by all contexts (default).
+	/// @note Elements may still outlive the context, the arena memory is released when its last element is destroyed.
+	void EnableElementArena(bool enable);
+	/// Returns true if the element arena is enabled.
+	bool IsElementArenaEnabled() const;
+
+	/// Enables or disables nine-slicing of box-shadow textures in this context.
+	/// When enabled, the box-shadow texture of an element is generated for a reduced box size, and its center slices are stretched to cover the
+	/// element. Thereby, elements of different sizes with otherwise identical box-shadows, borders, and backgrounds share a single small texture.
+	/// Only applies to elements consisting of a single box, and to box-shadows generated after the call.
+	/// @param[in] enable True to enable nine-slicing, false to generate box-shadow textures for the full size of each element (default).
+	void EnableBoxShadowNineSlice(bool enable);
+	/// Returns true if nine-slicing of box-shadow textures is enabled.
+	bool IsBoxShadowNineSliceEnabled() const;
+
 	/// Sets the base tag name of documents before creation. Default: "body".
 	/// @param[in] tag The name of the base tag. Example: "html"
 	void SetDocumentsBaseTag(const String& tag);
@@ -344,6 +401,10 @@ private:
 	Vector2i mouse_position;
 	bool mouse_active;
 
+	// Event parameters for mouse moves, reused between moves to avoid allocations as they are generated with the same keys every time.
+	Dictionary mouse_move_parameters;
+	Dictionary mouse_move_drag_parameters;
+
 	// Controller for various scroll behavior modes.
 	UniquePtr<ScrollController> scroll_controller; // [not-null]
 
@@ -380,6 +441,21 @@ private:
 	// See RequestNextUpdate() and NextUpdateRequested() for details.
 	double next_update_timeout = 0;
 
+	double data_view_update_budget = 0;
+	DataViewCounters data_view_counters = {};
+
+	// Worker threads for computing styles in parallel, or null when styles are computed serially.
+	UniquePtr<ThreadPool> style_thread_pool;
+
+	// Batches simple animations of all elements in this context, or null when elements tick their own animations.
+	UniquePtr<AnimationScheduler> animation_scheduler;
+
+	// Allocates the elements created for this context, or null when elements are allocated from the global pools. Owned by this context, but
+	// only destroyed by its last element.
+	ElementArena* element_arena = nullptr;
+
+	bool box_shadow_nine_slice = false;
+
 	// Internal callback for when an element is detached or removed from the hierarchy.
 	void OnElementDetach(Element* element);
 	// Internal callback for when a new element gains focus.
@@ -419,6 +495,7 @@ private:
 	static void SendEvents(const ElementSet& old_items, const ElementSet& new_items, EventId id, const Dictionary& parameters);
 
 	friend class Rml::Element;
+	friend class Rml::ElementArena;
 };
 
 } // namespace Rml
@@ -127,6 +127,16 @@ RMLUICORE_API Context* GetContext(int index);
 /// Returns the number of active contexts.
 /// @return The total number of active RmlUi contexts.
 RMLUICORE_API int GetNumContexts();
+/// Updates the given contexts concurrently on a pool of worker threads, equivalent to calling Context::Update() on each of them.
+/// @param[in] contexts The contexts to update, each context must appear only once.
+/// @param[in] num_threads The number of worker threads in addition to the calling thread, zero updates the contexts on the calling thread.
+/// @return True if all the contexts were updated successfully.
+/// @note Contexts sharing a render interface are updated one after another on the same thread.
+/// @note Elements must not be moved between the contexts during the update, and the contexts must not be rendered concurrently.
+/// @note Documents should be loaded and custom event types registered before any concurrent updates.
+/// @note Interfaces, plugins, and event listeners may be called from any of the threads, and must be thread-safe accordingly. A custom font
+///       engine interface must serialize its own calls, while the default font engine is already synchronized.
+RMLUICORE_API bool UpdateContexts(Span<Context* const> contexts, int num_threads);
 
 /// Adds a new font face to the font engine. The face's family, style, and weight will be determined from the face itself.
 /// @param[in] file_path The path to the file to load the face from. The path is passed directly to the file interface which is used to load the file.
@@ -38,6 +38,12 @@
 
 namespace Rml {
 
+// Scalar types whose struct members can be read and written in place. Enums are excluded, since they may have a custom scalar definition registered.
+template <typename T>
+struct is_static_data_scalar {
+	static constexpr bool value = std::is_arithmetic<T>::value || std::is_same<T, String>::value;
+};
+
 template <typename Object>
 class StructHandle {
 public:
@@ -60,6 +66,20 @@ public:
 		return CreateMemberObjectDefinition(name, member_object_ptr);
 	}
 
+	/// Register a member object with the member pointer provided at compile time.
+	/// @note Underlying type must be registered before it is used as a member.
+	/// @note Members of arithmetic types and String are read and written directly, avoiding the indirection through the underlying type definition.
+	/// @example
+	///		struct Invader {
+	///			int health;
+	/// 	};
+	///		struct_handle.RegisterMember<int, &Invader::health>("health");
+	template <typename MemberType, MemberType Object::*member_object_ptr>
+	bool RegisterMember(const String& name)
+	{
+		return CreateStaticMemberObjectDefinition<MemberType, member_object_ptr>(name);
+	}
+
 	/// Register a member getter function.
 	/// @note Underlying type must be registered before it is used as a member.
 	/// @note Getter functions can return by reference, raw pointer, or by value. If returned by value,
@@ -128,6 +148,14 @@ private:
 	template <typename MemberType>
 	bool CreateMemberObjectDefinition(const String& name, MemberType Object::*member_ptr);
 
+	template <typename MemberType, MemberType Object::*member_ptr,
+		typename std::enable_if_t<is_static_data_scalar<MemberType>::value, int> = 0>
+	bool CreateStaticMemberObjectDefinition(const String& name);
+
+	template <typename MemberType, MemberType Object::*member_ptr,
+		typename std::enable_if_t<!is_static_data_scalar<MemberType>::value, int> = 0>
+	bool CreateStaticMemberObjectDefinition(const String& name);
+
 	template <typename BasicReturnType, typename MemberType>
 	bool CreateMemberGetFuncDefinition(const String& name, MemberType Object::*member_get_func_ptr);
 
@@ -158,6 +186,31 @@ bool StructHandle<Object>::CreateMemberObjectDefinition(const String& name, Memb
 	return true;
 }
 
+template <typename Object>
+template <typename MemberType, MemberType Object::*member_ptr,
+	typename std::enable_if_t<is_static_data_scalar<MemberType>::value, int>>
+bool StructHandle<Object>::CreateStaticMemberObjectDefinition(const String& name)
+{
+	static_assert(!std::is_const<MemberType>::value, "Data member objects cannot be const qualified.");
+
+	struct_definition->AddMember(name, Rml::MakeUnique<StaticScalarMemberDefinition<Object, MemberType, member_ptr>>());
+	return true;
+}
+
+template <typename Object>
+template <typename MemberType, MemberType Object::*member_ptr,
+	typename std::enable_if_t<!is_static_data_scalar<MemberType>::value, int>>
+bool StructHandle<Object>::CreateStaticMemberObjectDefinition(const String& name)
+{
+	static_assert(!std::is_const<MemberType>::value, "Data member objects cannot be const qualified.");
+
+	VariableDefinition* underlying_definition = type_register->GetDefinition<MemberType>();
+	if (!underlying_definition)
+		return false;
+	struct_definition->AddMember(name, Rml::MakeUnique<StaticMemberObjectDefinition<Object, MemberType, member_ptr>>(underlying_definition));
+	return true;
+}
+
 template <typename Object>
 template <typename BasicReturnType, typename MemberType>
 bool StructHandle<Object>::CreateMemberGetFuncDefinition(const String& name, MemberType Object::*member_get_func_ptr)
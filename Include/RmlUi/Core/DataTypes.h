@@ -68,6 +68,9 @@ struct DataAddressEntry {
 	DataAddressEntry(int index) : index(index) {}
 	String name;
 	int index;
+	// Index into the member table of a struct definition, resolved together with the address. Negative if unresolved, in which case the member
+	// is looked up by name.
+	int member_index = -1;
 };
 using DataAddress = Vector<DataAddressEntry>;
 
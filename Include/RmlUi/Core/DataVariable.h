@@ -59,6 +59,9 @@ public:
 	DataVariable Child(const DataAddressEntry& address);
 	DataVariableType Type();
 
+	// Returns the index of the given member name in the member table of the underlying struct, or negative if not applicable.
+	int GetMemberIndex(const String& name);
+
 private:
 	VariableDefinition* definition = nullptr;
 	void* ptr = nullptr;
@@ -81,6 +84,8 @@ public:
 	virtual int Size(void* ptr);
 	virtual DataVariable Child(void* ptr, const DataAddressEntry& address);
 
+	virtual int GetMemberIndex(const String& name);
+
 protected:
 	VariableDefinition(DataVariableType type) : type(type) {}
 
@@ -147,10 +152,14 @@ public:
 
 	DataVariable Child(void* ptr, const DataAddressEntry& address) override;
 
+	int GetMemberIndex(const String& name) override;
+
 	void AddMember(const String& name, UniquePtr<VariableDefinition> member);
 
 private:
-	SmallUnorderedMap<String, UniquePtr<VariableDefinition>> members;
+	// Member definitions in order of registration, addressed directly by resolved member indices.
+	Vector<UniquePtr<VariableDefinition>> members;
+	SmallUnorderedMap<String, int> member_indices;
 };
 
 template <typename Container>
@@ -197,6 +206,7 @@ public:
 	bool Set(void* ptr, const Variant& variant) override;
 	int Size(void* ptr) override;
 	DataVariable Child(void* ptr, const DataAddressEntry& address) override;
+	int GetMemberIndex(const String& name) override;
 
 protected:
 	virtual void* DereferencePointer(void* ptr) = 0;
@@ -228,6 +238,37 @@ private:
 	MemberType Object::*member_ptr;
 };
 
+template <typename Object, typename MemberType, MemberType Object::*member_ptr>
+class StaticMemberObjectDefinition final : public BasePointerDefinition {
+public:
+	StaticMemberObjectDefinition(VariableDefinition* underlying_definition) : BasePointerDefinition(underlying_definition) {}
+
+protected:
+	void* DereferencePointer(void* base_ptr) override { return &(static_cast<Object*>(base_ptr)->*member_ptr); }
+};
+
+// Scalar member with the member pointer known at compile time, values are read and written directly without going through the definition of the
+// underlying type.
+template <typename Object, typename MemberType, MemberType Object::*member_ptr>
+class StaticScalarMemberDefinition final : public VariableDefinition {
+public:
+	StaticScalarMemberDefinition() : VariableDefinition(DataVariableType::Scalar) {}
+
+	bool Get(void* ptr, Variant& variant) override
+	{
+		if (!ptr)
+			return false;
+		variant = static_cast<const Object*>(ptr)->*member_ptr;
+		return true;
+	}
+	bool Set(void* ptr, const Variant& variant) override
+	{
+		if (!ptr)
+			return false;
+		return variant.GetInto<MemberType>(static_cast<Object*>(ptr)->*member_ptr);
+	}
+};
+
 template <typename Object, typename MemberType, typename BasicReturnType>
 class MemberGetFuncDefinition final : public BasePointerDefinition {
 public:
@@ -45,9 +45,11 @@
 
 namespace Rml {
 
+class AnimationScheduler;
 class Context;
 class DataModel;
 class Decorator;
+class ElementArena;
 class ElementInstancer;
 class EventDispatcher;
 class EventListener;
@@ -65,6 +67,7 @@ class PropertyDictionary;
 class RenderManager;
 class StyleSheet;
 class StyleSheetContainer;
+class ThreadPool;
 class TransformState;
 struct ElementMeta;
 struct StackingContextChild;
@@ -593,8 +596,10 @@ public:
 	String GetEventDispatcherSummary() const;
 	/// Access the element background and border.
 	ElementBackgroundBorder* GetElementBackgroundBorder() const;
-	/// Returns the element's scrollbar functionality.
+	/// Returns the element's scrollbar functionality, instancing it on first use.
 	ElementScroll* GetElementScroll() const;
+	/// Returns the element's scrollbar functionality, or nullptr if it has not been needed yet.
+	ElementScroll* GetElementScrollIfCreated() const;
 	/// Returns the element's nearest scroll container that can be scrolled, if any.
 	Element* GetClosestScrollableContainer();
 	/// Returns the element's transform state.
@@ -698,6 +703,19 @@ private:
 	void DirtyStackingContext();
 
 	void UpdateDefinition();
+	// Marks this element and its ancestors as containing definitions or properties in need of an update, used to skip clean subtrees.
+	void DirtyStyleSubtree();
+
+	/// Computes values of dirty properties, and collects the changed properties to be notified about during UpdateProperties().
+	void ComputeStyle(float dp_ratio, Vector2f vp_dimensions);
+
+	/// Computes the style of this element and its descendants using the given thread pool, independent subtrees are computed in parallel.
+	/// Clean subtrees are skipped, and nothing is computed when only a few elements are dirty, leaving them to the serial update.
+	/// Any property change notifications are deferred until the next call to UpdateProperties() on the respective element.
+	void ComputeStyleParallel(ThreadPool& thread_pool, float dp_ratio, Vector2f vp_dimensions);
+	struct StyleSubtree;
+	int UpdateDefinitionRecursive(Vector<StyleSubtree>& subtrees, bool parent_inherited_dirty);
+	void ComputeStyleRecursive(ThreadPool& thread_pool, const StyleSubtree* subtree, float dp_ratio, Vector2f vp_dimensions);
 
 	void DirtyTransformState(bool perspective_dirty, bool transform_dirty);
 	void UpdateTransformState();
@@ -727,7 +745,12 @@ private:
 	void HandleAnimationProperty();
 
 	/// Advances the animations (including transitions) forward in time.
+	/// Animations supported by the context's animation scheduler are handed over to it after this update, and only checked for completion later on.
 	void AdvanceAnimations();
+	/// Returns the animation to this element, if it is currently driven by the context's animation scheduler.
+	void ReleaseScheduledAnimation(ElementAnimation& animation);
+	/// Erases the given range of animations, after releasing them from the animation scheduler.
+	void EraseAnimations(ElementAnimationList::iterator it_begin, ElementAnimationList::iterator it_end);
 
 	// State flags are packed together for compact data layout.
 	bool local_stacking_context;
@@ -743,6 +766,7 @@ private:
 
 	bool dirty_definition : 1; // Implies dirty child definitions as well.
 	bool dirty_child_definitions : 1;
+	bool dirty_style_subtree : 1; // This element or any of its descendants may need their definition or properties updated.
 
 	bool dirty_animation : 1;
 	bool dirty_transition : 1;
@@ -809,8 +833,12 @@ private:
 	ElementAnimationList animations;
 
 	ElementMeta* meta;
+	// The context arena this element and its meta data were allocated from, or null for the global pools.
+	ElementArena* arena;
 
+	friend class Rml::AnimationScheduler;
 	friend class Rml::Context;
+	friend class Rml::ElementArena;
 	friend class Rml::ElementStyle;
 	friend class Rml::ContainerBox;
 	friend class Rml::InlineLevelBox;
@@ -118,6 +118,8 @@ protected:
 private:
 	UniquePtr<InputType> type;
 	String type_name;
+
+	friend class TestWidgetTextInput;
 };
 
 } // namespace Rml
@@ -136,6 +136,8 @@ private:
 	void SetWordWrapProperties();
 
 	UniquePtr<WidgetTextInputMultiLine> widget;
+
+	friend class TestWidgetTextInput;
 };
 
 } // namespace Rml
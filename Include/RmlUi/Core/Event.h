@@ -39,6 +39,7 @@ namespace Rml {
 class Factory;
 class Element;
 class EventInstancer;
+class EventInstancerDefault;
 struct EventSpecification;
 
 enum class EventPhase { None, Capture = 1, Target = 2, Bubble = 4 };
@@ -129,6 +130,9 @@ private:
 	/// interacting with transformed elements.
 	void ProjectMouse(Element* element);
 
+	/// Resets the state of this event for dispatching it anew, allows events to be reused.
+	void Reset(Element* target, EventId id, const String& type, const Dictionary& parameters, bool interruptible);
+
 	/// Release this event through its instancer.
 	void Release() override;
 
@@ -147,6 +151,7 @@ private:
 	EventInstancer* instancer = nullptr;
 
 	friend class Rml::Factory;
+	friend class Rml::EventInstancerDefault;
 };
 
 } // namespace Rml
@@ -160,10 +160,26 @@ public:
 	/// @param[in] stream A pointer to the stream containing the style sheet's contents.
 	/// @return A pointer to the newly created style sheet.
 	static SharedPtr<StyleSheetContainer> InstanceStyleSheetStream(Stream* stream);
+	/// Compiles a style sheet file into binary data. The data can be saved to a file which is then loaded in place of the
+	/// source, skipping all parsing. It is only compatible with the library version and platform it was compiled with.
+	/// @param[in] file_name The location of the style sheet file.
+	/// @param[out] out_data The compiled style sheet.
+	/// @return True on success, false if the style sheet could not be loaded or compiled.
+	static bool CompileStyleSheetFile(const String& file_name, String& out_data);
+	/// Loads style sheet files into the style sheet cache, parsing them concurrently on a pool of worker threads. Documents
+	/// linking to any of these files will then use the cached sheets instead of loading them on the fly.
+	/// @param[in] file_names The paths of the style sheet files, in the resolved form passed to the file interface when documents link to them.
+	/// @param[in] num_threads The number of worker threads in addition to the calling thread, zero loads the sheets on the calling thread.
+	/// @return True if all the style sheets were loaded successfully, otherwise false.
+	/// @note Files are read on the calling thread. However, the system interface and any decorator, filter, and font-effect
+	/// instancers may be called from the worker threads, and must be thread-safe accordingly.
+	static bool PreloadStyleSheets(Span<const String> file_names, int num_threads);
 	/// Clears the style sheet cache. This will force style sheets to be reloaded.
 	static void ClearStyleSheetCache();
 	/// Clears the template cache. This will force templates to be reloaded.
 	static void ClearTemplateCache();
+	/// Clears the cache of parsed RML documents and contents. This will force the RML to be parsed again the next time it is instanced.
+	static void ClearDocumentCache();
 
 	/// Registers an instancer for all events.
 	/// @param[in] instancer The instancer to be called.
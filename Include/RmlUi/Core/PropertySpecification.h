@@ -84,6 +84,8 @@ public:
 	/// @return The appropriate property definition if it could be found, nullptr otherwise.
 	const PropertyDefinition* GetProperty(PropertyId id) const;
 	const PropertyDefinition* GetProperty(const String& property_name) const;
+	/// Returns the name of a registered property.
+	const String& GetPropertyName(PropertyId id) const;
 
 	/// Returns the id set of all registered property definitions.
 	const PropertyIdSet& GetRegisteredProperties() const;
@@ -34,6 +34,7 @@
 namespace Rml {
 
 struct Spritesheet;
+class StyleSheetBinary;
 
 struct Sprite {
 	Rectanglef rectangle; // in 'px' units
@@ -80,6 +81,8 @@ private:
 
 	Spritesheets spritesheets;
 	SpriteMap sprite_map;
+
+	friend Rml::StyleSheetBinary;
 };
 
 } // namespace Rml
@@ -33,6 +33,7 @@
 #include "Spritesheet.h"
 #include "StyleSheetTypes.h"
 #include "Traits.h"
+#include <mutex>
 
 namespace Rml {
 
@@ -44,6 +45,7 @@ class RenderManager;
 class SpritesheetList;
 class StyleSheetContainer;
 class StyleSheetParser;
+class StyleSheetBinary;
 struct PropertySource;
 struct Sprite;
 
@@ -65,7 +67,7 @@ public:
 	/// Merges another style sheet into this.
 	void MergeStyleSheet(const StyleSheet& sheet);
 
-	/// Builds the node index for a combined style sheet.
+	/// Builds the node index for a combined style sheet, unless it is already built.
 	void BuildNodeIndex();
 
 	/// Returns the named @decorator, or null if it does not exist.
@@ -112,16 +114,22 @@ private:
 
 	// Map of all styled nodes, that is, they have one or more properties.
 	StyleSheetIndex styled_node_index;
+	// The node index is only rebuilt after the style sheet has been modified, thus it stays immutable while the style sheet is in use.
+	bool node_index_built = false;
 
 	// Index of node sets to element definitions.
 	using ElementDefinitionCache = UnorderedMap<StyleSheetIndex::NodeList, SharedPtr<const ElementDefinition>>;
 	mutable ElementDefinitionCache node_cache;
 
-	// Cached decorator instances.
-	using DecoratorCache = UnorderedMap<String, Vector<SharedPtr<const Decorator>>>;
+	// Cached decorator instances. Each list is kept behind a pointer so that returned references stay valid while the cache grows.
+	using DecoratorCache = UnorderedMap<String, UniquePtr<DecoratorPtrList>>;
 	mutable DecoratorCache decorator_cache;
 
+	// Style sheets may be shared between documents of contexts being updated concurrently, this guards the caches and node index creation.
+	mutable std::mutex cache_mutex;
+
 	friend Rml::StyleSheetParser;
+	friend Rml::StyleSheetBinary;
 	friend Rml::StyleSheetContainer;
 };
 
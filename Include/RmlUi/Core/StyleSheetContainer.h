@@ -49,15 +49,24 @@ public:
 	StyleSheetContainer();
 	virtual ~StyleSheetContainer();
 
-	/// Loads a style from a CSS definition.
+	/// Loads a style from a CSS definition, or from a compiled style sheet.
 	bool LoadStyleSheetContainer(Stream* stream, int begin_line_number = 1);
 
+	/// Writes the loaded style sheets in the compiled binary format, which can be loaded in place of the CSS definition.
+	/// @param[out] out_data The compiled style sheet data.
+	/// @return True on success, false if the style sheets contain values that cannot be serialized.
+	bool SerializeStyleSheetContainer(String& out_data) const;
+
 	/// Compiles a single style sheet by combining all contained style sheets whose media queries match the current state of the context.
 	/// @param[in] context The current context used for evaluating media query parameters against.
 	/// @returns True when the compiled style sheet was changed, otherwise false.
 	/// @warning This operation invalidates all references to the previously compiled style sheet.
 	bool UpdateCompiledStyleSheet(const Context* context);
 
+	/// Builds the node index of each contained style sheet ahead of compilation. When a single style sheet is active, it is
+	/// then compiled without any further processing.
+	void BuildNodeIndices();
+
 	/// Returns the previously compiled style sheet.
 	StyleSheet* GetCompiledStyleSheet();
 
@@ -71,7 +80,7 @@ private:
 	MediaBlockList media_blocks;
 
 	StyleSheet* compiled_style_sheet = nullptr;
-	UniquePtr<StyleSheet> combined_compiled_style_sheet;
+	SharedPtr<StyleSheet> combined_compiled_style_sheet;
 	Vector<int> active_media_block_indices;
 };
 
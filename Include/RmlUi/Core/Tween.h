@@ -33,6 +33,8 @@
 
 namespace Rml {
 
+class StyleSheetBinary;
+
 class RMLUICORE_API Tween {
 public:
 	enum Type { None, Back, Bounce, Circular, Cubic, Elastic, Exponential, Linear, Quadratic, Quartic, Quintic, Sine, Callback, Count };
@@ -63,6 +65,8 @@ private:
 	Type type_in = None;
 	Type type_out = None;
 	CallbackFnc callback = nullptr;
+
+	friend Rml::StyleSheetBinary;
 };
 
 } // namespace Rml
@@ -127,7 +127,8 @@ using VariantList = Vector<Variant>;
 using ElementAnimationList = Vector<ElementAnimation>;
 
 using AttributeNameList = SmallUnorderedSet<String>;
-using PropertyMap = UnorderedMap<PropertyId, Property>;
+// Properties are kept sorted by id in contiguous memory, for compact storage and fast ordered iteration.
+using PropertyMap = SmallOrderedMap<PropertyId, Property>;
 
 using Dictionary = SmallUnorderedMap<String, Variant>;
 using ElementAttributes = Dictionary;
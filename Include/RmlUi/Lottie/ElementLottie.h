@@ -40,6 +40,19 @@ class Animation;
 
 namespace Rml {
 
+namespace Lottie {
+	class LottieFrames;
+
+	/// Enables rendering of animation frames on a worker thread. Elements keep displaying their previous frame until the next one is ready.
+	/// Disabled by default.
+	RMLUICORE_API void SetAsyncRenderingEnabled(bool enable);
+
+	/// Sets the memory budget in bytes for caching rendered animation frames, shared by all animations. Frames are shared between elements
+	/// displaying the same animation at the same size, and looping animations replay from the cache. Zero disables the cache, which is the
+	/// default.
+	RMLUICORE_API void SetFrameCacheBudget(size_t budget);
+} // namespace Lottie
+
 class RMLUICORE_API ElementLottie : public Element {
 public:
 	RMLUI_RTTI_DefineWithParent(ElementLottie, Element)
@@ -78,6 +91,8 @@ private:
 	bool LoadAnimation();
 	// Update the texture for the next animation frame when necessary.
 	void UpdateTexture();
+	// Cancels any frame being rendered on the worker thread, or waits for it to complete if already started.
+	void CancelAsyncFrame();
 
 	bool animation_dirty = false;
 	bool geometry_dirty = false;
@@ -103,6 +118,15 @@ private:
 	size_t prev_animation_frame = size_t(-1);
 
 	UniquePtr<rlottie::Animation> animation;
+	// The resolved path of the animation.
+	String animation_source;
+	// Rendered frames at the current size, shared with other elements displaying the same animation.
+	SharedPtr<Lottie::LottieFrames> frames;
+
+	// The frame being rendered on the worker thread, acting as the back buffer to the texture data.
+	struct AsyncFrame;
+	SharedPtr<AsyncFrame> async_frame;
+	bool async_frame_pending = false;
 };
 
 } // namespace Rml
@@ -29,17 +29,25 @@
 #ifndef RMLUI_SVG_ELEMENT_SVG_H
 #define RMLUI_SVG_ELEMENT_SVG_H
 
-#include "../Core/CallbackTexture.h"
 #include "../Core/Element.h"
 #include "../Core/Geometry.h"
 #include "../Core/Header.h"
 
-namespace lunasvg {
-class Document;
-}
-
 namespace Rml {
 
+namespace SVG {
+	struct SVGDocument;
+	class SVGRaster;
+
+	/// Enables packing of small SVG rasterizations (up to 64x64 pixels) into shared atlas textures, reducing texture switches when
+	/// rendering many icons. Applies to rasterizations made after the call. Disabled by default.
+	RMLUICORE_API void SetAtlasEnabled(bool enable);
+
+	/// Enables rasterization of SVG documents on a worker thread. Until a new rasterization is ready, elements keep displaying their previous
+	/// one, if any. Applies to rasterizations made after the call. Disabled by default.
+	RMLUICORE_API void SetAsyncRasterizationEnabled(bool enable);
+} // namespace SVG
+
 class RMLUICORE_API ElementSVG : public Element {
 public:
 	RMLUI_RTTI_DefineWithParent(ElementSVG, Element)
@@ -54,6 +62,9 @@ public:
 	void EnsureSourceLoaded();
 
 protected:
+	/// Requests further updates while waiting for an asynchronous rasterization.
+	void OnUpdate() override;
+
 	/// Renders the image.
 	void OnRender() override;
 
@@ -80,8 +91,10 @@ private:
 	bool geometry_dirty = false;
 	bool texture_dirty = false;
 
-	// The texture this element is rendering from.
-	CallbackTexture texture;
+	// The rasterization this element is rendering from, shared with other elements using the same document and size.
+	SharedPtr<SVG::SVGRaster> raster;
+	// A new rasterization being generated asynchronously, replaces the current one when ready.
+	SharedPtr<SVG::SVGRaster> pending_raster;
 
 	// The image's intrinsic dimensions.
 	Vector2f intrinsic_dimensions;
@@ -91,7 +104,8 @@ private:
 	// The geometry used to render this element.
 	Geometry geometry;
 
-	UniquePtr<lunasvg::Document> svg_document;
+	// The parsed document, shared with other elements using the same source.
+	SharedPtr<SVG::SVGDocument> svg_document;
 };
 
 } // namespace Rml
@@ -0,0 +1,421 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "AnimationScheduler.h"
+#include "../../Include/RmlUi/Core/ComputedValues.h"
+#include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "../../Include/RmlUi/Core/PropertyIdSet.h"
+#include "ElementAnimation.h"
+#include "ElementMeta.h"
+#include "ElementStyle.h"
+#include <algorithm>
+
+namespace Rml {
+
+// Same approximate sRGB conversions as used when interpolating colour properties of regular animations.
+static void ColourToLinearSpace(Colourb c, float out[4])
+{
+	out[0] = c.red / 255.f;
+	out[0] *= out[0];
+	out[1] = c.green / 255.f;
+	out[1] *= out[1];
+	out[2] = c.blue / 255.f;
+	out[2] *= out[2];
+	out[3] = c.alpha / 255.f;
+}
+
+static Colourb ColourFromLinearSpace(float red, float green, float blue, float alpha)
+{
+	Colourb result;
+	result.red = (byte)Math::Clamp(Math::SquareRoot(red) * 255.f, 0.0f, 255.f);
+	result.green = (byte)Math::Clamp(Math::SquareRoot(green) * 255.f, 0.0f, 255.f);
+	result.blue = (byte)Math::Clamp(Math::SquareRoot(blue) * 255.f, 0.0f, 255.f);
+	result.alpha = (byte)Math::Clamp(alpha * 255.f, 0.0f, 255.f);
+	return result;
+}
+
+AnimationScheduler::AnimationScheduler() {}
+
+AnimationScheduler::~AnimationScheduler()
+{
+	RemoveAllTracks();
+}
+
+bool AnimationScheduler::IsSchedulable(const ElementAnimation& animation)
+{
+	if (animation.origin == ElementAnimationOrigin::Transition || animation.animation_complete || animation.keys.size() != 2)
+		return false;
+
+	// Only plain animations from the start to the end of each iteration are supported.
+	const AnimationKey& key0 = animation.keys[0];
+	const AnimationKey& key1 = animation.keys[1];
+	if (key0.time != 0.f || key1.time != animation.duration || animation.duration <= 1e-3f)
+		return false;
+
+	switch (animation.property_id)
+	{
+	case PropertyId::Opacity: return key0.property.unit == Unit::NUMBER && key1.property.unit == Unit::NUMBER;
+	case PropertyId::Color:
+	case PropertyId::BackgroundColor:
+	case PropertyId::ImageColor:
+	case PropertyId::BorderTopColor:
+	case PropertyId::BorderRightColor:
+	case PropertyId::BorderBottomColor:
+	case PropertyId::BorderLeftColor: return key0.property.unit == Unit::COLOUR && key1.property.unit == Unit::COLOUR;
+	default: break;
+	}
+
+	return false;
+}
+
+void AnimationScheduler::AddTrack(Element* element, ElementAnimation& animation)
+{
+	RMLUI_ASSERT(element && !animation.IsScheduled() && IsSchedulable(animation));
+
+	int id = 0;
+	if (free_ids.empty())
+	{
+		id = (int)index_from_id.size();
+		index_from_id.push_back(-1);
+	}
+	else
+	{
+		id = free_ids.back();
+		free_ids.pop_back();
+	}
+
+	index_from_id[id] = (int)track_ids.size();
+	animation.scheduler_track = id;
+
+	const Property& p0 = animation.keys[0].property;
+	const Property& p1 = animation.keys[1].property;
+
+	float from[NumChannels] = {};
+	float to[NumChannels] = {};
+	ValueType value_type = ValueType::Number;
+
+	if (p0.unit == Unit::COLOUR)
+	{
+		value_type = ValueType::Colour;
+		ColourToLinearSpace(p0.Get<Colourb>(), from);
+		ColourToLinearSpace(p1.Get<Colourb>(), to);
+	}
+	else
+	{
+		from[0] = p0.Get<float>();
+		to[0] = p1.Get<float>();
+	}
+
+	track_ids.push_back(id);
+	elements.push_back(element->GetObserverPtr());
+	property_ids.push_back(animation.property_id);
+	value_types.push_back(value_type);
+	tweens.push_back(animation.keys[1].tween);
+
+	last_update_times.push_back(animation.last_update_world_time);
+	durations.push_back(animation.duration);
+	times.push_back(animation.time_since_iteration_start);
+	current_iterations.push_back(animation.current_iteration);
+	num_iterations.push_back(animation.num_iterations);
+	alternate_directions.push_back(animation.alternate_direction);
+	reverse_directions.push_back(animation.reverse_direction);
+	completed.push_back(false);
+	updated.push_back(false);
+	alphas.push_back(0.f);
+
+	for (int c = 0; c < NumChannels; c++)
+	{
+		from_values[c].push_back(from[c]);
+		to_values[c].push_back(to[c]);
+		values[c].push_back(from[c]);
+	}
+}
+
+void AnimationScheduler::RemoveTrack(Element* element, ElementAnimation& animation)
+{
+	RMLUI_ASSERT(animation.IsScheduled() && animation.scheduler_track < (int)index_from_id.size());
+
+	const int index = index_from_id[animation.scheduler_track];
+	RMLUI_ASSERT(index >= 0 && elements[index].get() == element);
+
+	WriteBackState(index, animation);
+	animation.scheduler_track = -1;
+
+	// Only the computed value has been animated, make sure it is restored from the local properties.
+	element->GetStyle()->DirtyProperty(property_ids[index]);
+
+	RemoveTrackAtIndex(index);
+}
+
+void AnimationScheduler::RemoveAllTracks()
+{
+	for (int i = (int)track_ids.size() - 1; i >= 0; i--)
+	{
+		if (ElementAnimation* animation = FindAnimation(i))
+			RemoveTrack(elements[i].get(), *animation);
+		else
+			RemoveTrackAtIndex(i);
+	}
+}
+
+void AnimationScheduler::Update(const double world_time)
+{
+	RMLUI_ZoneScoped;
+
+	const int num_tracks = (int)track_ids.size();
+	if (num_tracks == 0)
+		return;
+
+	// Advance the time of all tracks, following the same steps as ElementAnimation::UpdateAndGetProperty().
+	for (int i = 0; i < num_tracks; i++)
+	{
+		float dt = float(world_time - last_update_times[i]);
+		updated[i] = (!completed[i] && dt > 0.0f);
+		if (!updated[i])
+			continue;
+
+		dt = Math::Min(dt, 0.1f);
+		last_update_times[i] = world_time;
+		times[i] += dt;
+
+		if (times[i] >= durations[i])
+		{
+			current_iterations[i] += 1;
+
+			if (num_iterations[i] == -1 || (current_iterations[i] >= 0 && current_iterations[i] < num_iterations[i]))
+			{
+				times[i] -= durations[i];
+				if (alternate_directions[i])
+					reverse_directions[i] = !reverse_directions[i];
+			}
+			else
+			{
+				completed[i] = true;
+				times[i] = durations[i];
+			}
+		}
+
+		const float t = (reverse_directions[i] ? durations[i] - times[i] : times[i]);
+		alphas[i] = Math::Clamp(t / durations[i], 0.0f, 1.0f);
+	}
+
+	for (int i = 0; i < num_tracks; i++)
+	{
+		if (updated[i])
+			alphas[i] = tweens[i](alphas[i]);
+	}
+
+	// Interpolate all channels of all tracks in one pass, tracks which were not updated are simply recomputed to their current value.
+	for (int c = 0; c < NumChannels; c++)
+	{
+		const float* from = from_values[c].data();
+		const float* to = to_values[c].data();
+		const float* alpha = alphas.data();
+		float* result = values[c].data();
+
+		for (int i = 0; i < num_tracks; i++)
+			result[i] = from[i] * (1.0f - alpha[i]) + to[i] * alpha[i];
+	}
+
+	// Remove tracks of destroyed elements, and hand completed tracks back to their elements.
+	for (int i = num_tracks - 1; i >= 0; i--)
+	{
+		if (!elements[i])
+			RemoveTrackAtIndex(i);
+		else if (completed[i])
+			FinishTrack(i);
+	}
+}
+
+void AnimationScheduler::ApplyValues()
+{
+	RMLUI_ZoneScoped;
+
+	for (int i = 0; i < (int)track_ids.size(); i++)
+	{
+		if (!updated[i])
+			continue;
+
+		if (Element* element = elements[i].get())
+		{
+			const bool inherited = (property_ids[i] == PropertyId::Opacity || property_ids[i] == PropertyId::Color);
+			ApplyValue(element, i, inherited);
+		}
+	}
+}
+
+void AnimationScheduler::RemoveTrackAtIndex(const int index)
+{
+	const int last = (int)track_ids.size() - 1;
+	RMLUI_ASSERT(index >= 0 && index <= last);
+
+	index_from_id[track_ids[index]] = -1;
+	free_ids.push_back(track_ids[index]);
+
+	auto swap_remove = [index, last](auto& vector) {
+		if (index != last)
+			vector[index] = std::move(vector[last]);
+		vector.pop_back();
+	};
+
+	swap_remove(track_ids);
+	swap_remove(elements);
+	swap_remove(property_ids);
+	swap_remove(value_types);
+	swap_remove(tweens);
+	swap_remove(last_update_times);
+	swap_remove(durations);
+	swap_remove(times);
+	swap_remove(current_iterations);
+	swap_remove(num_iterations);
+	swap_remove(alternate_directions);
+	swap_remove(reverse_directions);
+	swap_remove(completed);
+	swap_remove(updated);
+	swap_remove(alphas);
+
+	for (int c = 0; c < NumChannels; c++)
+	{
+		swap_remove(from_values[c]);
+		swap_remove(to_values[c]);
+		swap_remove(values[c]);
+	}
+
+	if (index != last)
+		index_from_id[track_ids[index]] = index;
+}
+
+void AnimationScheduler::FinishTrack(const int index)
+{
+	Element* element = elements[index].get();
+	ElementAnimation* animation = FindAnimation(index);
+	if (!animation)
+	{
+		RemoveTrackAtIndex(index);
+		return;
+	}
+
+	WriteBackState(index, *animation);
+	animation->scheduler_track = -1;
+
+	// The element dispatches the end event and removes the property as needed during its next update. Animations started through the element
+	// API keep their final value, which needs to be set as a local property now.
+	const PropertyId id = property_ids[index];
+	if (animation->GetOrigin() == ElementAnimationOrigin::User)
+	{
+		Property property = GetValueAsProperty(index);
+		property.definition = animation->keys[0].property.definition;
+		RemoveTrackAtIndex(index);
+		element->SetProperty(id, property);
+	}
+	else
+	{
+		RemoveTrackAtIndex(index);
+		element->GetStyle()->DirtyProperty(id);
+	}
+}
+
+ElementAnimation* AnimationScheduler::FindAnimation(const int index) const
+{
+	Element* element = elements[index].get();
+	if (!element)
+		return nullptr;
+
+	const int id = track_ids[index];
+	for (ElementAnimation& animation : element->animations)
+	{
+		if (animation.scheduler_track == id)
+			return &animation;
+	}
+
+	return nullptr;
+}
+
+void AnimationScheduler::WriteBackState(const int index, ElementAnimation& animation) const
+{
+	animation.last_update_world_time = last_update_times[index];
+	animation.time_since_iteration_start = times[index];
+	animation.current_iteration = current_iterations[index];
+	animation.reverse_direction = reverse_directions[index];
+	animation.animation_complete = completed[index];
+}
+
+void AnimationScheduler::ApplyValue(Element* element, const int index, const bool inherited) const
+{
+	const PropertyId id = property_ids[index];
+	Style::ComputedValues& computed = element->meta->computed_values;
+
+	if (value_types[index] == ValueType::Number)
+	{
+		RMLUI_ASSERT(id == PropertyId::Opacity);
+		computed.opacity(values[0][index]);
+	}
+	else
+	{
+		const Colourb colour = ColourFromLinearSpace(values[0][index], values[1][index], values[2][index], values[3][index]);
+		switch (id)
+		{
+		case PropertyId::Color: computed.color(colour); break;
+		case PropertyId::BackgroundColor: computed.background_color(colour); break;
+		case PropertyId::ImageColor: computed.image_color(colour); break;
+		case PropertyId::BorderTopColor: computed.border_top_color(colour); break;
+		case PropertyId::BorderRightColor: computed.border_right_color(colour); break;
+		case PropertyId::BorderBottomColor: computed.border_bottom_color(colour); break;
+		case PropertyId::BorderLeftColor: computed.border_left_color(colour); break;
+		default: RMLUI_ERROR; break;
+		}
+	}
+
+	// Let the element invalidate its geometry and any other state depending on the property.
+	PropertyIdSet changed_properties;
+	changed_properties.Insert(id);
+	element->OnPropertyChange(changed_properties);
+
+	if (inherited)
+	{
+		const int num_children = element->GetNumChildren(true);
+		for (int i = 0; i < num_children; i++)
+		{
+			Element* child = element->GetChild(i);
+			if (!child->GetStyle()->GetLocalProperty(id))
+				ApplyValue(child, index, inherited);
+		}
+	}
+}
+
+Property AnimationScheduler::GetValueAsProperty(const int index) const
+{
+	if (value_types[index] == ValueType::Number)
+		return Property(values[0][index], Unit::NUMBER);
+
+	return Property(ColourFromLinearSpace(values[0][index], values[1][index], values[2][index], values[3][index]), Unit::COLOUR);
+}
+
+} // namespace Rml
@@ -0,0 +1,124 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_ANIMATIONSCHEDULER_H
+#define RMLUI_CORE_ANIMATIONSCHEDULER_H
+
+#include "../../Include/RmlUi/Core/ID.h"
+#include "../../Include/RmlUi/Core/ObserverPtr.h"
+#include "../../Include/RmlUi/Core/Property.h"
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Tween.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class Element;
+class ElementAnimation;
+
+/**
+    Drives simple element animations of a context in batches.
+
+    Animations between two numeric or colour keys of properties which do not affect layout are handed over to the scheduler by their element
+    after it has advanced them once.
+    The scheduler stores the tracks as structure of arrays, advances them all in tight loops, and writes the resulting values directly into
+    the computed values of the elements. This avoids the round trip through generic properties and style computation on every update.
+
+    While an animation is scheduled, the local property of the element is not updated, only its computed value. The local property is
+    synchronized when the animation completes. Transitions are never scheduled, since they need the current local value when interrupted.
+ */
+
+class AnimationScheduler : NonCopyMoveable {
+public:
+	AnimationScheduler();
+	~AnimationScheduler();
+
+	/// Returns true if the given animation can be driven by the scheduler.
+	static bool IsSchedulable(const ElementAnimation& animation);
+
+	/// Takes over the ticking of the given animation, which must be schedulable.
+	void AddTrack(Element* element, ElementAnimation& animation);
+	/// Stops scheduling the given animation, and writes its current timing state back to the animation.
+	void RemoveTrack(Element* element, ElementAnimation& animation);
+	/// Stops scheduling all animations, writing back their state to any elements still alive.
+	void RemoveAllTracks();
+
+	/// Advances all tracks to the given time, and hands any completed animations back to their elements.
+	/// @note Should be called before updating the elements, so that they can finish up completed animations during the same update.
+	void Update(double world_time);
+	/// Writes the current values of all tracks advanced during the last update to the computed values of their elements.
+	/// @note Should be called after updating the elements, so that the values take precedence over any newly computed styles.
+	void ApplyValues();
+
+	int GetNumTracks() const { return (int)track_ids.size(); }
+
+private:
+	enum class ValueType : uint8_t { Number, Colour };
+
+	void RemoveTrackAtIndex(int index);
+	void FinishTrack(int index);
+
+	// Returns the animation driven by the given track, or null if it could not be found.
+	ElementAnimation* FindAnimation(int index) const;
+	void WriteBackState(int index, ElementAnimation& animation) const;
+
+	// Writes the current value of the given track to the element, and to any descendants inheriting the property.
+	void ApplyValue(Element* element, int index, bool inherited) const;
+	Property GetValueAsProperty(int index) const;
+
+	// Maps track ids to their index in the arrays below, or -1 for unused ids.
+	Vector<int> index_from_id;
+	Vector<int> free_ids;
+
+	// Track data, all arrays are indexed by the track index.
+	Vector<int> track_ids;
+	Vector<ObserverPtr<Element>> elements;
+	Vector<PropertyId> property_ids;
+	Vector<ValueType> value_types;
+	Vector<Tween> tweens;
+
+	Vector<double> last_update_times;
+	Vector<float> durations;
+	Vector<float> times;
+	Vector<int> current_iterations;
+	Vector<int> num_iterations;
+	Vector<uint8_t> alternate_directions;
+	Vector<uint8_t> reverse_directions;
+	Vector<uint8_t> completed;
+	Vector<uint8_t> updated;
+	Vector<float> alphas;
+
+	// Key and current values split into separate channels. Numbers only use the first channel, while colours are stored in linear space.
+	static constexpr int NumChannels = 4;
+	Vector<float> from_values[NumChannels];
+	Vector<float> to_values[NumChannels];
+	Vector<float> values[NumChannels];
+};
+
+} // namespace Rml
+#endif
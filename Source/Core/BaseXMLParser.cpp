@@ -30,6 +30,8 @@
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/Stream.h"
 #include "XMLParseTools.h"
+#include "XMLPrototype.h"
+#include <algorithm>
 #include <string.h>
 
 namespace Rml {
@@ -62,6 +64,14 @@ void BaseXMLParser::Parse(Stream* stream)
 	const size_t source_size = stream->Length();
 	stream->Read(xml_source, source_size);
 
+	ParseSource();
+
+	xml_source.clear();
+	source_url = nullptr;
+}
+
+void BaseXMLParser::ParseSource()
+{
 	xml_index = 0;
 	line_number = 1;
 	line_number_open_tag = 1;
@@ -74,9 +84,6 @@ void BaseXMLParser::Parse(Stream* stream)
 	ReadHeader();
 	// Read the XML body.
 	ReadBody();
-
-	xml_source.clear();
-	source_url = nullptr;
 }
 
 int BaseXMLParser::GetLineNumber() const
@@ -120,19 +127,31 @@ void BaseXMLParser::HandleElementStartInternal(const String& name, const XMLAttr
 {
 	line_number_open_tag = line_number;
 	if (!inner_xml_data)
+	{
+		if (prototype_recording)
+			prototype_recording->RecordElementStart(name, attributes, line_number);
 		HandleElementStart(name, attributes);
+	}
 }
 
 void BaseXMLParser::HandleElementEndInternal(const String& name)
 {
 	if (!inner_xml_data)
+	{
+		if (prototype_recording)
+			prototype_recording->RecordElementEnd(name, line_number, line_number_open_tag);
 		HandleElementEnd(name);
+	}
 }
 
 void BaseXMLParser::HandleDataInternal(const String& data, XMLDataType type)
 {
 	if (!inner_xml_data)
+	{
+		if (prototype_recording)
+			prototype_recording->RecordData(data, type, line_number, line_number_open_tag);
 		HandleData(data, type);
+	}
 }
 
 void BaseXMLParser::ReadHeader()
@@ -234,7 +253,7 @@ bool BaseXMLParser::ReadOpenTag()
 	{
 		// It appears we have some attributes. Let's parse them.
 		bool parse_inner_xml_as_data = false;
-		XMLAttributes attributes;
+		attributes.clear();
 		if (!ReadAttributes(attributes, parse_inner_xml_as_data))
 			return false;
 
@@ -326,10 +345,13 @@ bool BaseXMLParser::ReadCloseTag(const size_t xml_index_tag)
 
 bool BaseXMLParser::ReadAttributes(XMLAttributes& attributes, bool& parse_raw_xml_content)
 {
+	String attribute;
+	String value;
+
 	for (;;)
 	{
-		String attribute;
-		String value;
+		attribute.clear();
+		value.clear();
 
 		// Get the attribute name
 		if (!FindWord(attribute, "=/>"))
@@ -359,7 +381,11 @@ bool BaseXMLParser::ReadAttributes(XMLAttributes& attributes, bool& parse_raw_xm
 		if (attributes_for_inner_xml_data.count(attribute) == 1)
 			parse_raw_xml_content = true;
 
-		attributes[attribute] = StringUtilities::DecodeRml(value);
+		// Most attribute values contain no entities, so they can be moved directly into the attribute.
+		if (value.find('&') == String::npos)
+			attributes[attribute] = std::move(value);
+		else
+			attributes[attribute] = StringUtilities::DecodeRml(value);
 
 		// Check for the end of the tag.
 		if (PeekString("/", false) || PeekString(">", false))
@@ -412,39 +438,30 @@ bool BaseXMLParser::ReadCDATA(const char* tag_terminator)
 
 bool BaseXMLParser::FindWord(String& word, const char* terminators)
 {
-	while (!AtEnd())
+	// Skip leading white space.
+	while (!AtEnd() && StringUtilities::IsWhitespace(Look()))
 	{
-		char c = Look();
-
 		// Count line numbers
-		if (c == '\n')
-		{
+		if (Look() == '\n')
 			line_number++;
-		}
 
-		// Ignore white space
-		if (StringUtilities::IsWhitespace(c))
-		{
-			if (word.empty())
-			{
-				Next();
-				continue;
-			}
-			else
-				return true;
-		}
+		Next();
+	}
 
-		// Check for termination condition
-		if (terminators && strchr(terminators, c))
-		{
-			return !word.empty();
-		}
+	// Find the end of the word, and then copy it in one go.
+	const size_t word_begin = xml_index;
+	while (!AtEnd())
+	{
+		const char c = Look();
+		if (StringUtilities::IsWhitespace(c) || (terminators && strchr(terminators, c)))
+			break;
 
-		word += c;
 		Next();
 	}
 
-	return false;
+	word.append(xml_source, word_begin, xml_index - word_begin);
+
+	return !AtEnd() && !word.empty();
 }
 
 bool BaseXMLParser::FindString(const char* string, String& data, bool escape_brackets)
@@ -454,8 +471,30 @@ bool BaseXMLParser::FindString(const char* string, String& data, bool escape_bra
 	bool in_string = false;
 	char previous = 0;
 
+	// Outside data brackets, only the first character of the string and curly brackets need to be inspected one by one.
+	const char stop_characters[] = {first_char, '{', '}', '\0'};
+
 	while (!AtEnd())
 	{
+		if (!in_brackets)
+		{
+			// Skip ahead to the next character of interest, and copy everything before it in bulk.
+			size_t run_end = (escape_brackets ? xml_source.find_first_of(stop_characters, xml_index) : xml_source.find(first_char, xml_index));
+			if (run_end == String::npos)
+				run_end = xml_source.size();
+
+			if (run_end > xml_index)
+			{
+				line_number += (int)std::count(xml_source.begin() + xml_index, xml_source.begin() + run_end, '\n');
+				data.append(xml_source, xml_index, run_end - xml_index);
+				previous = xml_source[run_end - 1];
+				xml_index = run_end;
+
+				if (AtEnd())
+					break;
+			}
+		}
+
 		const char c = Look();
 
 		// Count line numbers
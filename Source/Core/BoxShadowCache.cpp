@@ -0,0 +1,134 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#include "BoxShadowCache.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/RenderManager.h"
+#include "../../Include/RmlUi/Core/Utilities.h"
+
+namespace Rml {
+
+static bool operator==(const RenderBox& a, const RenderBox& b)
+{
+	return a.GetFillSize() == b.GetFillSize() && a.GetBorderOffset() == b.GetBorderOffset() && a.GetBorderWidths() == b.GetBorderWidths() &&
+		a.GetBorderRadius() == b.GetBorderRadius();
+}
+
+bool operator==(const BoxShadowTextureKey& a, const BoxShadowTextureKey& b)
+{
+	return a.background_color == b.background_color && a.border_colors == b.border_colors && a.border_radius == b.border_radius &&
+		a.shadow_list == b.shadow_list && a.padding_boxes == b.padding_boxes && a.border_boxes == b.border_boxes;
+}
+
+static void HashColour(size_t& seed, ColourbPremultiplied colour)
+{
+	Utilities::HashCombine(seed, uint32_t(colour.red) | uint32_t(colour.green) << 8 | uint32_t(colour.blue) << 16 | uint32_t(colour.alpha) << 24);
+}
+
+static void HashRenderBox(size_t& seed, const RenderBox& box)
+{
+	Utilities::HashCombine(seed, box.GetFillSize().x);
+	Utilities::HashCombine(seed, box.GetFillSize().y);
+	Utilities::HashCombine(seed, box.GetBorderOffset().x);
+	Utilities::HashCombine(seed, box.GetBorderOffset().y);
+	for (float width : box.GetBorderWidths())
+		Utilities::HashCombine(seed, width);
+}
+
+SharedPtr<CallbackTexture> BoxShadowCache::Find(const BoxShadowTextureKey& key) const
+{
+	auto it = textures.find(key);
+	if (it != textures.end())
+		return it->second.lock();
+	return nullptr;
+}
+
+SharedPtr<CallbackTexture> BoxShadowCache::Insert(BoxShadowTextureKey key, RenderManager& render_manager, CallbackTextureFunction&& callback)
+{
+	SharedPtr<CallbackTexture> texture = MakeShared<CallbackTexture>(render_manager.MakeCallbackTexture(std::move(callback)));
+
+	auto it = textures.find(key);
+	if (it != textures.end())
+	{
+		it->second = texture;
+	}
+	else
+	{
+		if (textures.size() >= remove_expired_threshold)
+			RemoveExpiredEntries();
+		textures.emplace(std::move(key), texture);
+	}
+
+	return texture;
+}
+
+void BoxShadowCache::RemoveExpiredEntries()
+{
+	for (auto it = textures.begin(); it != textures.end();)
+	{
+		if (it->second.expired())
+			it = textures.erase(it);
+		else
+			++it;
+	}
+
+	// Amortize the cost of removal by scaling the threshold with the number of live entries.
+	remove_expired_threshold = Math::Max(textures.size() * 2, size_t(64));
+}
+
+} // namespace Rml
+
+size_t std::hash<::Rml::BoxShadowTextureKey>::operator()(const ::Rml::BoxShadowTextureKey& key) const noexcept
+{
+	size_t seed = 0;
+
+	for (const ::Rml::RenderBox& box : key.padding_boxes)
+		::Rml::HashRenderBox(seed, box);
+	for (const ::Rml::RenderBox& box : key.border_boxes)
+		::Rml::HashRenderBox(seed, box);
+
+	::Rml::HashColour(seed, key.background_color);
+	for (::Rml::ColourbPremultiplied colour : key.border_colors)
+		::Rml::HashColour(seed, colour);
+
+	for (const ::Rml::BoxShadow& shadow : key.shadow_list)
+	{
+		::Rml::HashColour(seed, shadow.color);
+		::Rml::Utilities::HashCombine(seed, shadow.offset_x.number);
+		::Rml::Utilities::HashCombine(seed, shadow.offset_y.number);
+		::Rml::Utilities::HashCombine(seed, shadow.blur_radius.number);
+		::Rml::Utilities::HashCombine(seed, shadow.spread_distance.number);
+		::Rml::Utilities::HashCombine(seed, shadow.inset);
+	}
+
+	for (float radius : key.border_radius)
+		::Rml::Utilities::HashCombine(seed, radius);
+
+	return seed;
+}
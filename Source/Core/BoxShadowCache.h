@@ -0,0 +1,90 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#ifndef RMLUI_CORE_BOXSHADOWCACHE_H
+#define RMLUI_CORE_BOXSHADOWCACHE_H
+
+#include "../../Include/RmlUi/Core/CallbackTexture.h"
+#include "../../Include/RmlUi/Core/DecorationTypes.h"
+#include "../../Include/RmlUi/Core/RenderBox.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+/*
+    Fully describes the contents of a box-shadow texture, with all lengths resolved to pixels. The texture also contains the element's background
+    and border, thus these are part of the key as well.
+*/
+struct BoxShadowTextureKey {
+	// The padding and border area render boxes of each of the element's boxes, in corresponding order.
+	Vector<RenderBox> padding_boxes;
+	Vector<RenderBox> border_boxes;
+
+	ColourbPremultiplied background_color;
+	Array<ColourbPremultiplied, 4> border_colors;
+
+	BoxShadowList shadow_list;
+	CornerSizes border_radius;
+};
+
+bool operator==(const BoxShadowTextureKey& a, const BoxShadowTextureKey& b);
+
+} // namespace Rml
+
+namespace std {
+// Hash specialization for the box-shadow texture key, so it can be used as key in UnorderedMap.
+template <>
+struct hash<::Rml::BoxShadowTextureKey> {
+	size_t operator()(const ::Rml::BoxShadowTextureKey& key) const noexcept;
+};
+} // namespace std
+
+namespace Rml {
+
+/**
+    Shares box-shadow textures between elements with identical shadows, backgrounds, and borders.
+
+    The cache only keeps weak references, the textures are owned by the elements using them and released together with the last such element.
+ */
+class BoxShadowCache : NonCopyMoveable {
+public:
+	/// Returns the shared texture for the given key, or null if no element currently uses such a texture.
+	SharedPtr<CallbackTexture> Find(const BoxShadowTextureKey& key) const;
+	/// Makes a new shared texture from the given callback, and stores it under the given key.
+	SharedPtr<CallbackTexture> Insert(BoxShadowTextureKey key, RenderManager& render_manager, CallbackTextureFunction&& callback);
+
+private:
+	void RemoveExpiredEntries();
+
+	UnorderedMap<BoxShadowTextureKey, WeakPtr<CallbackTexture>> textures;
+	size_t remove_expired_threshold = 64;
+};
+
+} // namespace Rml
+#endif
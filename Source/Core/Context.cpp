@@ -39,11 +39,16 @@
 #include "../../Include/RmlUi/Core/RenderManager.h"
 #include "../../Include/RmlUi/Core/StreamMemory.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
+#include "AnimationScheduler.h"
+#include "Clock.h"
 #include "DataModel.h"
+#include "ElementAnimation.h"
+#include "ElementArena.h"
 #include "EventDispatcher.h"
 #include "PluginRegistry.h"
 #include "ScrollController.h"
 #include "StreamFile.h"
+#include "ThreadPool.h"
 #include <algorithm>
 #include <iterator>
 #include <limits>
@@ -104,6 +109,8 @@ Context::~Context()
 {
 	PluginRegistry::NotifyContextDestroy(this);
 
+	animation_scheduler.reset();
+
 	UnloadAllDocuments();
 
 	ReleaseUnloadedDocuments();
@@ -112,6 +119,8 @@ Context::~Context()
 
 	cursor_proxy.reset();
 
+	EnableElementArena(false);
+
 	instancer = nullptr;
 }
 
@@ -176,6 +185,9 @@ bool Context::Update()
 {
 	RMLUI_ZoneScoped;
 
+	// Elements created by data views and during layout belong to this context.
+	ElementArena::Scope arena_scope(element_arena);
+
 	next_update_timeout = std::numeric_limits<double>::infinity();
 
 	if (scroll_controller->Update(mouse_position, density_independent_pixel_ratio))
@@ -186,8 +198,17 @@ bool Context::Update()
 		UpdateHoverChain(mouse_position);
 
 	// Update all the data models before updating properties and layout.
+	const double data_view_deadline = (data_view_update_budget > 0 ? Clock::GetElapsedTime() + data_view_update_budget
+																	: std::numeric_limits<double>::infinity());
+	data_view_counters = {};
 	for (auto& data_model : data_models)
-		data_model.second->Update(true);
+	{
+		data_model.second->Update(true, data_view_deadline);
+		data_view_counters.processed_views += data_model.second->GetNumProcessedViews();
+		data_view_counters.deferred_views += data_model.second->GetNumDeferredViews();
+	}
+	if (data_view_counters.deferred_views > 0)
+		RequestNextUpdate(0);
 
 	// The style definition of each document should be independent of each other. By manually resetting these flags we avoid unnecessary definition
 	// lookups in unrelated documents, such as when adding a new document. Adding an element dirties the parent definition, which in this case is the
@@ -195,8 +216,17 @@ bool Context::Update()
 	root->dirty_definition = false;
 	root->dirty_child_definitions = false;
 
+	if (style_thread_pool)
+		root->ComputeStyleParallel(*style_thread_pool, density_independent_pixel_ratio, Vector2f(dimensions));
+
+	if (animation_scheduler)
+		animation_scheduler->Update(Clock::GetElapsedTime());
+
 	root->Update(density_independent_pixel_ratio, Vector2f(dimensions));
 
+	if (animation_scheduler)
+		animation_scheduler->ApplyValues();
+
 	for (int i = 0; i < root->GetNumChildren(); ++i)
 	{
 		if (auto doc = root->GetChild(i)->GetOwnerDocument())
@@ -236,6 +266,7 @@ bool Context::Render()
 
 ElementDocument* Context::CreateDocument(const String& instancer_name)
 {
+	ElementArena::Scope arena_scope(element_arena);
 	ElementPtr element = Factory::InstanceElement(nullptr, instancer_name, documents_base_tag, XMLAttributes());
 	if (!element)
 	{
@@ -274,6 +305,9 @@ ElementDocument* Context::LoadDocument(const String& document_path)
 
 ElementDocument* Context::LoadDocument(Stream* stream)
 {
+	// Elements created by the load event handlers and by data views during the initial update also belong to this context.
+	ElementArena::Scope arena_scope(element_arena);
+
 	PluginRegistry::NotifyDocumentOpen(this, stream->GetSourceURL().GetURL());
 
 	ElementPtr element = Factory::InstanceDocumentStream(this, stream, GetDocumentsBaseTag());
@@ -578,7 +612,8 @@ bool Context::ProcessMouseMove(int x, int y, int key_modifier_state)
 	mouse_active = true;
 
 	// Update the current hover chain. This will send all necessary 'onmouseout', 'onmouseover', 'ondragout' and 'ondragover' messages.
-	Dictionary parameters, drag_parameters;
+	Dictionary& parameters = mouse_move_parameters;
+	Dictionary& drag_parameters = mouse_move_drag_parameters;
 	UpdateHoverChain(old_mouse_position, key_modifier_state, &parameters, &drag_parameters);
 
 	// Dispatch any 'onmousemove' events.
@@ -858,6 +893,11 @@ RenderManager& Context::GetRenderManager()
 	return *render_manager;
 }
 
+const RenderManager& Context::GetRenderManager() const
+{
+	return *render_manager;
+}
+
 TextInputHandler* Context::GetTextInputHandler() const
 {
 	return text_input_handler;
@@ -915,6 +955,12 @@ bool Context::RemoveDataModel(const String& name)
 
 void Context::OnElementDetach(Element* element)
 {
+	if (animation_scheduler)
+	{
+		for (ElementAnimation& animation : element->animations)
+			element->ReleaseScheduledAnimation(animation);
+	}
+
 	auto it_hover = hover_chain.find(element);
 	if (it_hover != hover_chain.end())
 	{
@@ -1393,6 +1439,77 @@ void Context::Release()
 	}
 }
 
+void Context::SetDataViewUpdateBudget(double budget)
+{
+	data_view_update_budget = Math::Max(budget, 0.0);
+}
+
+double Context::GetDataViewUpdateBudget() const
+{
+	return data_view_update_budget;
+}
+
+Context::DataViewCounters Context::GetDataViewCounters() const
+{
+	return data_view_counters;
+}
+
+void Context::SetStyleUpdateThreads(int num_threads)
+{
+	if (num_threads == GetStyleUpdateThreads())
+		return;
+
+	style_thread_pool.reset();
+	if (num_threads > 0)
+		style_thread_pool = MakeUnique<ThreadPool>(num_threads);
+}
+
+int Context::GetStyleUpdateThreads() const
+{
+	return style_thread_pool ? style_thread_pool->GetNumThreads() : 0;
+}
+
+void Context::EnableAnimationScheduler(bool enable)
+{
+	if (enable && !animation_scheduler)
+		animation_scheduler = MakeUnique<AnimationScheduler>();
+	else if (!enable)
+		animation_scheduler.reset();
+}
+
+bool Context::IsAnimationSchedulerEnabled() const
+{
+	return animation_scheduler != nullptr;
+}
+
+void Context::EnableElementArena(bool enable)
+{
+	if (enable && !element_arena)
+	{
+		element_arena = new ElementArena();
+	}
+	else if (!enable && element_arena)
+	{
+		element_arena->Release();
+		element_arena = nullptr;
+	}
+}
+
+bool Context::IsElementArenaEnabled() const
+{
+	return element_arena != nullptr;
+}
+
+void Context::EnableBoxShadowNineSlice(bool enable)
+{
+	box_shadow_nine_slice = enable;
+}
+
+bool Context::IsBoxShadowNineSliceEnabled() const
+{
+	return box_shadow_nine_slice;
+}
+
 void Context::SetDocumentsBaseTag(const String& tag)
 {
 	documents_base_tag = tag;
@@ -51,6 +51,7 @@
 #include "StyleSheetFactory.h"
 #include "StyleSheetParser.h"
 #include "TemplateCache.h"
+#include "ThreadPool.h"
 
 #ifdef RMLUI_FONT_ENGINE_FREETYPE
 	#include "FontEngineDefault/FontEngineInterfaceDefault.h"
@@ -83,6 +84,8 @@ struct CoreData {
 
 	SmallUnorderedMap<RenderInterface*, UniquePtr<RenderManager>> render_managers;
 	UnorderedMap<String, ContextPtr> contexts;
+
+	UniquePtr<ThreadPool> update_thread_pool;
 };
 
 static ControlledLifetimeResource<CoreData> core_data;
@@ -356,6 +359,52 @@ int GetNumContexts()
 	return (int)core_data->contexts.size();
 }
 
+bool UpdateContexts(Span<Context* const> contexts, int num_threads)
+{
+	RMLUI_ZoneScoped;
+
+	if (num_threads <= 0 || contexts.size() <= 1)
+	{
+		bool result = true;
+		for (Context* context : contexts)
+			result &= context->Update();
+		return result;
+	}
+
+	// Contexts using the same render manager share its texture and geometry databases, thus they are updated together.
+	Vector<Vector<Context*>> groups;
+	SmallUnorderedMap<RenderManager*, size_t> group_indices;
+	for (Context* context : contexts)
+	{
+		auto it = group_indices.emplace(&context->GetRenderManager(), groups.size()).first;
+		if (it->second == groups.size())
+			groups.emplace_back();
+		groups[it->second].push_back(context);
+	}
+
+	UniquePtr<ThreadPool>& thread_pool = core_data->update_thread_pool;
+	if (!thread_pool || thread_pool->GetNumThreads() != num_threads)
+	{
+		thread_pool.reset();
+		thread_pool = MakeUnique<ThreadPool>(num_threads);
+	}
+
+	std::atomic<bool> result{true};
+	for (const Vector<Context*>& group : groups)
+	{
+		thread_pool->Submit([&group, &result]() {
+			for (Context* context : group)
+			{
+				if (!context->Update())
+					result = false;
+			}
+		});
+	}
+	thread_pool->Wait();
+
+	return result;
+}
+
 bool LoadFontFace(const String& file_path, bool fallback_face, Style::FontWeight weight, int face_index)
 {
 	return font_interface->LoadFontFace(file_path, face_index, fallback_face, weight);
@@ -101,6 +101,29 @@ static const char* LegalVariableName(const String& name)
 	return nullptr;
 }
 
+// Resolve struct member names in the address to indices into their member tables, so that subsequent lookups skip the name search.
+static void ResolveMemberIndices(DataVariable variable, DataAddress& address)
+{
+	for (size_t i = 1; i < address.size() && variable; i++)
+	{
+		DataAddressEntry& entry = address[i];
+		switch (variable.Type())
+		{
+		case DataVariableType::Struct:
+			entry.member_index = variable.GetMemberIndex(entry.name);
+			if (entry.member_index < 0)
+				return;
+			break;
+		case DataVariableType::Array:
+			if (entry.index < 0 || entry.index >= variable.Size())
+				return;
+			break;
+		case DataVariableType::Scalar: return;
+		}
+		variable = variable.Child(entry);
+	}
+}
+
 static String DataAddressToString(const DataAddress& address)
 {
 	String result;
@@ -260,7 +283,10 @@ DataAddress DataModel::ResolveAddress(const String& address_str, Element* elemen
 
 	auto it = variables.find(first_name);
 	if (it != variables.end())
+	{
+		ResolveMemberIndices(it->second, address);
 		return address;
+	}
 
 	// Look for a variable alias for the first name.
 
@@ -284,6 +310,11 @@ DataAddress DataModel::ResolveAddress(const String& address_str, Element* elemen
 				// Insert the full alias address, replacing the first element.
 				address[0] = replace_address[0];
 				address.insert(address.begin() + 1, replace_address.begin() + 1, replace_address.end());
+
+				auto it_variable = variables.find(address.front().name);
+				if (it_variable != variables.end())
+					ResolveMemberIndices(it_variable->second, address);
+
 				return address;
 			}
 		}
@@ -393,9 +424,9 @@ void DataModel::OnElementRemove(Element* element)
 	attached_elements.erase(element);
 }
 
-bool DataModel::Update(bool clear_dirty_variables)
+bool DataModel::Update(bool clear_dirty_variables, double deadline)
 {
-	const bool result = views->Update(*this, dirty_variables);
+	const bool result = views->Update(*this, dirty_variables, deadline);
 
 	if (clear_dirty_variables)
 		dirty_variables.clear();
@@ -403,4 +434,14 @@ bool DataModel::Update(bool clear_dirty_variables)
 	return result;
 }
 
+int DataModel::GetNumProcessedViews() const
+{
+	return views->GetNumProcessedViews();
+}
+
+int DataModel::GetNumDeferredViews() const
+{
+	return views->GetNumDeferredViews();
+}
+
 } // namespace Rml
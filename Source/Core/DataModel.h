@@ -34,6 +34,7 @@
 #include "../../Include/RmlUi/Core/Header.h"
 #include "../../Include/RmlUi/Core/Traits.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include <limits>
 
 namespace Rml {
 
@@ -78,7 +79,12 @@ public:
 
 	void OnElementRemove(Element* element);
 
-	bool Update(bool clear_dirty_variables);
+	// Update the dirty data views of this model. Views not updated before the deadline, in terms of elapsed time, are deferred to later updates.
+	bool Update(bool clear_dirty_variables, double deadline = std::numeric_limits<double>::infinity());
+
+	// Returns the number of views processed during the last update, and the number of views deferred to later updates.
+	int GetNumProcessedViews() const;
+	int GetNumDeferredViews() const;
 
 	inline DataTypeRegister* GetDataTypeRegister() const { return data_type_register; }
 
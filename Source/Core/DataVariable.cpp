@@ -55,6 +55,11 @@ DataVariableType DataVariable::Type()
 	return definition->Type();
 }
 
+int DataVariable::GetMemberIndex(const String& name)
+{
+	return definition->GetMemberIndex(name);
+}
+
 bool VariableDefinition::Get(void* /*ptr*/, Variant& /*variant*/)
 {
 	Log::Message(Log::LT_WARNING, "Values can only be retrieved from scalar data types.");
@@ -75,6 +80,10 @@ DataVariable VariableDefinition::Child(void* /*ptr*/, const DataAddressEntry& /*
 	Log::Message(Log::LT_WARNING, "Tried to get the child of a scalar type.");
 	return DataVariable();
 }
+int VariableDefinition::GetMemberIndex(const String& /*name*/)
+{
+	return -1;
+}
 
 class LiteralIntDefinition final : public VariableDefinition {
 public:
@@ -104,24 +113,41 @@ DataVariable StructDefinition::Child(void* ptr, const DataAddressEntry& address)
 		return DataVariable();
 	}
 
-	auto it = members.find(name);
-	if (it == members.end())
+	int member_index = address.member_index;
+	if (member_index >= 0 && member_index < (int)members.size())
 	{
-		Log::Message(Log::LT_WARNING, "Member %s not found in data struct.", name.c_str());
-		return DataVariable();
+		RMLUI_ASSERTMSG(GetMemberIndex(name) == member_index, "Resolved member index does not match the member name.");
+	}
+	else
+	{
+		member_index = GetMemberIndex(name);
+		if (member_index < 0)
+		{
+			Log::Message(Log::LT_WARNING, "Member %s not found in data struct.", name.c_str());
+			return DataVariable();
+		}
 	}
 
-	VariableDefinition* next_definition = it->second.get();
+	VariableDefinition* next_definition = members[member_index].get();
 
 	return DataVariable(next_definition, ptr);
 }
 
+int StructDefinition::GetMemberIndex(const String& name)
+{
+	auto it = member_indices.find(name);
+	if (it == member_indices.end())
+		return -1;
+	return it->second;
+}
+
 void StructDefinition::AddMember(const String& name, UniquePtr<VariableDefinition> member)
 {
 	RMLUI_ASSERT(member);
-	bool inserted = members.emplace(name, std::move(member)).second;
+	bool inserted = member_indices.emplace(name, (int)members.size()).second;
 	RMLUI_ASSERTMSG(inserted, "Member name already exists.");
-	(void)inserted;
+	if (inserted)
+		members.push_back(std::move(member));
 }
 
 FuncDefinition::FuncDefinition(DataGetFunc get, DataSetFunc set) :
@@ -176,4 +202,9 @@ DataVariable BasePointerDefinition::Child(void* ptr, const DataAddressEntry& add
 	return underlying_definition->Child(DereferencePointer(ptr), address);
 }
 
+int BasePointerDefinition::GetMemberIndex(const String& name)
+{
+	return underlying_definition->GetMemberIndex(name);
+}
+
 } // namespace Rml
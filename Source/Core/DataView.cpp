@@ -28,7 +28,10 @@
 
 #include "DataView.h"
 #include "../../Include/RmlUi/Core/Element.h"
+#include "../../Include/RmlUi/Core/ElementDocument.h"
+#include "Clock.h"
 #include <algorithm>
+#include <limits>
 
 namespace Rml {
 
@@ -87,19 +90,34 @@ void DataViews::OnElementRemove(Element* element)
 	}
 }
 
-bool DataViews::Update(DataModel& model, const DirtyVariables& dirty_variables)
+static bool IsInVisibleDocument(const DataView* view)
+{
+	if (!view->IsValid())
+		return false;
+	ElementDocument* document = view->GetElement()->GetOwnerDocument();
+	return document && document->IsVisible();
+}
+
+bool DataViews::Update(DataModel& model, const DirtyVariables& dirty_variables, double deadline)
 {
 	bool result = false;
 	size_t num_dirty_variables_prev = 0;
+	const bool use_deadline = (deadline < std::numeric_limits<double>::infinity());
+	bool deadline_reached = false;
+
+	num_processed_views = 0;
+
+	// Variables already mapped to dirty views, only tracked when running on a budget.
+	DirtyVariables mapped_variables;
 
 	// View updates may result in newly added views, or even new dirty variables. Thus, we do the
 	// update recursively but with an upper limit. Without the loop, newly added views won't be
 	// updated until the next Update() call.
-	for (int i = 0; (i == 0 || !views_to_add.empty() || num_dirty_variables_prev != dirty_variables.size()) && i < 10; i++)
+	for (int i = 0; (i == 0 || !views_to_add.empty() || num_dirty_variables_prev != dirty_variables.size()) && i < 10 && !deadline_reached; i++)
 	{
 		num_dirty_variables_prev = dirty_variables.size();
-
-		Vector<DataView*> dirty_views;
+		if (use_deadline)
+			mapped_variables = dirty_variables;
 
 		if (!views_to_add.empty())
 		{
@@ -131,16 +149,32 @@ bool DataViews::Update(DataModel& model, const DirtyVariables& dirty_variables)
 		// children. Eg. the 'data-for' view will remove children if any of its data variable array size is reduced.
 		std::sort(dirty_views.begin(), dirty_views.end(), [](auto&& left, auto&& right) { return left->GetSortOrder() < right->GetSortOrder(); });
 
+		// When running on a budget, update views in visible documents first. Views in separate documents are independent, so this retains the
+		// depth ordering within each document.
+		if (use_deadline)
+			std::stable_partition(dirty_views.begin(), dirty_views.end(), IsInVisibleDocument);
+
+		size_t num_updated_views = 0;
 		for (DataView* view : dirty_views)
 		{
 			RMLUI_ASSERT(view);
+			num_updated_views += 1;
 			if (!view)
 				continue;
 
 			if (view->IsValid())
 				result |= view->Update(model);
+
+			if (use_deadline && Clock::GetElapsedTime() >= deadline)
+			{
+				deadline_reached = true;
+				break;
+			}
 		}
 
+		num_processed_views += (int)num_updated_views;
+		dirty_views.erase(dirty_views.begin(), dirty_views.begin() + num_updated_views);
+
 		// Destroy views marked for destruction
 		// @performance: Horrible...
 		if (!views_to_remove.empty())
@@ -154,13 +188,41 @@ bool DataViews::Update(DataModel& model, const DirtyVariables& dirty_variables)
 					else
 						++it;
 				}
+				dirty_views.erase(std::remove(dirty_views.begin(), dirty_views.end(), view.get()), dirty_views.end());
 			}
 
 			views_to_remove.clear();
 		}
 	}
 
+	// View updates may have dirtied more variables before the deadline was reached. Their views would normally be picked up by the next
+	// iteration, but the dirty variables are cleared after this call, so carry the views over to the following updates instead.
+	if (deadline_reached && num_dirty_variables_prev != dirty_variables.size())
+	{
+		for (const String& variable_name : dirty_variables)
+		{
+			if (mapped_variables.count(variable_name))
+				continue;
+			auto pair = name_view_map.equal_range(variable_name);
+			for (auto it = pair.first; it != pair.second; ++it)
+				dirty_views.push_back(it->second);
+		}
+
+		std::sort(dirty_views.begin(), dirty_views.end());
+		dirty_views.erase(std::unique(dirty_views.begin(), dirty_views.end()), dirty_views.end());
+	}
+
 	return result;
 }
 
+int DataViews::GetNumProcessedViews() const
+{
+	return num_processed_views;
+}
+
+int DataViews::GetNumDeferredViews() const
+{
+	return int(dirty_views.size() + views_to_add.size());
+}
+
 } // namespace Rml
@@ -112,13 +112,22 @@ public:
 
 	void OnElementRemove(Element* element);
 
-	bool Update(DataModel& model, const DirtyVariables& dirty_variables);
+	// Update all views dirtied by the given variables, and any views deferred from previous updates. If the elapsed time reaches the deadline,
+	// the remaining dirty views are deferred to the next update. Views located in visible documents are then prioritized.
+	bool Update(DataModel& model, const DirtyVariables& dirty_variables, double deadline);
+
+	int GetNumProcessedViews() const;
+	int GetNumDeferredViews() const;
 
 private:
 	using DataViewList = Vector<DataViewPtr>;
 
 	DataViewList views;
 
+	// Dirty views awaiting update, non-empty between updates only when views have been deferred.
+	Vector<DataView*> dirty_views;
+	int num_processed_views = 0;
+
 	DataViewList views_to_add;
 	DataViewList views_to_remove;
 
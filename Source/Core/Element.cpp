@@ -43,10 +43,12 @@
 #include "../../Include/RmlUi/Core/StyleSheet.h"
 #include "../../Include/RmlUi/Core/StyleSheetSpecification.h"
 #include "../../Include/RmlUi/Core/TransformPrimitive.h"
+#include "AnimationScheduler.h"
 #include "Clock.h"
 #include "ComputeProperty.h"
 #include "DataModel.h"
 #include "ElementAnimation.h"
+#include "ElementArena.h"
 #include "ElementBackgroundBorder.h"
 #include "ElementDefinition.h"
 #include "ElementEffects.h"
@@ -60,6 +62,7 @@
 #include "PropertiesIterator.h"
 #include "StyleSheetNode.h"
 #include "StyleSheetParser.h"
+#include "ThreadPool.h"
 #include "TransformState.h"
 #include "TransformUtilities.h"
 #include "XMLParseTools.h"
@@ -92,10 +95,16 @@ static float GetScrollOffsetDelta(ScrollAlignment alignment, float begin_offset,
 	return 0.f;
 }
 
+// Returns the size of the given scrollbar, or zero if the element has never needed scrolling
+static float GetScrollbarSize(const ElementMeta& meta, ElementScroll::Orientation orientation)
+{
+	return meta.scroll ? meta.scroll->GetScrollbarSize(orientation) : 0.f;
+}
+
 Element::Element(const String& tag) :
 	local_stacking_context(false), local_stacking_context_forced(false), stacking_context_dirty(false), computed_values_are_default_initialized(true),
 	visible(true), offset_fixed(false), absolute_offset_dirty(true), rounded_main_padding_size_dirty(true), dirty_definition(false),
-	dirty_child_definitions(false), dirty_animation(false), dirty_transition(false), dirty_transform(false), dirty_perspective(false), tag(tag),
+	dirty_child_definitions(false), dirty_style_subtree(false), dirty_animation(false), dirty_transition(false), dirty_transform(false), dirty_perspective(false), tag(tag),
 	relative_offset_base(0, 0), relative_offset_position(0, 0), absolute_offset(0, 0), scroll_offset(0, 0)
 {
 	RMLUI_ASSERT(tag == StringUtilities::ToLower(tag));
@@ -113,7 +122,8 @@ Element::Element(const String& tag) :
 
 	z_index = 0;
 
-	meta = ElementMetaPool::element_meta_pool->pool.AllocateAndConstruct(this);
+	arena = ElementArena::GetActive();
+	meta = (arena ? arena->AllocateMeta(this) : ElementMetaPool::element_meta_pool->pool.AllocateAndConstruct(this));
 	data_model = nullptr;
 }
 
@@ -136,7 +146,10 @@ Element::~Element()
 	children.clear();
 	num_non_dom_children = 0;
 
-	ElementMetaPool::element_meta_pool->pool.DestroyAndDeallocate(meta);
+	if (arena)
+		arena->DeallocateMeta(meta);
+	else
+		ElementMetaPool::element_meta_pool->pool.DestroyAndDeallocate(meta);
 }
 
 void Element::Update(float dp_ratio, Vector2f vp_dimensions)
@@ -153,7 +166,8 @@ void Element::Update(float dp_ratio, Vector2f vp_dimensions)
 	HandleAnimationProperty();
 	AdvanceAnimations();
 
-	meta->scroll.Update();
+	if (meta->scroll)
+		meta->scroll->Update();
 
 	UpdateProperties(dp_ratio, vp_dimensions);
 
@@ -165,7 +179,8 @@ void Element::Update(float dp_ratio, Vector2f vp_dimensions)
 		UpdateProperties(dp_ratio, vp_dimensions);
 	}
 
-	meta->effects.InstanceEffects();
+	if (meta->effects)
+		meta->effects->InstanceEffects();
 
 	for (size_t i = 0; i < children.size(); i++)
 		children[i]->Update(dp_ratio, vp_dimensions);
@@ -181,21 +196,115 @@ void Element::UpdateProperties(const float dp_ratio, const Vector2f vp_dimension
 {
 	UpdateDefinition();
 
+	ComputeStyle(dp_ratio, vp_dimensions);
+
+	// Computed values are just calculated and can safely be used in OnPropertyChange.
+	// However, new properties set during this call will not be available until the next update loop.
+	if (!meta->changed_properties.Empty())
+	{
+		PropertyIdSet changed_properties = meta->changed_properties;
+		meta->changed_properties.Clear();
+		OnPropertyChange(changed_properties);
+	}
+}
+
+void Element::ComputeStyle(const float dp_ratio, const Vector2f vp_dimensions)
+{
 	if (meta->style.AnyPropertiesDirty())
 	{
 		const ComputedValues* parent_values = parent ? &parent->GetComputedValues() : nullptr;
 		const ComputedValues* document_values = owner_document ? &owner_document->GetComputedValues() : nullptr;
 
 		// Compute values and clear dirty properties
-		PropertyIdSet dirty_properties = meta->style.ComputeValues(meta->computed_values, parent_values, document_values,
+		meta->changed_properties |= meta->style.ComputeValues(meta->computed_values, parent_values, document_values,
 			computed_values_are_default_initialized, dp_ratio, vp_dimensions);
 
 		computed_values_are_default_initialized = false;
+	}
+}
+
+// Summary of an element's subtree, stored in document order during the parallel style update.
+struct Element::StyleSubtree {
+	int size;      // The number of elements in the subtree, including its root.
+	int num_dirty; // The number of elements in the subtree which may need their values computed.
+};
+
+// Below this number of dirty elements, values are left to be computed during the serial update.
+static constexpr int min_parallel_style_elements = 256;
+// Dirty subtrees of at least this size are computed as separate tasks, smaller subtrees are computed by their parent's task.
+static constexpr int min_style_task_elements = 32;
+
+void Element::ComputeStyleParallel(ThreadPool& thread_pool, const float dp_ratio, const Vector2f vp_dimensions)
+{
+	RMLUI_ZoneScoped;
+
+	if (!dirty_style_subtree)
+		return;
+
+	// Definitions are looked up in the style sheet's shared caches, thus, update them serially first. This also determines where values need
+	// to be computed, so that clean subtrees can be skipped.
+	Vector<StyleSubtree> subtrees;
+	subtrees.push_back({});
+	const int num_dirty = UpdateDefinitionRecursive(subtrees, false);
+	subtrees[0] = StyleSubtree{(int)subtrees.size(), num_dirty};
+
+	if (num_dirty < min_parallel_style_elements)
+		return;
+
+	const StyleSubtree* subtree = subtrees.data();
+	thread_pool.Submit([this, &thread_pool, subtree, dp_ratio, vp_dimensions]() { ComputeStyleRecursive(thread_pool, subtree, dp_ratio, vp_dimensions); });
+	thread_pool.Wait();
+}
+
+int Element::UpdateDefinitionRecursive(Vector<StyleSubtree>& subtrees, const bool parent_inherited_dirty)
+{
+	UpdateDefinition();
+
+	// Computing an element's values dirties the inherited properties of its children, include those here as well.
+	const ElementStyle& style = meta->style;
+	const bool dirty = (parent_inherited_dirty || style.AnyPropertiesDirty());
+	const bool inherited_dirty = (parent_inherited_dirty || (dirty && style.AnyInheritedPropertiesDirty()));
+	int num_dirty = (dirty ? 1 : 0);
+
+	// Every child gets an entry, but only children which may need an update are visited.
+	for (const ElementPtr& child : children)
+	{
+		const size_t index = subtrees.size();
+		subtrees.push_back({1, 0});
+		if (inherited_dirty || child->dirty_style_subtree || child->dirty_definition)
+		{
+			const int child_num_dirty = child->UpdateDefinitionRecursive(subtrees, inherited_dirty);
+			subtrees[index] = StyleSubtree{int(subtrees.size() - index), child_num_dirty};
+			num_dirty += child_num_dirty;
+		}
+	}
+
+	// Cleared last, so that any properties dirtied by our definition update above don't mark our ancestors again.
+	dirty_style_subtree = false;
+
+	return num_dirty;
+}
+
+void Element::ComputeStyleRecursive(ThreadPool& thread_pool, const StyleSubtree* subtree, const float dp_ratio, const Vector2f vp_dimensions)
+{
+	// Computed values only depend on the parent's computed values, which are already computed at this point.
+	ComputeStyle(dp_ratio, vp_dimensions);
 
-		// Computed values are just calculated and can safely be used in OnPropertyChange.
-		// However, new properties set during this call will not be available until the next update loop.
-		if (!dirty_properties.Empty())
-			OnPropertyChange(dirty_properties);
+	const StyleSubtree* child_subtree = subtree + 1;
+	for (const ElementPtr& child_ptr : children)
+	{
+		Element* child = child_ptr.get();
+		if (child_subtree->num_dirty >= min_style_task_elements)
+		{
+			thread_pool.Submit([child, &thread_pool, child_subtree, dp_ratio, vp_dimensions]() {
+				child->ComputeStyleRecursive(thread_pool, child_subtree, dp_ratio, vp_dimensions);
+			});
+		}
+		else if (child_subtree->num_dirty > 0)
+		{
+			child->ComputeStyleRecursive(thread_pool, child_subtree, dp_ratio, vp_dimensions);
+		}
+		child_subtree += child_subtree->size;
 	}
 }
 
@@ -218,13 +327,16 @@ void Element::Render()
 	// Apply our transform
 	ElementUtilities::ApplyTransform(*this);
 
-	meta->effects.RenderEffects(RenderStage::Enter);
+	ElementEffects* effects = meta->effects.get();
+	if (effects)
+		effects->RenderEffects(RenderStage::Enter);
 
 	// Set up the clipping region for this element.
 	if (ElementUtilities::SetClippingRegion(this))
 	{
 		meta->background_border.Render(this);
-		meta->effects.RenderEffects(RenderStage::Decoration);
+		if (effects)
+			effects->RenderEffects(RenderStage::Decoration);
 
 		{
 			RMLUI_ZoneScopedNC("OnRender", 0x228B22);
@@ -237,7 +349,8 @@ void Element::Render()
 	for (Element* element : stacking_context)
 		element->Render();
 
-	meta->effects.RenderEffects(RenderStage::Exit);
+	if (effects)
+		effects->RenderEffects(RenderStage::Exit);
 }
 
 ElementPtr Element::Clone() const
@@ -422,7 +535,8 @@ void Element::UpdateAbsoluteOffsetAndRenderBoxData()
 			rounded_main_padding_size = new_rounded_main_padding_size;
 			meta->background_border.DirtyBackground();
 			meta->background_border.DirtyBorder();
-			meta->effects.DirtyEffectsData();
+			if (meta->effects)
+				meta->effects->DirtyEffectsData();
 		}
 	}
 }
@@ -467,7 +581,8 @@ void Element::SetBox(const Box& box)
 		rounded_main_padding_size_dirty = true;
 		meta->background_border.DirtyBackground();
 		meta->background_border.DirtyBorder();
-		meta->effects.DirtyEffectsData();
+		if (meta->effects)
+			meta->effects->DirtyEffectsData();
 	}
 }
 
@@ -477,7 +592,8 @@ void Element::AddBox(const Box& box, Vector2f offset)
 	OnResize();
 	meta->background_border.DirtyBackground();
 	meta->background_border.DirtyBorder();
-	meta->effects.DirtyEffectsData();
+	if (meta->effects)
+		meta->effects->DirtyEffectsData();
 }
 
 const Box& Element::GetBox()
@@ -705,8 +821,8 @@ Vector2f Element::GetContainingBlock()
 		if (position_property == Position::Static || position_property == Position::Relative)
 		{
 			containing_block = parent_box.GetSize();
-			containing_block.x -= meta->scroll.GetScrollbarSize(ElementScroll::VERTICAL);
-			containing_block.y -= meta->scroll.GetScrollbarSize(ElementScroll::HORIZONTAL);
+			containing_block.x -= GetScrollbarSize(*meta, ElementScroll::VERTICAL);
+			containing_block.y -= GetScrollbarSize(*meta, ElementScroll::HORIZONTAL);
 		}
 		else if (position_property == Position::Absolute || position_property == Position::Fixed)
 		{
@@ -946,12 +1062,12 @@ float Element::GetClientTop()
 
 float Element::GetClientWidth()
 {
-	return GetBox().GetSize(BoxArea::Padding).x - meta->scroll.GetScrollbarSize(ElementScroll::VERTICAL);
+	return GetBox().GetSize(BoxArea::Padding).x - GetScrollbarSize(*meta, ElementScroll::VERTICAL);
 }
 
 float Element::GetClientHeight()
 {
-	return GetBox().GetSize(BoxArea::Padding).y - meta->scroll.GetScrollbarSize(ElementScroll::HORIZONTAL);
+	return GetBox().GetSize(BoxArea::Padding).y - GetScrollbarSize(*meta, ElementScroll::HORIZONTAL);
 }
 
 Element* Element::GetOffsetParent()
@@ -990,7 +1106,8 @@ void Element::SetScrollLeft(float scroll_left)
 	if (new_offset != scroll_offset.x)
 	{
 		scroll_offset.x = new_offset;
-		meta->scroll.UpdateScrollbar(ElementScroll::HORIZONTAL);
+		if (meta->scroll)
+			meta->scroll->UpdateScrollbar(ElementScroll::HORIZONTAL);
 		DirtyAbsoluteOffset();
 
 		DispatchEvent(EventId::Scroll, Dictionary());
@@ -1008,7 +1125,8 @@ void Element::SetScrollTop(float scroll_top)
 	if (new_offset != scroll_offset.y)
 	{
 		scroll_offset.y = new_offset;
-		meta->scroll.UpdateScrollbar(ElementScroll::VERTICAL);
+		if (meta->scroll)
+			meta->scroll->UpdateScrollbar(ElementScroll::VERTICAL);
 		DirtyAbsoluteOffset();
 
 		DispatchEvent(EventId::Scroll, Dictionary());
@@ -1649,7 +1767,14 @@ ElementBackgroundBorder* Element::GetElementBackgroundBorder() const
 
 ElementScroll* Element::GetElementScroll() const
 {
-	return &meta->scroll;
+	if (!meta->scroll)
+		meta->scroll = MakeUnique<ElementScroll>(const_cast<Element*>(this));
+	return meta->scroll.get();
+}
+
+ElementScroll* Element::GetElementScrollIfCreated() const
+{
+	return meta->scroll.get();
 }
 
 DataModel* Element::GetDataModel() const
@@ -1712,7 +1837,10 @@ void Element::OnAttributeChange(const ElementAttributes& changed_attributes)
 		{
 			static constexpr bool IN_CAPTURE_PHASE = false;
 
-			auto& attribute_event_listeners = meta->attribute_event_listeners;
+			if (!meta->attribute_event_listeners)
+				meta->attribute_event_listeners = MakeUnique<SmallUnorderedMap<EventId, EventListener*>>();
+
+			auto& attribute_event_listeners = *meta->attribute_event_listeners;
 			auto& event_dispatcher = meta->event_dispatcher;
 			const auto event_id = EventSpecificationInterface::GetIdOrInsert(attribute.substr(2));
 			const auto remove_event_listener_if_exists = [&attribute_event_listeners, &event_dispatcher, event_id]() {
@@ -1913,15 +2041,22 @@ void Element::OnPropertyChange(const PropertyIdSet& changed_properties)
 	// Dirty the effects if they've changed.
 	if (border_radius_changed || filter_or_mask_changed || changed_properties.Contains(PropertyId::Decorator))
 	{
-		meta->effects.DirtyEffects();
+		// Effects are only allocated once the element makes use of any of them.
+		const ComputedValues& computed = meta->computed_values;
+		if (!meta->effects && (computed.has_decorator() || computed.has_mask_image() || computed.has_filter() || computed.has_backdrop_filter()))
+			meta->effects = MakeUnique<ElementEffects>(this);
+
+		if (meta->effects)
+			meta->effects->DirtyEffects();
 	}
 
 	// Dirty the effects data when their visual looks may have changed.
-	if (border_radius_changed ||                            //
-		changed_properties.Contains(PropertyId::Opacity) || //
-		changed_properties.Contains(PropertyId::ImageColor))
+	if (meta->effects &&
+		(border_radius_changed ||                            //
+			changed_properties.Contains(PropertyId::Opacity) || //
+			changed_properties.Contains(PropertyId::ImageColor)))
 	{
-		meta->effects.DirtyEffectsData();
+		meta->effects->DirtyEffectsData();
 	}
 
 	// Check for `perspective' and `perspective-origin' changes
@@ -2155,6 +2290,9 @@ void Element::SetParent(Element* _parent)
 
 	SetOwnerDocument(parent ? parent->GetOwnerDocument() : nullptr);
 
+	if (parent)
+		meta->event_dispatcher.PropagateSubtreeListeners();
+
 	if (!parent)
 	{
 		if (data_model)
@@ -2465,6 +2603,15 @@ void Element::DirtyDefinition(DirtyNodes dirty_nodes)
 			parent->dirty_child_definitions = true;
 		break;
 	}
+	DirtyStyleSubtree();
+}
+
+void Element::DirtyStyleSubtree()
+{
+	// Always mark the ancestors of a newly attached element, whose flag may have been set while it was detached.
+	dirty_style_subtree = true;
+	for (Element* ancestor = parent; ancestor && !ancestor->dirty_style_subtree; ancestor = ancestor->parent)
+		ancestor->dirty_style_subtree = true;
 }
 
 void Element::UpdateDefinition()
@@ -2500,7 +2647,7 @@ bool Element::Animate(const String& property_name, const Property& target_value,
 	{
 		result = it_animation->AddKey(duration, target_value, *this, tween, true);
 		if (!result)
-			animations.erase(it_animation);
+			EraseAnimations(it_animation, it_animation + 1);
 	}
 
 	return result;
@@ -2523,6 +2670,8 @@ bool Element::AddAnimationKey(const String& property_name, const Property& targe
 	if (!animation)
 		return false;
 
+	ReleaseScheduledAnimation(*animation);
+
 	bool result = animation->AddKey(animation->GetDuration() + duration, target_value, *this, tween, true);
 
 	return result;
@@ -2545,6 +2694,7 @@ ElementAnimationList::iterator Element::StartAnimation(PropertyId property_id, c
 			return it;
 		}
 
+		ReleaseScheduledAnimation(*it);
 		*it = ElementAnimation{};
 	}
 	else
@@ -2603,6 +2753,8 @@ bool Element::AddAnimationKeyTime(PropertyId property_id, const Property* target
 	if (!animation)
 		return false;
 
+	ReleaseScheduledAnimation(*animation);
+
 	bool result = animation->AddKey(time, *target_value, *this, tween, true);
 
 	return result;
@@ -2626,6 +2778,8 @@ bool Element::StartTransition(const Transition& transition, const Property& star
 	}
 	else
 	{
+		ReleaseScheduledAnimation(*it);
+
 		// Compress the duration based on the progress of the current animation
 		float f = it->GetInterpolationFactor();
 		f = 1.0f - (1.0f - f) * transition.reverse_adjustment_factor;
@@ -2686,7 +2840,7 @@ void Element::HandleTransitionProperty()
 		for (auto it = it_remove; it != animations.end(); ++it)
 			RemoveProperty(it->GetPropertyId());
 
-		animations.erase(it_remove, animations.end());
+		EraseAnimations(it_remove, animations.end());
 	}
 }
 
@@ -2717,7 +2871,7 @@ void Element::HandleAnimationProperty()
 				for (auto it = it_remove; it != animations.end(); ++it)
 					RemoveProperty(it->GetPropertyId());
 
-				animations.erase(it_remove, animations.end());
+				EraseAnimations(it_remove, animations.end());
 			}
 
 			// Start animations
@@ -2766,11 +2920,20 @@ void Element::AdvanceAnimations()
 	{
 		double time = Clock::GetElapsedTime();
 
+		Context* context = GetContext();
+		AnimationScheduler* scheduler = (context ? context->animation_scheduler.get() : nullptr);
+
 		for (auto& animation : animations)
 		{
+			if (animation.IsScheduled())
+				continue;
+
 			Property property = animation.UpdateAndGetProperty(time, *this);
 			if (property.unit != Unit::UNKNOWN)
 				SetProperty(animation.GetPropertyId(), property);
+
+			if (scheduler && AnimationScheduler::IsSchedulable(animation))
+				scheduler->AddTrack(this, animation);
 		}
 
 		// Move all completed animations to the end of the list
@@ -2804,6 +2967,26 @@ void Element::AdvanceAnimations()
 	}
 }
 
+void Element::ReleaseScheduledAnimation(ElementAnimation& animation)
+{
+	if (!animation.IsScheduled())
+		return;
+
+	// Scheduled animations are always released before the element is detached from its context.
+	Context* context = GetContext();
+	RMLUI_ASSERT(context && context->animation_scheduler);
+	if (context && context->animation_scheduler)
+		context->animation_scheduler->RemoveTrack(this, animation);
+}
+
+void Element::EraseAnimations(ElementAnimationList::iterator it_begin, ElementAnimationList::iterator it_end)
+{
+	for (auto it = it_begin; it != it_end; ++it)
+		ReleaseScheduledAnimation(*it);
+
+	animations.erase(it_begin, it_end);
+}
+
 void Element::DirtyTransformState(bool perspective_dirty, bool transform_dirty)
 {
 	dirty_perspective |= perspective_dirty;
@@ -2966,7 +3149,8 @@ void Element::UpdateTransformState()
 
 void Element::OnStyleSheetChangeRecursive()
 {
-	meta->effects.DirtyEffects();
+	if (meta->effects)
+		meta->effects->DirtyEffects();
 
 	OnStyleSheetChange();
 
@@ -2978,7 +3162,8 @@ void Element::OnStyleSheetChangeRecursive()
 
 void Element::OnDpRatioChangeRecursive()
 {
-	meta->effects.DirtyEffects();
+	if (meta->effects)
+		meta->effects->DirtyEffects();
 	GetStyle()->DirtyPropertiesWithUnits(Unit::DP_SCALABLE_LENGTH);
 
 	OnDpRatioChange();
@@ -3016,7 +3201,8 @@ void Element::ClampScrollOffset()
 	// At this point the scrollbars have been resolved, both in terms of size and visibility. Update their properties
 	// now so that any visibility changes in particular are reflected immediately on the next render. Otherwise we risk
 	// that the scrollbars renders a frame late, since changes to scrollbars can happen during layouting.
-	meta->scroll.UpdateProperties();
+	if (meta->scroll)
+		meta->scroll->UpdateProperties();
 }
 
 void Element::ClampScrollOffsetRecursive()
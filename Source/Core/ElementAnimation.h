@@ -35,6 +35,8 @@
 
 namespace Rml {
 
+class AnimationScheduler;
+
 struct AnimationKey {
 	AnimationKey(float time, const Property& property, Tween tween) : time(time), property(property), tween(tween) {}
 	float time;  // Local animation time (Zero means the time when the animation iteration starts)
@@ -66,6 +68,9 @@ private:
 	bool animation_complete = false;
 	ElementAnimationOrigin origin = ElementAnimationOrigin::User;
 
+	// Track of the context's animation scheduler currently driving this animation, or -1 if not scheduled.
+	int scheduler_track = -1;
+
 	bool InternalAddKey(float time, const Property& property, Element& element, Tween tween);
 
 	float GetInterpolationFactorAndKeys(int* out_key0, int* out_key1) const;
@@ -86,6 +91,9 @@ public:
 	bool IsInitalized() const { return !keys.empty(); }
 	float GetInterpolationFactor() const { return GetInterpolationFactorAndKeys(nullptr, nullptr); }
 	ElementAnimationOrigin GetOrigin() const { return origin; }
+	bool IsScheduled() const { return scheduler_track >= 0; }
+
+	friend class AnimationScheduler;
 };
 
 } // namespace Rml
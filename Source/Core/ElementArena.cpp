@@ -0,0 +1,154 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "ElementArena.h"
+#include "../../Include/RmlUi/Core/Context.h"
+#include "../../Include/RmlUi/Core/ElementText.h"
+#include "ElementMeta.h"
+#include "Pool.h"
+
+namespace Rml {
+
+// Objects per chunk, chosen to be large since the arena is usually filled by loading whole documents.
+static constexpr int ArenaChunkSize = 256;
+
+static thread_local ElementArena* active_arena = nullptr;
+
+ElementArena::ElementArena() :
+	pool_element(MakeUnique<Pool<Element>>(ArenaChunkSize, true)), pool_text(MakeUnique<Pool<ElementText>>(ArenaChunkSize, true)),
+	pool_meta(MakeUnique<Pool<ElementMeta>>(ArenaChunkSize, true))
+{}
+
+ElementArena::~ElementArena()
+{
+	RMLUI_ASSERT(num_allocated_objects == 0);
+}
+
+void ElementArena::Release()
+{
+	bool destroy = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		RMLUI_ASSERT(!released);
+		released = true;
+		destroy = (num_allocated_objects == 0);
+	}
+
+	if (destroy)
+		delete this;
+}
+
+Element* ElementArena::AllocateElement(const String& tag)
+{
+	OnAllocate();
+	return pool_element->AllocateAndConstruct(tag);
+}
+
+ElementText* ElementArena::AllocateText(const String& tag)
+{
+	OnAllocate();
+	return pool_text->AllocateAndConstruct(tag);
+}
+
+ElementMeta* ElementArena::AllocateMeta(Element* element)
+{
+	OnAllocate();
+	return pool_meta->AllocateAndConstruct(element);
+}
+
+void ElementArena::DeallocateElement(Element* element)
+{
+	pool_element->DestroyAndDeallocate(element);
+	OnDeallocate();
+}
+
+void ElementArena::DeallocateText(ElementText* element)
+{
+	pool_text->DestroyAndDeallocate(element);
+	OnDeallocate();
+}
+
+void ElementArena::DeallocateMeta(ElementMeta* meta)
+{
+	pool_meta->DestroyAndDeallocate(meta);
+	OnDeallocate();
+}
+
+int ElementArena::GetNumAllocatedObjects()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return num_allocated_objects;
+}
+
+ElementArena* ElementArena::GetActive()
+{
+	return active_arena;
+}
+
+ElementArena* ElementArena::FromContext(const Context* context)
+{
+	return context ? context->element_arena : nullptr;
+}
+
+ElementArena* ElementArena::FromElement(const Element* element)
+{
+	return element->arena;
+}
+
+void ElementArena::OnAllocate()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	RMLUI_ASSERT(!released);
+	num_allocated_objects += 1;
+}
+
+void ElementArena::OnDeallocate()
+{
+	bool destroy = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		RMLUI_ASSERT(num_allocated_objects > 0);
+		num_allocated_objects -= 1;
+		destroy = (released && num_allocated_objects == 0);
+	}
+
+	if (destroy)
+		delete this;
+}
+
+ElementArena::Scope::Scope(ElementArena* arena) : previous_arena(active_arena)
+{
+	active_arena = arena;
+}
+
+ElementArena::Scope::~Scope()
+{
+	active_arena = previous_arena;
+}
+
+} // namespace Rml
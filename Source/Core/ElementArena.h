@@ -0,0 +1,105 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_ELEMENTARENA_H
+#define RMLUI_CORE_ELEMENTARENA_H
+
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+#include <mutex>
+
+namespace Rml {
+
+class Context;
+class Element;
+class ElementText;
+struct ElementMeta;
+template <typename PoolType>
+class Pool;
+
+/**
+    Memory arena owned by a single context.
+
+    Elements created by the default instancers, and the meta data of all elements, are allocated from the arena of the context they are created
+    for. This way, the arena grows in large chunks, and elements of the same context are kept close together in memory. The arena is released
+    by its context, but it is only destroyed once all of its objects have been deallocated, since elements may outlive their context.
+ */
+
+class ElementArena : NonCopyMoveable {
+public:
+	ElementArena();
+
+	/// Releases the arena from its owner. The arena is destroyed immediately if empty, otherwise when its last object is deallocated.
+	void Release();
+
+	Element* AllocateElement(const String& tag);
+	ElementText* AllocateText(const String& tag);
+	ElementMeta* AllocateMeta(Element* element);
+
+	void DeallocateElement(Element* element);
+	void DeallocateText(ElementText* element);
+	void DeallocateMeta(ElementMeta* meta);
+
+	/// Returns the number of elements and meta data objects currently allocated from the arena.
+	int GetNumAllocatedObjects();
+
+	/// Returns the arena new elements should be allocated from on the calling thread, or nullptr to use the global pools.
+	static ElementArena* GetActive();
+
+	/// Returns the arena of the given context, or nullptr if the context does not use an arena.
+	static ElementArena* FromContext(const Context* context);
+	/// Returns the arena the given element was allocated from, or nullptr if it was allocated from the global pools.
+	static ElementArena* FromElement(const Element* element);
+
+	/// Sets the active arena on the calling thread for the lifetime of the scope.
+	class Scope : NonCopyMoveable {
+	public:
+		explicit Scope(ElementArena* arena);
+		~Scope();
+
+	private:
+		ElementArena* previous_arena;
+	};
+
+private:
+	~ElementArena();
+
+	void OnAllocate();
+	void OnDeallocate();
+
+	UniquePtr<Pool<Element>> pool_element;
+	UniquePtr<Pool<ElementText>> pool_text;
+	UniquePtr<Pool<ElementMeta>> pool_meta;
+
+	std::mutex mutex;
+	int num_allocated_objects = 0;
+	bool released = false;
+};
+
+} // namespace Rml
+#endif
@@ -31,7 +31,6 @@
 #include "../../Include/RmlUi/Core/ElementText.h"
 #include "../../Include/RmlUi/Core/Factory.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
-#include "../../Include/RmlUi/Core/StreamMemory.h"
 #include "../../Include/RmlUi/Core/StyleSheet.h"
 #include "../../Include/RmlUi/Core/StyleSheetContainer.h"
 #include "DocumentHeader.h"
@@ -224,19 +223,14 @@ void ElementDocument::ProcessHeader(const DocumentHeader* document_header)
 	{
 		if (rcss.is_inline)
 		{
-			auto inline_sheet = MakeShared<StyleSheetContainer>();
-			auto stream = MakeUnique<StreamMemory>((const byte*)rcss.content.c_str(), rcss.content.size());
-			stream->SetSourceURL(rcss.path);
-
-			if (inline_sheet->LoadStyleSheetContainer(stream.get(), rcss.line))
+			SharedPtr<const StyleSheetContainer> inline_sheet = StyleSheetFactory::GetInlineStyleSheetContainer(rcss.content, rcss.path, rcss.line);
+			if (inline_sheet)
 			{
 				if (new_style_sheet)
 					new_style_sheet->MergeStyleSheetContainer(*inline_sheet);
 				else
-					new_style_sheet = std::move(inline_sheet);
+					new_style_sheet = inline_sheet->CombineStyleSheetContainer(StyleSheetContainer());
 			}
-
-			stream.reset();
 		}
 		else
 		{
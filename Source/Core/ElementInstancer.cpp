@@ -29,6 +29,7 @@
 #include "../../Include/RmlUi/Core/ElementInstancer.h"
 #include "../../Include/RmlUi/Core/ElementText.h"
 #include "ControlledLifetimeResource.h"
+#include "ElementArena.h"
 #include "Pool.h"
 #include "XMLParseTools.h"
 
@@ -46,13 +47,20 @@ static ControlledLifetimeResource<ElementInstancerPools> element_instancer_pools
 
 ElementPtr ElementInstancerElement::InstanceElement(Element* /*parent*/, const String& tag, const XMLAttributes& /*attributes*/)
 {
-	Element* ptr = element_instancer_pools->pool_element.AllocateAndConstruct(tag);
+	Element* ptr = nullptr;
+	if (ElementArena* arena = ElementArena::GetActive())
+		ptr = arena->AllocateElement(tag);
+	else
+		ptr = element_instancer_pools->pool_element.AllocateAndConstruct(tag);
 	return ElementPtr(ptr);
 }
 
 void ElementInstancerElement::ReleaseElement(Element* element)
 {
-	element_instancer_pools->pool_element.DestroyAndDeallocate(element);
+	if (ElementArena* arena = ElementArena::FromElement(element))
+		arena->DeallocateElement(element);
+	else
+		element_instancer_pools->pool_element.DestroyAndDeallocate(element);
 }
 
 ElementInstancerElement::~ElementInstancerElement()
@@ -71,13 +79,20 @@ ElementInstancerElement::~ElementInstancerElement()
 
 ElementPtr ElementInstancerText::InstanceElement(Element* /*parent*/, const String& tag, const XMLAttributes& /*attributes*/)
 {
-	ElementText* ptr = element_instancer_pools->pool_text_default.AllocateAndConstruct(tag);
+	ElementText* ptr = nullptr;
+	if (ElementArena* arena = ElementArena::GetActive())
+		ptr = arena->AllocateText(tag);
+	else
+		ptr = element_instancer_pools->pool_text_default.AllocateAndConstruct(tag);
 	return ElementPtr(static_cast<Element*>(ptr));
 }
 
 void ElementInstancerText::ReleaseElement(Element* element)
 {
-	element_instancer_pools->pool_text_default.DestroyAndDeallocate(rmlui_static_cast<ElementText*>(element));
+	if (ElementArena* arena = ElementArena::FromElement(element))
+		arena->DeallocateText(rmlui_static_cast<ElementText*>(element));
+	else
+		element_instancer_pools->pool_text_default.DestroyAndDeallocate(rmlui_static_cast<ElementText*>(element));
 }
 
 void Detail::InitializeElementInstancerPools()
@@ -32,6 +32,7 @@
 #include "../../Include/RmlUi/Core/ComputedValues.h"
 #include "../../Include/RmlUi/Core/Element.h"
 #include "../../Include/RmlUi/Core/ElementScroll.h"
+#include "../../Include/RmlUi/Core/PropertyIdSet.h"
 #include "../../Include/RmlUi/Core/Traits.h"
 #include "../../Include/RmlUi/Core/Types.h"
 #include "ControlledLifetimeResource.h"
@@ -45,14 +46,18 @@ namespace Rml {
 
 // Meta objects for element collected in a single struct to reduce memory allocations
 struct ElementMeta {
-	explicit ElementMeta(Element* el) : event_dispatcher(el), style(el), background_border(), effects(el), scroll(el), computed_values(el) {}
-	SmallUnorderedMap<EventId, EventListener*> attribute_event_listeners;
+	explicit ElementMeta(Element* el) : event_dispatcher(el), style(el), background_border(), computed_values(el) {}
 	EventDispatcher event_dispatcher;
 	ElementStyle style;
 	ElementBackgroundBorder background_border;
-	ElementEffects effects;
-	ElementScroll scroll;
 	Style::ComputedValues computed_values;
+	// Properties changed while computing values, pending notification through Element::OnPropertyChange.
+	PropertyIdSet changed_properties;
+
+	// Rarely used objects are only allocated once needed, which keeps the footprint of most elements small.
+	UniquePtr<ElementEffects> effects;
+	UniquePtr<ElementScroll> scroll;
+	UniquePtr<SmallUnorderedMap<EventId, EventListener*>> attribute_event_listeners;
 };
 
 struct ElementMetaPool {
@@ -47,6 +47,7 @@
 #include "ElementDefinition.h"
 #include "PropertiesIterator.h"
 #include <algorithm>
+#include <mutex>
 
 namespace Rml {
 
@@ -441,6 +442,7 @@ float ElementStyle::ResolveRelativeLength(NumericValue value, RelativeTarget rel
 void ElementStyle::DirtyInheritedProperties()
 {
 	dirty_properties |= StyleSheetSpecification::GetRegisteredInheritedProperties();
+	element->DirtyStyleSubtree();
 }
 
 void ElementStyle::DirtyPropertiesWithUnits(Units units)
@@ -471,6 +473,11 @@ bool ElementStyle::AnyPropertiesDirty() const
 	return !dirty_properties.Empty();
 }
 
+bool ElementStyle::AnyInheritedPropertiesDirty() const
+{
+	return !(dirty_properties & StyleSheetSpecification::GetRegisteredInheritedProperties()).Empty();
+}
+
 PropertiesIterator ElementStyle::Iterate() const
 {
 	// Note: Value initialized iterators are only guaranteed to compare equal in C++14, and only for iterators
@@ -499,11 +506,15 @@ PropertiesIterator ElementStyle::Iterate() const
 void ElementStyle::DirtyProperty(PropertyId id)
 {
 	dirty_properties.Insert(id);
+	element->DirtyStyleSubtree();
 }
 
 void ElementStyle::DirtyProperties(const PropertyIdSet& properties)
 {
+	if (properties.Empty())
+		return;
 	dirty_properties |= properties;
+	element->DirtyStyleSubtree();
 }
 
 PropertyIdSet ElementStyle::ComputeValues(Style::ComputedValues& values, const Style::ComputedValues* parent_values,
@@ -911,6 +922,11 @@ PropertyIdSet ElementStyle::ComputeValues(Style::ComputedValues& values, const S
 	if (dirty_font_face_handle)
 	{
 		RMLUI_ZoneScopedN("FontFaceHandle");
+
+		// Values may be computed concurrently during parallel style updates, serialize access to the font engine.
+		static std::mutex font_engine_mutex;
+		std::lock_guard<std::mutex> lock(font_engine_mutex);
+
 		values.font_face_handle(
 			GetFontEngineInterface()->GetFontFaceHandle(values.font_family(), values.font_style(), values.font_weight(), (int)values.font_size()));
 	}
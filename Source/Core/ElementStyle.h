@@ -133,6 +133,8 @@ public:
 
 	/// Returns true if any properties are dirty such that computed values need to be recomputed
 	bool AnyPropertiesDirty() const;
+	/// Returns true if any inherited properties are dirty, such that the values of our children will also need to be recomputed.
+	bool AnyInheritedPropertiesDirty() const;
 
 	/// Turns the local and inherited properties into computed values for this element. These values can in turn be used during the layout procedure.
 	/// Must be called in correct order, always parent before its children.
@@ -359,8 +359,11 @@ bool ElementUtilities::PositionElement(Element* element, Vector2f offset, Positi
 
 	const Box& parent_box = parent->GetBox();
 	Vector2f containing_block = parent_box.GetSize();
-	containing_block.x -= parent->GetElementScroll()->GetScrollbarSize(ElementScroll::VERTICAL);
-	containing_block.y -= parent->GetElementScroll()->GetScrollbarSize(ElementScroll::HORIZONTAL);
+	if (ElementScroll* parent_scroll = parent->GetElementScrollIfCreated())
+	{
+		containing_block.x -= parent_scroll->GetScrollbarSize(ElementScroll::VERTICAL);
+		containing_block.y -= parent_scroll->GetScrollbarSize(ElementScroll::HORIZONTAL);
+	}
 
 	Box box;
 	LayoutDetails::BuildBox(box, containing_block, element);
@@ -90,6 +90,8 @@ private:
 	int size = 20;
 
 	UniquePtr<WidgetTextInput> widget;
+
+	friend class TestWidgetTextInput;
 };
 
 } // namespace Rml
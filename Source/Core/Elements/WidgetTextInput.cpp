@@ -202,6 +202,7 @@ WidgetTextInput::WidgetTextInput(ElementFormControl* _parent)
 	parent->AddEventListener(EventId::Mousedown, this, true);
 	parent->AddEventListener(EventId::Dblclick, this, true);
 	parent->AddEventListener(EventId::Drag, this, true);
+	parent->AddEventListener(EventId::Scroll, this, true);
 
 	ElementPtr unique_text = Factory::InstanceElement(parent, "#text", "#text", XMLAttributes());
 	text_element = rmlui_dynamic_cast<ElementText*>(unique_text.get());
@@ -257,6 +258,7 @@ WidgetTextInput::~WidgetTextInput()
 	parent->RemoveEventListener(EventId::Mousedown, this, true);
 	parent->RemoveEventListener(EventId::Dblclick, this, true);
 	parent->RemoveEventListener(EventId::Drag, this, true);
+	parent->RemoveEventListener(EventId::Scroll, this, true);
 
 	// This widget might be parented by an input element, which may now be constructing a completely different type.
 	// Thus, remove all properties set by this widget so they don't affect the new type.
@@ -280,6 +282,8 @@ void WidgetTextInput::SetValue(String value)
 
 	if (initial_size != value.size())
 	{
+		// Any pending edit was made to the value before it was sanitized, let the changed range be found by comparing the values instead.
+		pending_value_edit = {};
 		parent->SetAttribute("value", value);
 		DispatchChangeEvent();
 	}
@@ -287,6 +291,10 @@ void WidgetTextInput::SetValue(String value)
 	{
 		TransformValue(value);
 
+		if (value != GetValue())
+			RecordValueChange(value);
+		pending_value_edit = {};
+
 		text_element->SetText(value);
 
 		// Reset the IME composition range when the value changes.
@@ -524,6 +532,14 @@ void WidgetTextInput::DispatchChangeEvent(bool linebreak)
 
 void WidgetTextInput::ProcessEvent(Event& event)
 {
+	if (event == EventId::Scroll)
+	{
+		// Submit the lines for rendering again when scrolling outside the currently rendered lines.
+		if (event.GetTargetElement() == parent && !IsVisibleTextRendered())
+			FormatText();
+		return;
+	}
+
 	if (parent->IsDisabled())
 		return;
 
@@ -752,8 +768,10 @@ bool WidgetTextInput::AddCharacters(String string)
 	value.insert(std::min<size_t>((size_t)attribute_insert_index, value.size()), string);
 
 	const int new_cursor_attribute_index = AttributeIndexToDisplayIndex(attribute_insert_index + (int)string.size(), value);
+	pending_value_edit = {absolute_cursor_index, 0, new_cursor_attribute_index - absolute_cursor_index};
 	absolute_cursor_index = new_cursor_attribute_index;
 	parent->SetAttribute("value", value);
+	pending_value_edit = {};
 
 	if (UpdateSelection(false))
 		FormatText();
@@ -1012,34 +1030,31 @@ String WidgetTextInput::GetAttributeValue() const
 
 void WidgetTextInput::GetRelativeCursorIndices(int& out_cursor_line_index, int& out_cursor_character_index) const
 {
-	int line_begin = 0;
+	// Find the first line where the absolute index is located on its editable part, otherwise we wrap down to the next line. We may have additional
+	// characters after the editable length, such as the newline character '\n'. We also wrap down if the cursor is located to the right of any such
+	// characters.
+	auto it_line = std::lower_bound(lines.begin(), lines.end(), absolute_cursor_index,
+		[](const Line& line, int cursor_index) { return line.value_offset + line.editable_length < cursor_index; });
 
-	for (size_t i = 0; i < lines.size(); i++)
+	if (it_line != lines.end())
 	{
-		const int cursor_relative_line_end = absolute_cursor_index - (line_begin + lines[i].editable_length);
+		const size_t i = size_t(it_line - lines.begin());
+		const int line_begin = it_line->value_offset;
+		const int cursor_relative_line_end = absolute_cursor_index - (line_begin + it_line->editable_length);
+		const bool soft_wrapped_line = (it_line->editable_length == it_line->size);
 
-		// Test if the absolute index is located on the editable part of this line, otherwise we wrap down to the next line. We may have additional
-		// characters after the editable length, such as the newline character '\n'. We also wrap down if the cursor is located to the right of any
-		// such characters.
-		if (cursor_relative_line_end <= 0)
+		// If we are located exactly on a soft break (due to word wrapping) then the cursor wrap state determines whether or not we wrap down.
+		if (cursor_relative_line_end == 0 && soft_wrapped_line && cursor_wrap_down && i + 1 < lines.size())
 		{
-			const bool soft_wrapped_line = (lines[i].editable_length == lines[i].size);
-
-			// If we are located exactly on a soft break (due to word wrapping) then the cursor wrap state determines whether or not we wrap down.
-			if (cursor_relative_line_end == 0 && soft_wrapped_line && cursor_wrap_down && (int)i + 1 < (int)lines.size())
-			{
-				out_cursor_line_index = (int)i + 1;
-				out_cursor_character_index = 0;
-			}
-			else
-			{
-				out_cursor_line_index = (int)i;
-				out_cursor_character_index = Math::Max(absolute_cursor_index - line_begin, 0);
-			}
-			return;
+			out_cursor_line_index = (int)i + 1;
+			out_cursor_character_index = 0;
 		}
-
-		line_begin += lines[i].size;
+		else
+		{
+			out_cursor_line_index = (int)i;
+			out_cursor_character_index = Math::Max(absolute_cursor_index - line_begin, 0);
+		}
+		return;
 	}
 
 	// We shouldn't ever get here; this means we actually couldn't find where the absolute cursor said it was. So we'll
@@ -1224,10 +1239,204 @@ void WidgetTextInput::FormatElement()
 	const Vector2f padding_size = parent->GetBox().GetFrameSize(BoxArea::Padding);
 	parent->SetScrollableOverflowRectangle(content_area + padding_size, true);
 	scroll->FormatScrollbars();
+
+	// The rendered lines were determined from the scroll offset before it was clamped to the new overflow rectangle. Clamping does not
+	// dispatch any scroll event, so check the rendered lines here in case the visible part of the text moved.
+	if (!IsVisibleTextRendered())
+		FormatText();
+}
+
+bool WidgetTextInput::IsVisibleTextRendered() const
+{
+	const float line_height = GetLineHeight();
+	if (lines.empty() || line_height <= 0.f)
+		return true;
+
+	const float scroll_top = parent->GetScrollTop();
+	const int visible_lines_begin = Math::Min(int(scroll_top / line_height), (int)lines.size());
+	const int visible_lines_end = Math::Min(int((scroll_top + GetAvailableHeight()) / line_height) + 1, (int)lines.size());
+	return visible_lines_begin >= rendered_lines_begin && visible_lines_end <= rendered_lines_end;
+}
+
+void WidgetTextInput::RecordValueChange(const String& new_value)
+{
+	const String& value = GetValue();
+
+	int offset, removed_length;
+	const ValueEdit& edit = pending_value_edit;
+	if (edit.offset >= 0 && edit.offset + edit.removed_length <= (int)value.size() &&
+		(int)value.size() - edit.removed_length + edit.inserted_length == (int)new_value.size())
+	{
+		offset = edit.offset;
+		removed_length = edit.removed_length;
+	}
+	else
+	{
+		// The value was set from the outside, find the changed range by comparing the values.
+		const size_t common_length = Math::Min(value.size(), new_value.size());
+		const size_t prefix_length = size_t(std::mismatch(value.begin(), value.begin() + common_length, new_value.begin()).first - value.begin());
+		const size_t suffix_length =
+			size_t(std::mismatch(value.rbegin(), value.rbegin() + (common_length - prefix_length), new_value.rbegin()).first - value.rbegin());
+		offset = (int)prefix_length;
+		removed_length = int(value.size() - prefix_length - suffix_length);
+	}
+
+	// Merge the change with any previous changes since the lines were formatted.
+	const int suffix_length = (int)value.size() - offset - removed_length;
+	unchanged_prefix_length = (value_changed ? Math::Min(unchanged_prefix_length, offset) : offset);
+	unchanged_suffix_length = (value_changed ? Math::Min(unchanged_suffix_length, suffix_length) : suffix_length);
+	value_changed = true;
+}
+
+bool WidgetTextInput::GenerateLine(FormattedLine& formatted_line, int line_begin, float maximum_line_width)
+{
+	Line& line = formatted_line.line;
+	String& line_content = formatted_line.content;
+
+	line = {};
+	line.value_offset = line_begin;
+
+	bool last_line =
+		text_element->GenerateLine(line_content, line.size, formatted_line.width, line_begin, maximum_line_width, 0, false, false, false);
+
+	// Check if the editable length needs to be truncated to dodge a trailing endline.
+	line.editable_length = (int)line_content.size();
+	if (!line_content.empty() && line_content.back() == '\n')
+		line.editable_length -= 1;
+
+	// Include all spaces at the end of this line, if they were not included due to soft-wrapping in `GenerateLine`.
+	// This helps prevent sudden shifts when whitespace wraps down to the next line.
+	const String& text = GetValue();
+	size_t i_space_begin = size_t(line_begin + line.editable_length);
+	size_t i_space_end = Math::Min(text.find_first_not_of(' ', i_space_begin), text.size());
+	size_t count = i_space_end - i_space_begin;
+	if (count > 0)
+	{
+		line_content.append(count, ' ');
+		formatted_line.width += ElementUtilities::GetStringWidth(text_element, " ") * (int)count;
+		line.editable_length += (int)count;
+		line.size += (int)count;
+		// Consume the hard wrap if we have one on this line, so that it doesn't make its own, empty line.
+		if (text[i_space_end] == '\n')
+			line.size += 1;
+		// If the spaces extend all the way to the end, we have consumed all the lines.
+		if (i_space_end == text.size())
+			last_line = true;
+	}
+
+	return last_line;
+}
+
+const Vector<WidgetTextInput::FormattedLine>& WidgetTextInput::BreakLines(float height_constraint)
+{
+	RMLUI_ZoneScoped;
+
+	const String& value = GetValue();
+	const FontFaceHandle font_handle = parent->GetFontFaceHandle();
+	const int font_version = GetFontEngineInterface()->GetVersion(font_handle);
+	const float maximum_line_width = GetAvailableWidth() - cursor_size.x;
+	const float line_height = GetLineHeight();
+
+	const bool reuse_formatted_lines = (formatted_lines_valid && formatted_maximum_line_width == maximum_line_width &&
+		formatted_font_handle == font_handle && formatted_font_version == font_version);
+
+	if (reuse_formatted_lines && !value_changed)
+		return formatted_lines;
+
+	// The range of the value that changed since the lines were last formatted, see 'RecordValueChange'.
+	const size_t prefix_length = size_t(unchanged_prefix_length);
+	const size_t suffix_length = size_t(unchanged_suffix_length);
+	size_t line_index_begin = 0;
+	if (reuse_formatted_lines)
+	{
+		// Line breaks within a paragraph may move in both directions when its text changes, thus start over from the paragraph containing the
+		// change. Line breaks in earlier paragraphs only depend on their own text.
+		const size_t paragraph_begin = (prefix_length == 0 ? 0 : value.rfind('\n', prefix_length - 1) + 1);
+		auto it_line = std::upper_bound(formatted_lines.begin(), formatted_lines.end(), (int)paragraph_begin,
+			[](int offset, const FormattedLine& formatted_line) { return offset < formatted_line.line.value_offset; });
+		line_index_begin = size_t(Math::Max(int(it_line - formatted_lines.begin()) - 1, 0));
+	}
+
+	// The lines which are no longer valid are replaced by newly generated lines, until we reach the unchanged suffix where the new line breaks
+	// coincide with the previous ones. From there on, the remaining lines are only shifted by the change in size.
+	const int size_change = int(value.size()) - formatted_value_size;
+	const int suffix_begin = int(value.size() - suffix_length);
+	size_t line_index_end = formatted_lines.size();
+
+	Vector<FormattedLine>& new_lines = (reuse_formatted_lines ? changed_lines : partial_lines);
+	new_lines.clear();
+
+	int line_begin = (line_index_begin < formatted_lines.size() && reuse_formatted_lines ? formatted_lines[line_index_begin].line.value_offset : 0);
+	bool last_line = false;
+	bool height_exceeded = false;
+
+	do
+	{
+		if (reuse_formatted_lines && line_begin >= suffix_begin)
+		{
+			auto it_line = std::lower_bound(formatted_lines.begin() + line_index_begin, formatted_lines.end(), line_begin - size_change,
+				[](const FormattedLine& formatted_line, int offset) { return formatted_line.line.value_offset < offset; });
+			if (it_line != formatted_lines.end() && it_line->line.value_offset == line_begin - size_change)
+			{
+				line_index_end = size_t(it_line - formatted_lines.begin());
+				break;
+			}
+		}
+
+		new_lines.emplace_back();
+		last_line = GenerateLine(new_lines.back(), line_begin, maximum_line_width);
+		line_begin += new_lines.back().line.size;
+
+		// The height constraint only applies when the lines are generated from scratch.
+		if (!reuse_formatted_lines)
+			height_exceeded = (float(new_lines.size()) * line_height > height_constraint + OVERFLOW_TOLERANCE);
+
+	} while (!last_line && !height_exceeded);
+
+	if (!reuse_formatted_lines)
+	{
+		// Lines which are generated in full can be reused by later formatting. If the formatting was aborted early, keep the previous lines instead.
+		if (height_exceeded && !last_line)
+			return partial_lines;
+
+		formatted_lines.swap(partial_lines);
+		partial_lines.clear();
+	}
+	else
+	{
+		if (last_line)
+			line_index_end = formatted_lines.size();
+
+		for (size_t i = line_index_end; i < formatted_lines.size(); i++)
+			formatted_lines[i].line.value_offset += size_change;
+
+		const size_t num_replaced_lines = line_index_end - line_index_begin;
+		const size_t num_common_lines = Math::Min(num_replaced_lines, changed_lines.size());
+		std::move(changed_lines.begin(), changed_lines.begin() + num_common_lines, formatted_lines.begin() + line_index_begin);
+
+		if (changed_lines.size() > num_replaced_lines)
+			formatted_lines.insert(formatted_lines.begin() + line_index_end, std::make_move_iterator(changed_lines.begin() + num_common_lines),
+				std::make_move_iterator(changed_lines.end()));
+		else
+			formatted_lines.erase(formatted_lines.begin() + line_index_begin + num_common_lines, formatted_lines.begin() + line_index_end);
+
+		changed_lines.clear();
+	}
+
+	formatted_lines_valid = true;
+	formatted_value_size = (int)value.size();
+	value_changed = false;
+	formatted_maximum_line_width = maximum_line_width;
+	formatted_font_handle = font_handle;
+	formatted_font_version = font_version;
+
+	return formatted_lines;
 }
 
 Vector2f WidgetTextInput::FormatText(float height_constraint)
 {
+	RMLUI_ZoneScoped;
+
 	Vector2f content_area(0, 0);
 
 	const FontFaceHandle font_handle = parent->GetFontFaceHandle();
@@ -1251,73 +1460,42 @@ Vector2f WidgetTextInput::FormatText(float height_constraint)
 	const int endline_font_width = int(0.4f * parent->GetComputedValues().font_size());
 
 	const float available_width = GetAvailableWidth();
-	int line_begin = 0;
-	Vector2f line_position = {0, top_to_baseline};
-	bool last_line = false;
 
 	float max_selection_right_edge = 0;
 
 	// Clear the selection background and IME composition geometry, and get the vertices and indices so the new geometry can be generated.
 	Mesh selection_composition_mesh = selection_composition_geometry.Release(Geometry::ReleaseMode::ClearMesh);
 
-	// Keep generating lines until all the text content is placed.
-	do
+	if (available_width <= 0.f)
 	{
-		if (available_width <= 0.f)
-		{
-			lines.push_back(Line{});
-			break;
-		}
-
-		Line line = {};
-		line.value_offset = line_begin;
-		float line_width;
-		String line_content;
-
-		// Generate the next line.
-		last_line =
-			text_element->GenerateLine(line_content, line.size, line_width, line_begin, available_width - cursor_size.x, 0, false, false, false);
-
-		// Check if the editable length needs to be truncated to dodge a trailing endline.
-		line.editable_length = (int)line_content.size();
-		if (!line_content.empty() && line_content.back() == '\n')
-			line.editable_length -= 1;
+		lines.push_back(Line{});
+		rendered_lines_begin = 0;
+		rendered_lines_end = 1;
+	}
+	else
+	{
+		const Vector<FormattedLine>& formatted = BreakLines(height_constraint);
 
-		// Include all spaces at the end of this line, if they were not included due to soft-wrapping in `GenerateLine`.
-		// This helps prevent sudden shifts when whitespace wraps down to the next line.
+		lines.reserve(formatted.size());
+		for (const FormattedLine& formatted_line : formatted)
 		{
-			const String& text = GetValue();
-			size_t i_space_begin = size_t(line_begin + line.editable_length);
-			size_t i_space_end = Math::Min(text.find_first_not_of(' ', i_space_begin), text.size());
-			size_t count = i_space_end - i_space_begin;
-			if (count > 0)
-			{
-				line_content.append(count, ' ');
-				line_width += ElementUtilities::GetStringWidth(text_element, " ") * (int)count;
-				line.editable_length += (int)count;
-				line.size += (int)count;
-				// Consume the hard wrap if we have one on this line, so that it doesn't make its own, empty line.
-				if (text[i_space_end] == '\n')
-					line.size += 1;
-				// If the spaces extend all the way to the end, we have consumed all the lines.
-				if (i_space_end == text.size())
-					last_line = true;
-			}
+			lines.push_back(formatted_line.line);
+			// Grow the content area width-wise if this line is the longest so far.
+			content_area.x = Math::Max(content_area.x, formatted_line.width + cursor_size.x);
 		}
-
-		// Now that we have the string of characters appearing on the new line, we split it into
-		// three parts; the unselected text appearing before any selected text on the line, the
-		// selected text on the line, and any unselected text after the selection.
-		StringView pre_selection, selection, post_selection;
-		GetLineSelection(pre_selection, selection, post_selection, line_content, line_begin);
-
-		// The pre-selected text is placed, if there is any (if the selection starts on or before
-		// the beginning of this line, then this will be empty).
-		if (!pre_selection.empty())
+		content_area.y = float(formatted.size()) * line_height;
+
+		// Only the lines in and around the visible part of the text field are submitted for rendering. Scrolling outside of these lines
+		// will submit them again, see 'ProcessEvent'.
+		rendered_lines_begin = 0;
+		rendered_lines_end = (int)formatted.size();
+		const float available_height = GetAvailableHeight();
+		if (available_height > 0.f)
 		{
-			const int width = ElementUtilities::GetStringWidth(text_element, pre_selection);
-			text_element->AddLine(line_position + Vector2f{GetAlignmentSpecificTextOffset(line), 0}, String(pre_selection));
-			line_position.x += width;
+			const float rendered_top = parent->GetScrollTop() - available_height;
+			const float rendered_bottom = parent->GetScrollTop() + 2.f * available_height;
+			rendered_lines_begin = Math::Clamp(int(rendered_top / line_height), 0, rendered_lines_end);
+			rendered_lines_end = Math::Clamp(int(rendered_bottom / line_height) + 1, rendered_lines_begin, rendered_lines_end);
 		}
 
 		// Return the extra kerning that would result in joining two strings.
@@ -1333,65 +1511,77 @@ Vector2f WidgetTextInput::FormatText(float height_constraint)
 			return float(width_kerning - width_no_kerning);
 		};
 
-		// If there is any selected text on this line, place it in the selected text element and
-		// generate the geometry for its background.
-		if (!selection.empty())
+		for (int line_index = rendered_lines_begin; line_index < rendered_lines_end; line_index++)
 		{
-			line_position.x += GetKerningBetween(pre_selection, selection);
-
-			const int selection_width = ElementUtilities::GetStringWidth(selected_text_element, selection);
-			const bool selection_contains_endline = (selection_begin_index + selection_length > line_begin + line.editable_length);
-			const Vector2f selection_size = {float(selection_width + (selection_contains_endline ? endline_font_width : 0)), line_height};
-			const Vector2f aligned_position = line_position + Vector2f{GetAlignmentSpecificTextOffset(line), 0};
-
-			MeshUtilities::GenerateQuad(selection_composition_mesh, aligned_position - Vector2f(0, top_to_baseline), selection_size,
-				selection_colour);
-			selected_text_element->AddLine(aligned_position, String(selection));
-
-			max_selection_right_edge = Math::Max(max_selection_right_edge, aligned_position.x + selection_size.x);
-			line_position.x += selection_width;
-		}
+			const Line& line = formatted[line_index].line;
+			const String& line_content = formatted[line_index].content;
+			const int line_begin = line.value_offset;
+			Vector2f line_position = {0, top_to_baseline + float(line_index) * line_height};
+
+			// Now that we have the string of characters appearing on the new line, we split it into
+			// three parts; the unselected text appearing before any selected text on the line, the
+			// selected text on the line, and any unselected text after the selection.
+			StringView pre_selection, selection, post_selection;
+			GetLineSelection(pre_selection, selection, post_selection, line_content, line_begin);
+
+			// The pre-selected text is placed, if there is any (if the selection starts on or before
+			// the beginning of this line, then this will be empty).
+			if (!pre_selection.empty())
+			{
+				text_element->AddLine(line_position + Vector2f{GetAlignmentSpecificTextOffset(line), 0}, String(pre_selection));
+				// The width is only needed to place any selected text following it.
+				if (!selection.empty() || !post_selection.empty())
+					line_position.x += ElementUtilities::GetStringWidth(text_element, pre_selection);
+			}
 
-		// If there is any unselected text after the selection on this line, place it in the
-		// standard text element after the selected text.
-		if (!post_selection.empty())
-		{
-			line_position.x += GetKerningBetween(selection, post_selection);
-			text_element->AddLine(line_position + Vector2f{GetAlignmentSpecificTextOffset(line), 0}, String(post_selection));
-		}
+			// If there is any selected text on this line, place it in the selected text element and
+			// generate the geometry for its background.
+			if (!selection.empty())
+			{
+				line_position.x += GetKerningBetween(pre_selection, selection);
 
-		// We fetch the IME composition on the new line to highlight it.
-		StringView ime_pre_composition, ime_composition;
-		GetLineIMEComposition(ime_pre_composition, ime_composition, line_content, line_begin);
+				const int selection_width = ElementUtilities::GetStringWidth(selected_text_element, selection);
+				const bool selection_contains_endline = (selection_begin_index + selection_length > line_begin + line.editable_length);
+				const Vector2f selection_size = {float(selection_width + (selection_contains_endline ? endline_font_width : 0)), line_height};
+				const Vector2f aligned_position = line_position + Vector2f{GetAlignmentSpecificTextOffset(line), 0};
 
-		// If there is any IME composition string on the line, create a segment for its underline.
-		if (!ime_composition.empty())
-		{
-			const bool composition_contains_endline = (ime_composition_end_index > line_begin + line.editable_length);
-			const int composition_width = ElementUtilities::GetStringWidth(text_element, ime_composition);
-			const Vector2f composition_position = {
-				float(ElementUtilities::GetStringWidth(text_element, ime_pre_composition)) + GetAlignmentSpecificTextOffset(line),
-				line_position.y - top_to_baseline + line_height - COMPOSITION_UNDERLINE_WIDTH,
-			};
-			Vector2f line_size = {float(composition_width + (composition_contains_endline ? endline_font_width : 0)), COMPOSITION_UNDERLINE_WIDTH};
-
-			MeshUtilities::GenerateLine(selection_composition_mesh, composition_position, line_size,
-				parent->GetComputedValues().color().ToPremultiplied());
-		}
+				MeshUtilities::GenerateQuad(selection_composition_mesh, aligned_position - Vector2f(0, top_to_baseline), selection_size,
+					selection_colour);
+				selected_text_element->AddLine(aligned_position, String(selection));
 
-		// Update variables for the next line.
-		line_begin += line.size;
-		line_position.x = 0;
-		line_position.y += line_height;
+				max_selection_right_edge = Math::Max(max_selection_right_edge, aligned_position.x + selection_size.x);
+				line_position.x += selection_width;
+			}
 
-		// Grow the content area width-wise if this line is the longest so far, and push the height out.
-		content_area.x = Math::Max(content_area.x, line_width + cursor_size.x);
-		content_area.y = line_position.y - top_to_baseline;
+			// If there is any unselected text after the selection on this line, place it in the
+			// standard text element after the selected text.
+			if (!post_selection.empty())
+			{
+				line_position.x += GetKerningBetween(selection, post_selection);
+				text_element->AddLine(line_position + Vector2f{GetAlignmentSpecificTextOffset(line), 0}, String(post_selection));
+			}
 
-		// Finally, push the new line into our array of lines.
-		lines.push_back(std::move(line));
+			// We fetch the IME composition on the new line to highlight it.
+			StringView ime_pre_composition, ime_composition;
+			GetLineIMEComposition(ime_pre_composition, ime_composition, line_content, line_begin);
 
-	} while (!last_line && content_area.y <= height_constraint + OVERFLOW_TOLERANCE);
+			// If there is any IME composition string on the line, create a segment for its underline.
+			if (!ime_composition.empty())
+			{
+				const bool composition_contains_endline = (ime_composition_end_index > line_begin + line.editable_length);
+				const int composition_width = ElementUtilities::GetStringWidth(text_element, ime_composition);
+				const Vector2f composition_position = {
+					float(ElementUtilities::GetStringWidth(text_element, ime_pre_composition)) + GetAlignmentSpecificTextOffset(line),
+					line_position.y - top_to_baseline + line_height - COMPOSITION_UNDERLINE_WIDTH,
+				};
+				Vector2f line_size = {float(composition_width + (composition_contains_endline ? endline_font_width : 0)),
+					COMPOSITION_UNDERLINE_WIDTH};
+
+				MeshUtilities::GenerateLine(selection_composition_mesh, composition_position, line_size,
+					parent->GetComputedValues().color().ToPremultiplied());
+			}
+		}
+	}
 
 	// Clamp the cursor to a valid range.
 	absolute_cursor_index = Math::Min(absolute_cursor_index, (int)GetValue().size());
@@ -1436,6 +1626,7 @@ void WidgetTextInput::GenerateCursor()
 void WidgetTextInput::ForceFormattingOnNextLayout()
 {
 	force_formatting_on_next_layout = true;
+	formatted_lines_valid = false;
 }
 
 void WidgetTextInput::UpdateCursorPosition(bool update_ideal_cursor_position)
@@ -1526,7 +1717,9 @@ void WidgetTextInput::DeleteSelection()
 		// Move the cursor to the beginning of the old selection.
 		absolute_cursor_index = selection_begin_index;
 
+		pending_value_edit = {selection_begin_index, selection_length, 0};
 		GetElement()->SetAttribute("value", new_value);
+		pending_value_edit = {};
 
 		// Erase our record of the selection.
 		if (UpdateSelection(false))
@@ -162,6 +162,14 @@ private:
 		int editable_length;
 	};
 
+	struct FormattedLine {
+		Line line;
+		// The text making up the line, including any trailing whitespace.
+		String content;
+		// The width of the line's content.
+		float width;
+	};
+
 	/// Returns the displayed value of the text field.
 	/// @note For password fields this would only return the displayed asterisks '****', while the attribute value below contains the underlying text.
 	const String& GetValue() const;
@@ -210,6 +218,22 @@ private:
 	/// @param[in] height_constraint Abort formatting when the formatted size grows larger than this height.
 	/// @return The content area of the element.
 	Vector2f FormatText(float height_constraint = FLT_MAX);
+	/// Returns true if all lines in the visible part of the text field at the current scroll offset have been submitted for rendering.
+	bool IsVisibleTextRendered() const;
+	/// Breaks the text field's value into lines. Lines from the previous formatting are reused up to the edited paragraph, and again once the new
+	/// line breaks coincide with the previous ones after the edit.
+	/// @param[in] height_constraint Abort line breaking when the lines grow larger than this height, only applies when all lines must be regenerated.
+	/// @return The formatted lines.
+	/// @lifetime The returned lines are valid until the next call to this function.
+	const Vector<FormattedLine>& BreakLines(float height_constraint);
+	/// Records the range of the displayed value that changes when it is replaced by the given value, for reuse of the formatted lines.
+	void RecordValueChange(const String& new_value);
+	/// Generates a single line starting at the given index into the value.
+	/// @param[out] formatted_line The generated line.
+	/// @param[in] line_begin The absolute index at the beginning of the line.
+	/// @param[in] maximum_line_width The width available for the line, before it is wrapped.
+	/// @return True if this is the last line of the value.
+	bool GenerateLine(FormattedLine& formatted_line, int line_begin, float maximum_line_width);
 
 	/// Updates the position to render the cursor.
 	/// @param[in] update_ideal_cursor_position Generally should be true on horizontal movement and false on vertical movement.
@@ -263,6 +287,34 @@ private:
 	using LineList = Vector<Line>;
 	LineList lines;
 
+	// The lines from the last complete formatting, along with the parameters they were formatted with.
+	Vector<FormattedLine> formatted_lines;
+	int formatted_value_size = 0;
+	float formatted_maximum_line_width = 0;
+	FontFaceHandle formatted_font_handle = 0;
+	int formatted_font_version = 0;
+	bool formatted_lines_valid = false;
+	// The range of the value changed since the lines were formatted, given by the length of its unchanged prefix and suffix.
+	bool value_changed = false;
+	int unchanged_prefix_length = 0;
+	int unchanged_suffix_length = 0;
+
+	// An edit of the displayed value made by the widget itself, so that the changed range is known without comparing the values.
+	struct ValueEdit {
+		int offset = -1;
+		int removed_length = 0;
+		int inserted_length = 0;
+	};
+	ValueEdit pending_value_edit;
+
+	// Scratch space for lines being formatted: Lines replacing part of the formatted lines, or lines from an aborted formatting.
+	Vector<FormattedLine> changed_lines;
+	Vector<FormattedLine> partial_lines;
+
+	// The range of lines submitted to the text elements for rendering, only lines near the visible region are rendered.
+	int rendered_lines_begin = 0;
+	int rendered_lines_end = 0;
+
 	// Length in number of characters.
 	int max_length;
 
@@ -313,6 +365,8 @@ private:
 	Vector2f cursor_position;
 	Vector2f cursor_size;
 	Geometry cursor_geometry;
+
+	friend class TestWidgetTextInput;
 };
 
 } // namespace Rml
@@ -39,6 +39,10 @@ WidgetTextInputMultiLine::~WidgetTextInputMultiLine() {}
 
 void WidgetTextInputMultiLine::SanitizeValue(String& value)
 {
+	// Values are sanitized on every edit, thus avoid rewriting large values in the common case where there is nothing to remove.
+	if (value.find('\r') == String::npos && value.find('\t') == String::npos)
+		return;
+
 	value.erase(std::remove_if(value.begin(), value.end(), [](char c) { return c == '\r' || c == '\t'; }), value.end());
 }
 
@@ -34,9 +34,28 @@ namespace Rml {
 
 Event::Event() {}
 
-Event::Event(Element* _target_element, EventId id, const String& type, const Dictionary& _parameters, bool interruptible) :
-	parameters(_parameters), target_element(_target_element), type(type), id(id), interruptible(interruptible)
+Event::Event(Element* _target_element, EventId id, const String& type, const Dictionary& _parameters, bool interruptible)
 {
+	Reset(_target_element, id, type, _parameters, interruptible);
+}
+
+Event::~Event() {}
+
+void Event::Reset(Element* _target_element, EventId _id, const String& _type, const Dictionary& _parameters, bool _interruptible)
+{
+	// Assign to the existing members so that their allocated capacity is reused.
+	parameters = _parameters;
+	target_element = _target_element;
+	current_element = nullptr;
+	type = _type;
+	id = _id;
+	interruptible = _interruptible;
+	interrupted = false;
+	interrupted_immediate = false;
+	has_mouse_position = false;
+	mouse_screen_position = Vector2f(0, 0);
+	phase = EventPhase::None;
+
 	const Variant* mouse_x = GetIf(parameters, "mouse_x");
 	const Variant* mouse_y = GetIf(parameters, "mouse_y");
 	if (mouse_x && mouse_y)
@@ -47,8 +66,6 @@ Event::Event(Element* _target_element, EventId id, const String& type, const Dic
 	}
 }
 
-Event::~Event() {}
-
 void Event::SetCurrentElement(Element* element)
 {
 	current_element = element;
@@ -75,6 +75,18 @@ void EventDispatcher::AttachEvent(const EventId id, EventListener* listener, con
 	if (matching_entry_it == range.second)
 	{
 		listeners.emplace(range.second, entry);
+		listener_ids.Insert(id);
+
+		// Add the id to the subtree summary of this element and its ancestors. Since each summary includes the summaries of its children, we
+		// can stop at the first element that already contains the id.
+		for (Element* walk_element = element; walk_element; walk_element = walk_element->GetParentNode())
+		{
+			EventIdMask& subtree_ids = walk_element->GetEventDispatcher()->subtree_listener_ids;
+			if (subtree_ids.Contains(id))
+				break;
+			subtree_ids.Insert(id);
+		}
+
 		listener->OnAttach(element);
 	}
 }
@@ -85,6 +97,7 @@ void EventDispatcher::DetachEvent(const EventId id, EventListener* listener, con
 	if (listenerIt != listeners.cend())
 	{
 		listeners.erase(listenerIt);
+		UpdateListenerIds();
 		listener->OnDetach(element);
 	}
 }
@@ -95,11 +108,30 @@ void EventDispatcher::DetachAllEvents()
 		event.listener->OnDetach(element);
 
 	listeners.clear();
+	listener_ids.Clear();
 
 	for (int i = 0; i < element->GetNumChildren(true); ++i)
 		element->GetChild(i)->GetEventDispatcher()->DetachAllEvents();
 }
 
+void EventDispatcher::PropagateSubtreeListeners()
+{
+	for (Element* ancestor = element->GetParentNode(); ancestor; ancestor = ancestor->GetParentNode())
+	{
+		EventIdMask& ancestor_ids = ancestor->GetEventDispatcher()->subtree_listener_ids;
+		if (ancestor_ids.Contains(subtree_listener_ids))
+			break;
+		ancestor_ids.Insert(subtree_listener_ids);
+	}
+}
+
+void EventDispatcher::UpdateListenerIds()
+{
+	listener_ids.Clear();
+	for (const EventListenerEntry& entry : listeners)
+		listener_ids.Insert(entry.id);
+}
+
 /*
     CollectedListener
 
@@ -126,14 +158,80 @@ struct CollectedListener {
 	bool operator<(const CollectedListener& other) const { return sort < other.sort; }
 };
 
+/*
+    DispatchBuffers
+
+    Scratch buffers used while dispatching an event, reused between dispatches to avoid allocations. Listeners may dispatch events recursively,
+    thus each nested dispatch acquires its own set of buffers.
+*/
+struct DispatchBuffers {
+	Vector<CollectedListener> listeners;
+	Vector<ObserverPtr<Element>> default_action_elements;
+};
+
+static thread_local Vector<UniquePtr<DispatchBuffers>> free_dispatch_buffers;
+
+class ScopedDispatchBuffers : NonCopyMoveable {
+public:
+	ScopedDispatchBuffers()
+	{
+		if (free_dispatch_buffers.empty())
+		{
+			buffers = MakeUnique<DispatchBuffers>();
+		}
+		else
+		{
+			buffers = std::move(free_dispatch_buffers.back());
+			free_dispatch_buffers.pop_back();
+		}
+	}
+	~ScopedDispatchBuffers()
+	{
+		buffers->listeners.clear();
+		buffers->default_action_elements.clear();
+		free_dispatch_buffers.push_back(std::move(buffers));
+	}
+
+	DispatchBuffers* operator->() { return buffers.get(); }
+
+private:
+	UniquePtr<DispatchBuffers> buffers;
+};
+
+// Stable, in-place sort. Used instead of std::stable_sort which allocates a temporary buffer. The listeners are collected from the target
+// outwards, so only the capture phase listeners are out of order, of which there are usually few.
+static void SortListeners(Vector<CollectedListener>& listeners)
+{
+	for (auto it = listeners.begin(); it != listeners.end(); ++it)
+	{
+		const auto insert_it = std::upper_bound(listeners.begin(), it, *it);
+		std::rotate(insert_it, it, it + 1);
+	}
+}
+
 bool EventDispatcher::DispatchEvent(Element* target_element, const EventId id, const String& type, const Dictionary& parameters,
 	const bool interruptible, const bool bubbles, const DefaultActionPhase default_action_phase)
 {
 	RMLUI_ASSERTMSG(!((int)default_action_phase & (int)EventPhase::Capture),
 		"We assume here that the default action phases cannot include capture phase.");
 
-	Vector<CollectedListener> listeners;
-	Vector<ObserverPtr<Element>> default_action_elements;
+	// Find the closest element on the path to the root which has listeners for this event in its subtree. Elements before this one cannot
+	// have any listeners for the event themselves. If there is no such element, then nobody listens to this event on the path.
+	int first_listener_distance = 0;
+	Element* first_listener_element = target_element;
+	while (first_listener_element && !first_listener_element->GetEventDispatcher()->subtree_listener_ids.Contains(id))
+	{
+		first_listener_element = first_listener_element->GetParentNode();
+		first_listener_distance += 1;
+	}
+
+	// Skip the event entirely when there is nobody to process it.
+	if (!first_listener_element && default_action_phase == DefaultActionPhase::None)
+		return true;
+
+	ScopedDispatchBuffers buffers;
+	Vector<CollectedListener>& listeners = buffers->listeners;
+	Vector<ObserverPtr<Element>>& default_action_elements = buffers->default_action_elements;
 
 	const EventPhase phases_to_execute = EventPhase((int)EventPhase::Capture | (int)EventPhase::Target | (bubbles ? (int)EventPhase::Bubble : 0));
 
@@ -143,7 +241,8 @@ bool EventDispatcher::DispatchEvent(Element* target_element, const EventId id, c
 	while (walk_element)
 	{
 		EventDispatcher* dispatcher = walk_element->GetEventDispatcher();
-		dispatcher->CollectListeners(dom_distance_from_target, id, phases_to_execute, listeners);
+		if (dom_distance_from_target >= first_listener_distance && dispatcher->listener_ids.Contains(id))
+			dispatcher->CollectListeners(dom_distance_from_target, id, phases_to_execute, listeners);
 
 		if (dom_distance_from_target == 0)
 		{
@@ -162,8 +261,8 @@ bool EventDispatcher::DispatchEvent(Element* target_element, const EventId id, c
 	if (listeners.empty() && default_action_elements.empty())
 		return true;
 
-	// Use stable_sort so that the order of the listeners in a given element is maintained.
-	std::stable_sort(listeners.begin(), listeners.end());
+	// Use a stable sort so that the order of the listeners in a given element is maintained.
+	SortListeners(listeners);
 
 	// Instance event
 	EventPtr event = Factory::InstanceEvent(target_element, id, type, parameters, interruptible);
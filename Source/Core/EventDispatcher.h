@@ -31,6 +31,7 @@
 
 #include "../../Include/RmlUi/Core/Event.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include <bitset>
 
 namespace Rml {
 
@@ -48,6 +49,23 @@ struct EventListenerEntry {
 	EventListener* listener;
 };
 
+/*
+    A conservative set of event ids, hashed into a fixed number of bits. May report false positives, but never false negatives.
+*/
+class EventIdMask {
+public:
+	void Insert(EventId id) { bits.set(ToIndex(id)); }
+	void Insert(const EventIdMask& other) { bits |= other.bits; }
+	bool Contains(EventId id) const { return bits.test(ToIndex(id)); }
+	bool Contains(const EventIdMask& other) const { return (bits & other.bits) == other.bits; }
+	void Clear() { bits.reset(); }
+
+private:
+	static constexpr size_t num_bits = 128;
+	static size_t ToIndex(EventId id) { return size_t(id) % num_bits; }
+	std::bitset<num_bits> bits;
+};
+
 /**
     The Event Dispatcher manages a list of event listeners and triggers the events via EventHandlers
     whenever requested.
@@ -91,6 +109,10 @@ public:
 	static bool DispatchEvent(Element* target_element, EventId id, const String& type, const Dictionary& parameters, bool interruptible, bool bubbles,
 		DefaultActionPhase default_action_phase);
 
+	/// Merges the listeners of this element's subtree into the summary of its ancestors. Must be called when the element is attached to a new
+	/// parent.
+	void PropagateSubtreeListeners();
+
 	/// Returns event types with number of listeners for debugging.
 	/// @return Summary of attached listeners.
 	String ToString() const;
@@ -103,6 +125,15 @@ private:
 	typedef Vector<EventListenerEntry> Listeners;
 	Listeners listeners;
 
+	// The ids of the listeners attached to this element.
+	EventIdMask listener_ids;
+	// Summary of the ids of the listeners attached to this element or any of its descendants. Ids are never removed, thus it may contain stale
+	// entries after listeners are detached or elements are removed, but it always includes the summary of each child.
+	EventIdMask subtree_listener_ids;
+
+	// Rebuilds the set of listener ids after listeners are removed.
+	void UpdateListenerIds();
+
 	// Collect all the listeners from this dispatcher that are allowed to execute given the input arguments.
 	void CollectListeners(int dom_distance_from_target, EventId event_id, EventPhase phases_to_execute, Vector<CollectedListener>& collect_listeners);
 };
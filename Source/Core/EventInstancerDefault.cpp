@@ -31,18 +31,39 @@
 
 namespace Rml {
 
+// Released events are kept for reuse, so that dispatching events does not allocate in the steady state. Events are always released on the
+// thread that instanced them, thus each thread keeps its own pool.
+static constexpr size_t max_pooled_events = 16;
+static thread_local Vector<UniquePtr<Event>> event_pool;
+
 EventInstancerDefault::EventInstancerDefault() {}
 
 EventInstancerDefault::~EventInstancerDefault() {}
 
 EventPtr EventInstancerDefault::InstanceEvent(Element* target, EventId id, const String& type, const Dictionary& parameters, bool interruptible)
 {
-	return EventPtr(new Event(target, id, type, parameters, interruptible));
+	if (event_pool.empty())
+		return EventPtr(new Event(target, id, type, parameters, interruptible));
+
+	UniquePtr<Event> event = std::move(event_pool.back());
+	event_pool.pop_back();
+	event->Reset(target, id, type, parameters, interruptible);
+	return EventPtr(event.release());
 }
 
 void EventInstancerDefault::ReleaseEvent(Event* event)
 {
-	delete event;
+	if (event_pool.size() >= max_pooled_events)
+	{
+		delete event;
+		return;
+	}
+
+	// Don't hold on to any parameters, while keeping their capacity.
+	event->parameters.clear();
+	event->target_element = nullptr;
+	event->current_element = nullptr;
+	event_pool.emplace_back(event);
 }
 
 void EventInstancerDefault::Release()
@@ -57,6 +57,7 @@
 #include "DecoratorTiledHorizontal.h"
 #include "DecoratorTiledImage.h"
 #include "DecoratorTiledVertical.h"
+#include "ElementArena.h"
 #include "ElementHandle.h"
 #include "Elements/ElementImage.h"
 #include "Elements/ElementLabel.h"
@@ -81,6 +82,7 @@
 #include "XMLNodeHandlerHead.h"
 #include "XMLNodeHandlerTemplate.h"
 #include "XMLParseTools.h"
+#include "XMLPrototype.h"
 #include <algorithm>
 
 namespace Rml {
@@ -180,6 +182,7 @@ Factory::~Factory() {}
 void Factory::Initialise()
 {
 	factory_data.Initialize();
+	XMLPrototype::Initialize();
 
 	DefaultInstancers& default_instancers = factory_data->default_instancers;
 
@@ -301,6 +304,7 @@ void Factory::Shutdown()
 
 	XMLParser::ReleaseHandlers();
 
+	XMLPrototype::Shutdown();
 	factory_data.Shutdown();
 }
 
@@ -339,6 +343,10 @@ ElementPtr Factory::InstanceElement(Element* parent, const String& instancer_nam
 {
 	if (ElementInstancer* instancer = GetElementInstancer(instancer_name))
 	{
+		// Allocate the element in the arena of the context it is created for, otherwise keep using the currently active arena.
+		Context* context = (parent ? parent->GetContext() : nullptr);
+		ElementArena::Scope arena_scope(context ? ElementArena::FromContext(context) : ElementArena::GetActive());
+
 		if (ElementPtr element = instancer->InstanceElement(parent, tag, attributes))
 		{
 			element->SetInstancer(instancer);
@@ -447,7 +455,7 @@ bool Factory::InstanceElementText(Element* parent, const String& in_text)
 bool Factory::InstanceElementStream(Element* parent, Stream* stream)
 {
 	XMLParser parser(parent);
-	parser.Parse(stream);
+	XMLPrototype::Parse(parser, stream, XMLPrototype::CacheMode::WhenRepeated);
 	return true;
 }
 
@@ -455,6 +463,8 @@ ElementPtr Factory::InstanceDocumentStream(Context* context, Stream* stream, con
 {
 	RMLUI_ZoneScoped;
 
+	ElementArena::Scope arena_scope(ElementArena::FromContext(context));
+
 	ElementPtr element = Factory::InstanceElement(nullptr, document_base_tag, document_base_tag, XMLAttributes());
 	if (!element)
 	{
@@ -473,7 +483,7 @@ ElementPtr Factory::InstanceDocumentStream(Context* context, Stream* stream, con
 	document->context = context;
 
 	XMLParser parser(element.get());
-	parser.Parse(stream);
+	XMLPrototype::Parse(parser, stream, XMLPrototype::CacheMode::Always);
 
 	return element;
 }
@@ -546,6 +556,23 @@ SharedPtr<StyleSheetContainer> Factory::InstanceStyleSheetStream(Stream* stream)
 	return nullptr;
 }
 
+bool Factory::CompileStyleSheetFile(const String& file_name, String& out_data)
+{
+	auto file_stream = MakeUnique<StreamFile>();
+	if (!file_stream->Open(file_name))
+		return false;
+
+	SharedPtr<StyleSheetContainer> style_sheet_container = InstanceStyleSheetStream(file_stream.get());
+	if (!style_sheet_container)
+		return false;
+	return style_sheet_container->SerializeStyleSheetContainer(out_data);
+}
+
+bool Factory::PreloadStyleSheets(Span<const String> file_names, int num_threads)
+{
+	return StyleSheetFactory::PreloadStyleSheetContainers(file_names, num_threads);
+}
+
 void Factory::ClearStyleSheetCache()
 {
 	StyleSheetFactory::ClearStyleSheetCache();
@@ -556,6 +583,11 @@ void Factory::ClearTemplateCache()
 	TemplateCache::Clear();
 }
 
+void Factory::ClearDocumentCache()
+{
+	XMLPrototype::ClearCache();
+}
+
 void Factory::RegisterEventInstancer(EventInstancer* instancer)
 {
 	event_instancer = instancer;
@@ -590,7 +622,11 @@ void Factory::RegisterDataViewInstancer(DataViewInstancer* instancer, const Stri
 	{
 		inserted = factory_data->structural_data_view_instancers.emplace(name, instancer).second;
 		if (inserted)
+		{
 			factory_data->structural_data_view_attribute_names.push_back(String("data-") + name);
+			// Previously parsed RML did not treat the contents of the new attribute as inner RML.
+			XMLPrototype::ClearCache();
+		}
 	}
 	else
 	{
@@ -30,9 +30,14 @@
 #include "../../../Include/RmlUi/Core/StringUtilities.h"
 #include "FontFaceHandleDefault.h"
 #include "FontProvider.h"
+#include <mutex>
 
 namespace Rml {
 
+// The font provider and the sized font faces are shared by all contexts. Glyphs are generated and the font atlases grown
+// lazily, thus every call is serialized so that independent contexts can be updated concurrently.
+static std::mutex font_engine_mutex;
+
 void FontEngineInterfaceDefault::Initialize()
 {
 	FontProvider::Initialise();
@@ -45,29 +50,34 @@ void FontEngineInterfaceDefault::Shutdown()
 
 bool FontEngineInterfaceDefault::LoadFontFace(const String& file_name, int face_index, bool fallback_face, Style::FontWeight weight)
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	return FontProvider::LoadFontFace(file_name, face_index, fallback_face, weight);
 }
 
 bool FontEngineInterfaceDefault::LoadFontFace(Span<const byte> data, int face_index, const String& font_family, Style::FontStyle style, Style::FontWeight weight,
 	bool fallback_face)
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	return FontProvider::LoadFontFace(data, face_index, font_family, style, weight, fallback_face);
 }
 
 FontFaceHandle FontEngineInterfaceDefault::GetFontFaceHandle(const String& family, Style::FontStyle style, Style::FontWeight weight, int size)
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	auto handle = FontProvider::GetFontFaceHandle(family, style, weight, size);
 	return reinterpret_cast<FontFaceHandle>(handle);
 }
 
 FontEffectsHandle FontEngineInterfaceDefault::PrepareFontEffects(FontFaceHandle handle, const FontEffectList& font_effects)
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	auto handle_default = reinterpret_cast<FontFaceHandleDefault*>(handle);
 	return (FontEffectsHandle)handle_default->GenerateLayerConfiguration(font_effects);
 }
 
 const FontMetrics& FontEngineInterfaceDefault::GetFontMetrics(FontFaceHandle handle)
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	auto handle_default = reinterpret_cast<FontFaceHandleDefault*>(handle);
 	return handle_default->GetFontMetrics();
 }
@@ -75,6 +85,7 @@ const FontMetrics& FontEngineInterfaceDefault::GetFontMetrics(FontFaceHandle han
 int FontEngineInterfaceDefault::GetStringWidth(FontFaceHandle handle, StringView string, const TextShapingContext& text_shaping_context,
 	Character prior_character)
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	auto handle_default = reinterpret_cast<FontFaceHandleDefault*>(handle);
 	return handle_default->GetStringWidth(string, text_shaping_context.letter_spacing, prior_character);
 }
@@ -83,6 +94,7 @@ int FontEngineInterfaceDefault::GenerateString(RenderManager& render_manager, Fo
 	StringView string, Vector2f position, ColourbPremultiplied colour, float opacity, const TextShapingContext& text_shaping_context,
 	TexturedMeshList& mesh_list)
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	auto handle_default = reinterpret_cast<FontFaceHandleDefault*>(handle);
 	return handle_default->GenerateString(render_manager, mesh_list, string, position, colour, opacity, text_shaping_context.letter_spacing,
 		(int)font_effects_handle);
@@ -90,12 +102,14 @@ int FontEngineInterfaceDefault::GenerateString(RenderManager& render_manager, Fo
 
 int FontEngineInterfaceDefault::GetVersion(FontFaceHandle handle)
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	auto handle_default = reinterpret_cast<FontFaceHandleDefault*>(handle);
 	return handle_default->GetVersion();
 }
 
 void FontEngineInterfaceDefault::ReleaseFontResources()
 {
+	std::lock_guard<std::mutex> lock(font_engine_mutex);
 	FontProvider::ReleaseFontResources();
 }
 
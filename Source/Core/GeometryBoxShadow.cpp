@@ -29,71 +29,56 @@
 #include "GeometryBoxShadow.h"
 #include "../../Include/RmlUi/Core/Box.h"
 #include "../../Include/RmlUi/Core/CompiledFilterShader.h"
+#include "../../Include/RmlUi/Core/Context.h"
 #include "../../Include/RmlUi/Core/DecorationTypes.h"
 #include "../../Include/RmlUi/Core/Element.h"
 #include "../../Include/RmlUi/Core/Geometry.h"
 #include "../../Include/RmlUi/Core/Math.h"
 #include "../../Include/RmlUi/Core/MeshUtilities.h"
 #include "../../Include/RmlUi/Core/RenderManager.h"
+#include "BoxShadowCache.h"
+#include "RenderManagerAccess.h"
 
 namespace Rml {
 
-void GeometryBoxShadow::Generate(Geometry& out_shadow_geometry, CallbackTexture& out_shadow_texture, RenderManager& render_manager, Element* element,
-	Geometry& background_border_geometry, BoxShadowList shadow_list, const CornerSizes border_radius, const float opacity)
+// Returns the distance from the edges of the border box, beyond which the contents of the box-shadow texture are uniform.
+static float GetNineSliceMargin(const BoxShadowTextureKey& key)
 {
-	// Find the box-shadow texture dimension and offset required to cover all box-shadows and element boxes combined.
-	Vector2f element_offset_in_texture;
-	Vector2i texture_dimensions;
+	float max_radius = 0.f;
+	for (float radius : key.border_radius)
+		max_radius = Math::Max(max_radius, radius);
 
-	// Resolve all lengths to px units.
-	for (BoxShadow& shadow : shadow_list)
-	{
-		shadow.blur_radius = NumericValue(element->ResolveLength(shadow.blur_radius), Unit::PX);
-		shadow.spread_distance = NumericValue(element->ResolveLength(shadow.spread_distance), Unit::PX);
-		shadow.offset_x = NumericValue(element->ResolveLength(shadow.offset_x), Unit::PX);
-		shadow.offset_y = NumericValue(element->ResolveLength(shadow.offset_y), Unit::PX);
-	}
+	float max_border_width = 0.f;
+	for (float width : key.padding_boxes[0].GetBorderWidths())
+		max_border_width = Math::Max(max_border_width, width);
 
+	// Spread also increases the radius of the shadow corners, thus it is counted twice.
+	float max_shadow_extent = 0.f;
+	for (const BoxShadow& shadow : key.shadow_list)
 	{
-		Vector2f extend_min;
-		Vector2f extend_max;
-
-		// Extend the render-texture to encompass box-shadow blur and spread.
-		for (const BoxShadow& shadow : shadow_list)
-		{
-			if (!shadow.inset)
-			{
-				const float extend = 1.5f * shadow.blur_radius.number + shadow.spread_distance.number;
-				const Vector2f offset = {shadow.offset_x.number, shadow.offset_y.number};
-				extend_min = Math::Min(extend_min, offset - Vector2f(extend));
-				extend_max = Math::Max(extend_max, offset + Vector2f(extend));
-			}
-		}
-
-		Rectanglef texture_region;
-
-		// Extend the render-texture further to cover all the element's boxes.
-		for (int i = 0; i < element->GetNumBoxes(); i++)
-		{
-			const RenderBox box = element->GetRenderBox(BoxArea::Border, i);
-			texture_region = texture_region.Join(Rectanglef::FromPositionSize(box.GetBorderOffset(), box.GetFillSize()));
-		}
-
-		texture_region = texture_region.Extend(-extend_min, extend_max);
-		Math::ExpandToPixelGrid(texture_region);
-
-		element_offset_in_texture = -texture_region.TopLeft();
-		texture_dimensions = Vector2i(texture_region.Size());
+		const float offset = Math::Max(Math::Absolute(shadow.offset_x.number), Math::Absolute(shadow.offset_y.number));
+		const float extent = offset + 2.f * Math::Absolute(shadow.spread_distance.number) + 1.5f * shadow.blur_radius.number;
+		max_shadow_extent = Math::Max(max_shadow_extent, extent);
 	}
 
-	// Callback for generating the box-shadow texture. Using a callback ensures that the texture can be regenerated at any time, for example if the
-	// device loses its GPU context and the client calls Rml::ReleaseTextures().
-	auto texture_callback = [&background_border_geometry, element, border_radius, texture_dimensions, element_offset_in_texture,
-								shadow_list = std::move(shadow_list)](const CallbackTextureInterface& texture_interface) -> bool {
+	// Add some slack for the filtering of blurred shadows.
+	constexpr float slack = 2.f;
+	return Math::RoundUp(max_radius + max_border_width + max_shadow_extent + slack);
+}
+
+// Returns the function to render the box-shadow texture, only depending on the resolved parameters so that the texture can be shared.
+static CallbackTextureFunction MakeTextureCallback(BoxShadowTextureKey key, Vector2i texture_dimensions, Vector2f element_offset_in_texture)
+{
+	// Using a callback ensures that the texture can be regenerated at any time, for example if the device loses its GPU context and the client calls
+	// Rml::ReleaseTextures().
+	return [key = std::move(key), texture_dimensions, element_offset_in_texture](const CallbackTextureInterface& texture_interface) -> bool {
 		RenderManager& render_manager = texture_interface.GetRenderManager();
+		const BoxShadowList& shadow_list = key.shadow_list;
+		const int num_boxes = (int)key.padding_boxes.size();
 
-		Mesh mesh_padding;        // Render geometry for inner box-shadow.
-		Mesh mesh_padding_border; // Clipping mask for outer box-shadow.
+		Mesh mesh_background_border; // Render geometry for the element's background and border.
+		Mesh mesh_padding;           // Render geometry for inner box-shadow.
+		Mesh mesh_padding_border;    // Clipping mask for outer box-shadow.
 
 		bool has_inner_shadow = false;
 		bool has_outer_shadow = false;
@@ -105,14 +90,15 @@ void GeometryBoxShadow::Generate(Geometry& out_shadow_geometry, CallbackTexture&
 				has_outer_shadow = true;
 		}
 
-		// Generate the geometry for all the element's boxes and extend the render-texture further to cover all of them.
-		for (int i = 0; i < element->GetNumBoxes(); i++)
+		// Generate the geometry for all the element's boxes.
+		for (int i = 0; i < num_boxes; i++)
 		{
 			ColourbPremultiplied white(255);
+			MeshUtilities::GenerateBackgroundBorder(mesh_background_border, key.padding_boxes[i], key.background_color, key.border_colors.data());
 			if (has_inner_shadow)
-				MeshUtilities::GenerateBackground(mesh_padding, element->GetRenderBox(BoxArea::Padding, i), white);
+				MeshUtilities::GenerateBackground(mesh_padding, key.padding_boxes[i], white);
 			if (has_outer_shadow)
-				MeshUtilities::GenerateBackground(mesh_padding_border, element->GetRenderBox(BoxArea::Border, i), white);
+				MeshUtilities::GenerateBackground(mesh_padding_border, key.border_boxes[i], white);
 		}
 
 		const RenderState initial_render_state = render_manager.GetState();
@@ -132,13 +118,14 @@ void GeometryBoxShadow::Generate(Geometry& out_shadow_geometry, CallbackTexture&
 		{
 			Log::Message(Log::LT_INFO,
 				"The desired box-shadow texture dimensions (%d, %d) are larger than the current window region (%d, %d). "
-				"Results may be clipped. In element: %s",
-				texture_dimensions.x, texture_dimensions.y, scissor_region.Width(), scissor_region.Height(), element->GetAddress().c_str());
+				"Results may be clipped.",
+				texture_dimensions.x, texture_dimensions.y, scissor_region.Width(), scissor_region.Height());
 		}
 
 		render_manager.PushLayer();
 
-		background_border_geometry.Render(element_offset_in_texture);
+		Geometry geometry_background_border = render_manager.MakeGeometry(std::move(mesh_background_border));
+		geometry_background_border.Render(element_offset_in_texture);
 
 		for (int shadow_index = (int)shadow_list.size() - 1; shadow_index >= 0; shadow_index--)
 		{
@@ -148,7 +135,7 @@ void GeometryBoxShadow::Generate(Geometry& out_shadow_geometry, CallbackTexture&
 			const float spread_distance = shadow.spread_distance.number;
 			const float blur_radius = shadow.blur_radius.number;
 
-			CornerSizes spread_radii = border_radius;
+			CornerSizes spread_radii = key.border_radius;
 			for (int i = 0; i < 4; i++)
 			{
 				float& radius = spread_radii[i];
@@ -164,10 +151,10 @@ void GeometryBoxShadow::Generate(Geometry& out_shadow_geometry, CallbackTexture&
 			Mesh mesh_shadow;
 
 			// Generate the shadow geometry. For outer box-shadows it is rendered normally, while for inset box-shadows it is used as a clipping mask.
-			for (int i = 0; i < element->GetNumBoxes(); i++)
+			for (int i = 0; i < num_boxes; i++)
 			{
 				const float signed_spread_distance = (inset ? -spread_distance : spread_distance);
-				RenderBox render_box = element->GetRenderBox(inset ? BoxArea::Padding : BoxArea::Border, i);
+				RenderBox render_box = (inset ? key.padding_boxes[i] : key.border_boxes[i]);
 				render_box.SetFillSize(Math::Max(render_box.GetFillSize() + Vector2f(2.f * signed_spread_distance), Vector2f{0.001f}));
 				render_box.SetBorderRadius(spread_radii);
 				render_box.SetBorderOffset(render_box.GetBorderOffset() - Vector2f(signed_spread_distance));
@@ -222,12 +209,133 @@ void GeometryBoxShadow::Generate(Geometry& out_shadow_geometry, CallbackTexture&
 
 		return true;
 	};
+}
+
+void GeometryBoxShadow::Generate(Geometry& out_shadow_geometry, SharedPtr<CallbackTexture>& out_shadow_texture, RenderManager& render_manager,
+	Element* element, ColourbPremultiplied background_color, const ColourbPremultiplied border_colors[4], BoxShadowList shadow_list,
+	const CornerSizes border_radius, const float opacity)
+{
+	// Resolve all lengths to px units.
+	for (BoxShadow& shadow : shadow_list)
+	{
+		shadow.blur_radius = NumericValue(element->ResolveLength(shadow.blur_radius), Unit::PX);
+		shadow.spread_distance = NumericValue(element->ResolveLength(shadow.spread_distance), Unit::PX);
+		shadow.offset_x = NumericValue(element->ResolveLength(shadow.offset_x), Unit::PX);
+		shadow.offset_y = NumericValue(element->ResolveLength(shadow.offset_y), Unit::PX);
+	}
+
+	BoxShadowTextureKey key;
+	const int num_boxes = element->GetNumBoxes();
+	key.padding_boxes.reserve(num_boxes);
+	key.border_boxes.reserve(num_boxes);
+	for (int i = 0; i < num_boxes; i++)
+	{
+		key.padding_boxes.push_back(element->GetRenderBox(BoxArea::Padding, i));
+		key.border_boxes.push_back(element->GetRenderBox(BoxArea::Border, i));
+	}
+	key.background_color = background_color;
+	for (int i = 0; i < 4; i++)
+		key.border_colors[i] = border_colors[i];
+	key.shadow_list = std::move(shadow_list);
+	key.border_radius = border_radius;
+
+	// With nine-slicing, the texture is generated for a smaller box, whose uniform center is later stretched to cover the size of the element.
+	// Only whole pixels are removed, so that the box edges keep their alignment with the pixel grid.
+	Vector2f slice_stretch;
+	Vector2f slice_center;
+	Context* context = element->GetContext();
+	if (context && context->IsBoxShadowNineSliceEnabled() && num_boxes == 1)
+	{
+		const float margin = GetNineSliceMargin(key);
+		const Vector2f size = key.border_boxes[0].GetFillSize();
+		slice_stretch.x = Math::Max(Math::RoundDown(size.x - 2.f * margin - 2.f), 0.f);
+		slice_stretch.y = Math::Max(Math::RoundDown(size.y - 2.f * margin - 2.f), 0.f);
+
+		key.padding_boxes[0].SetFillSize(key.padding_boxes[0].GetFillSize() - slice_stretch);
+		key.border_boxes[0].SetFillSize(key.border_boxes[0].GetFillSize() - slice_stretch);
+
+		// Split the texture along a line in the uniform center of the box, which is then stretched to cover the removed size.
+		slice_center = key.border_boxes[0].GetBorderOffset() + (0.5f * key.border_boxes[0].GetFillSize()).Round();
+	}
+
+	// Find the box-shadow texture dimension and offset required to cover all box-shadows and element boxes combined.
+	Vector2f element_offset_in_texture;
+	Vector2i texture_dimensions;
+	{
+		Vector2f extend_min;
+		Vector2f extend_max;
+
+		// Extend the render-texture to encompass box-shadow blur and spread.
+		for (const BoxShadow& shadow : key.shadow_list)
+		{
+			if (!shadow.inset)
+			{
+				const float extend = 1.5f * shadow.blur_radius.number + shadow.spread_distance.number;
+				const Vector2f offset = {shadow.offset_x.number, shadow.offset_y.number};
+				extend_min = Math::Min(extend_min, offset - Vector2f(extend));
+				extend_max = Math::Max(extend_max, offset + Vector2f(extend));
+			}
+		}
+
+		Rectanglef texture_region;
+
+		// Extend the render-texture further to cover all the element's boxes.
+		for (const RenderBox& box : key.border_boxes)
+			texture_region = texture_region.Join(Rectanglef::FromPositionSize(box.GetBorderOffset(), box.GetFillSize()));
+
+		texture_region = texture_region.Extend(-extend_min, extend_max);
+		Math::ExpandToPixelGrid(texture_region);
+
+		element_offset_in_texture = -texture_region.TopLeft();
+		texture_dimensions = Vector2i(texture_region.Size());
+	}
+
+	// Share the texture with any other elements using an identical box-shadow.
+	BoxShadowCache& cache = RenderManagerAccess::GetBoxShadowCache(&render_manager);
+	SharedPtr<CallbackTexture> shadow_texture = cache.Find(key);
+	if (!shadow_texture)
+	{
+		CallbackTextureFunction texture_callback = MakeTextureCallback(key, texture_dimensions, element_offset_in_texture);
+		shadow_texture = cache.Insert(std::move(key), render_manager, std::move(texture_callback));
+	}
 
 	Mesh mesh = out_shadow_geometry.Release(Geometry::ReleaseMode::ClearMesh);
 	const byte alpha = byte(opacity * 255.f);
-	MeshUtilities::GenerateQuad(mesh, -element_offset_in_texture, Vector2f(texture_dimensions), ColourbPremultiplied(alpha, alpha));
+	const ColourbPremultiplied color(alpha, alpha);
+	const Vector2f texture_size = Vector2f(texture_dimensions);
+
+	if (slice_stretch == Vector2f(0.f))
+	{
+		MeshUtilities::GenerateQuad(mesh, -element_offset_in_texture, texture_size, color);
+	}
+	else
+	{
+		const Vector2f center = element_offset_in_texture + slice_center;
+		const float positions[2][4] = {
+			{0.f, center.x, center.x + slice_stretch.x, texture_size.x + slice_stretch.x},
+			{0.f, center.y, center.y + slice_stretch.y, texture_size.y + slice_stretch.y},
+		};
+		const float tex_coords[2][4] = {
+			{0.f, center.x / texture_size.x, center.x / texture_size.x, 1.f},
+			{0.f, center.y / texture_size.y, center.y / texture_size.y, 1.f},
+		};
+
+		for (int y = 0; y < 3; y++)
+		{
+			for (int x = 0; x < 3; x++)
+			{
+				const Vector2f origin = Vector2f(positions[0][x], positions[1][y]);
+				const Vector2f size = Vector2f(positions[0][x + 1], positions[1][y + 1]) - origin;
+				if (size.x <= 0.f || size.y <= 0.f)
+					continue;
+
+				MeshUtilities::GenerateQuad(mesh, origin - element_offset_in_texture, size, color, Vector2f(tex_coords[0][x], tex_coords[1][y]),
+					Vector2f(tex_coords[0][x + 1], tex_coords[1][y + 1]));
+			}
+		}
+	}
 
-	out_shadow_texture = render_manager.MakeCallbackTexture(std::move(texture_callback));
+	out_shadow_texture = std::move(shadow_texture);
 	out_shadow_geometry = render_manager.MakeGeometry(std::move(mesh));
 }
 
@@ -42,16 +42,17 @@ class GeometryBoxShadow {
 public:
 	/// Generate the texture and geometry for a box shadow.
 	/// @param[out] out_shadow_geometry The target geometry.
-	/// @param[out] out_shadow_texture The target texture, assumes pointer stability during the lifetime of the shadow geometry.
+	/// @param[out] out_shadow_texture The target texture, shared with other elements having identical box-shadows, backgrounds, and borders.
 	/// @param[in] render_manager The render manager to generate the shadow for.
 	/// @param[in] element The element to generate the shadow for.
-	/// @param[in] background_border_geometry The geometry of the background and border, assumed to already have been generated. Assumes pointer
-	/// stability during the lifetime of the shadow geometry.
+	/// @param[in] background_color The background color of the element, rendered into the shadow texture.
+	/// @param[in] border_colors The border colors of the element, rendered into the shadow texture.
 	/// @param[in] shadow_list The list of box-shadows to generate.
 	/// @param[in] border_radius The border radius of the element.
 	/// @param[in] opacity The opacity of the element.
-	static void Generate(Geometry& out_shadow_geometry, CallbackTexture& out_shadow_texture, RenderManager& render_manager, Element* element,
-		Geometry& background_border_geometry, BoxShadowList shadow_list, CornerSizes border_radius, float opacity);
+	static void Generate(Geometry& out_shadow_geometry, SharedPtr<CallbackTexture>& out_shadow_texture, RenderManager& render_manager,
+		Element* element, ColourbPremultiplied background_color, const ColourbPremultiplied border_colors[4], BoxShadowList shadow_list,
+		CornerSizes border_radius, float opacity);
 };
 
 } // namespace Rml
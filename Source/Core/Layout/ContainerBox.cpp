@@ -42,6 +42,10 @@ namespace Rml {
 void ContainerBox::ResetScrollbars(const Box& box)
 {
 	RMLUI_ASSERT(element);
+	// Avoid instancing the scroll state for elements that have never been scrolled, as is the case for most elements.
+	if (overflow_x != Style::Overflow::Scroll && overflow_y != Style::Overflow::Scroll && !element->GetElementScrollIfCreated())
+		return;
+
 	if (overflow_x == Style::Overflow::Scroll)
 		element->GetElementScroll()->EnableScrollbar(ElementScroll::HORIZONTAL, box.GetSizeAcross(BoxDirection::Horizontal, BoxArea::Padding));
 	else
@@ -33,6 +33,7 @@
 #include "../../../Include/RmlUi/Core/Profiling.h"
 #include "../../../Include/RmlUi/Core/Types.h"
 #include "ContainerBox.h"
+#include "IntrinsicSizeCache.h"
 #include "LayoutDetails.h"
 #include <algorithm>
 #include <float.h>
@@ -45,7 +46,6 @@ UniquePtr<LayoutBox> FlexFormattingContext::Format(ContainerBox* parent_containe
 	RMLUI_ZoneScopedC(0xAFAF4F);
 	auto flex_container_box = MakeUnique<FlexContainer>(element, parent_container);
 
-	ElementScroll* element_scroll = element->GetElementScroll();
 	const ComputedValues& computed = element->GetComputedValues();
 
 	const Vector2f containing_block = LayoutDetails::GetContainingBlock(parent_container, element->GetPosition()).size;
@@ -76,9 +76,10 @@ UniquePtr<LayoutBox> FlexFormattingContext::Format(ContainerBox* parent_containe
 	for (int layout_iteration = 0; layout_iteration < 3; layout_iteration++)
 	{
 		// One or both scrollbars can be enabled between iterations.
+		ElementScroll* element_scroll = element->GetElementScrollIfCreated();
 		const Vector2f scrollbar_size = {
-			element_scroll->GetScrollbarSize(ElementScroll::VERTICAL),
-			element_scroll->GetScrollbarSize(ElementScroll::HORIZONTAL),
+			element_scroll ? element_scroll->GetScrollbarSize(ElementScroll::VERTICAL) : 0.f,
+			element_scroll ? element_scroll->GetScrollbarSize(ElementScroll::HORIZONTAL) : 0.f,
 		};
 
 		context.flex_available_content_size = Math::Max(box_content_size - scrollbar_size, Vector2f(0.f));
@@ -117,6 +118,12 @@ UniquePtr<LayoutBox> FlexFormattingContext::Format(ContainerBox* parent_containe
 
 Vector2f FlexFormattingContext::GetMaxContentSize(Element* element)
 {
+	// The max-content size does not depend on the surroundings of the element, thus it only needs to be measured once per layout pass.
+	IntrinsicSizeCache* intrinsic_size_cache = IntrinsicSizeCache::GetActive();
+	Vector2f max_content_size;
+	if (intrinsic_size_cache && intrinsic_size_cache->GetMaxContentSize(element, max_content_size))
+		return max_content_size;
+
 	// A large but finite number is used here, since layouting doesn't always work well with infinities.
 	const Vector2f infinity(10000.0f, 10000.0f);
 	RootBox root(infinity);
@@ -133,6 +140,10 @@ Vector2f FlexFormattingContext::GetMaxContentSize(Element* element)
 	Vector2f flex_resulting_content_size, content_overflow_size;
 	float flex_baseline = 0.f;
 	context.Format(flex_resulting_content_size, content_overflow_size, flex_baseline);
+
+	if (intrinsic_size_cache)
+		intrinsic_size_cache->SetMaxContentSize(element, flex_resulting_content_size);
+
 	return flex_resulting_content_size;
 }
 
@@ -99,7 +99,8 @@ float FloatedBoxSpace::DetermineClearPosition(float cursor, Style::Clear clear_p
 Vector2f FloatedBoxSpace::NextBoxPosition(const BlockContainer* parent, float& maximum_box_width, const float cursor, const Vector2f dimensions,
 	const bool nowrap, const Style::Float float_property) const
 {
-	const float parent_scrollbar_width = parent->GetElement()->GetElementScroll()->GetScrollbarSize(ElementScroll::VERTICAL);
+	ElementScroll* parent_scroll = parent->GetElement()->GetElementScrollIfCreated();
+	const float parent_scrollbar_width = (parent_scroll ? parent_scroll->GetScrollbarSize(ElementScroll::VERTICAL) : 0.f);
 	const float parent_edge_left = parent->GetPosition().x + parent->GetBox().GetPosition().x;
 	const float parent_edge_right = parent_edge_left + parent->GetBox().GetSize().x - parent_scrollbar_width;
 
@@ -0,0 +1,86 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "IntrinsicSizeCache.h"
+
+namespace Rml {
+
+static thread_local IntrinsicSizeCache* active_cache = nullptr;
+
+IntrinsicSizeCache::IntrinsicSizeCache() : previous_active(active_cache)
+{
+	active_cache = this;
+}
+
+IntrinsicSizeCache::~IntrinsicSizeCache()
+{
+	RMLUI_ASSERT(active_cache == this);
+	active_cache = previous_active;
+}
+
+IntrinsicSizeCache* IntrinsicSizeCache::GetActive()
+{
+	return active_cache;
+}
+
+bool IntrinsicSizeCache::GetShrinkToFitWidth(Element* element, Vector2f containing_block, float& out_width) const
+{
+	auto it = entries.find(element);
+	if (it == entries.end() || !it->second.has_shrink_to_fit_width || it->second.shrink_to_fit_containing_block != containing_block)
+		return false;
+
+	out_width = it->second.shrink_to_fit_width;
+	return true;
+}
+
+void IntrinsicSizeCache::SetShrinkToFitWidth(Element* element, Vector2f containing_block, float width)
+{
+	Entry& entry = entries[element];
+	entry.has_shrink_to_fit_width = true;
+	entry.shrink_to_fit_containing_block = containing_block;
+	entry.shrink_to_fit_width = width;
+}
+
+bool IntrinsicSizeCache::GetMaxContentSize(Element* element, Vector2f& out_size) const
+{
+	auto it = entries.find(element);
+	if (it == entries.end() || !it->second.has_max_content_size)
+		return false;
+
+	out_size = it->second.max_content_size;
+	return true;
+}
+
+void IntrinsicSizeCache::SetMaxContentSize(Element* element, Vector2f size)
+{
+	Entry& entry = entries[element];
+	entry.has_max_content_size = true;
+	entry.max_content_size = size;
+}
+
+} // namespace Rml
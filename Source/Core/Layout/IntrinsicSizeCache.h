@@ -0,0 +1,78 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_LAYOUT_INTRINSICSIZECACHE_H
+#define RMLUI_CORE_LAYOUT_INTRINSICSIZECACHE_H
+
+#include "../../../Include/RmlUi/Core/Traits.h"
+#include "../../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class Element;
+
+/**
+    Caches the intrinsic sizes of elements during a single layout pass.
+
+    Measuring the shrink-to-fit width or the max-content size of an element requires formatting its whole subtree, and the
+    result is discarded before the element is formatted for real. Nested shrink-to-fit boxes, such as floats, inline-blocks,
+    and flex items, may otherwise be measured repeatedly by each of their ancestors. The cache is created by the layout
+    engine for each layout pass, thus any change to the document that dirties its layout also invalidates the cache.
+ */
+class IntrinsicSizeCache : NonCopyMoveable {
+public:
+	/// Activates the cache on the current thread until it is destroyed.
+	IntrinsicSizeCache();
+	~IntrinsicSizeCache();
+
+	/// Returns the cache of the layout pass currently running on this thread, or nullptr if there is none.
+	static IntrinsicSizeCache* GetActive();
+
+	/// Retrieves the shrink-to-fit width of the element measured under the given containing block, if available.
+	bool GetShrinkToFitWidth(Element* element, Vector2f containing_block, float& out_width) const;
+	void SetShrinkToFitWidth(Element* element, Vector2f containing_block, float width);
+
+	/// Retrieves the max-content size of the given flex container, if available.
+	bool GetMaxContentSize(Element* element, Vector2f& out_size) const;
+	void SetMaxContentSize(Element* element, Vector2f size);
+
+private:
+	struct Entry {
+		bool has_shrink_to_fit_width = false;
+		bool has_max_content_size = false;
+		Vector2f shrink_to_fit_containing_block;
+		float shrink_to_fit_width = 0.f;
+		Vector2f max_content_size;
+	};
+
+	UnorderedMap<Element*, Entry> entries;
+	IntrinsicSizeCache* previous_active;
+};
+
+} // namespace Rml
+#endif
@@ -35,6 +35,7 @@
 #include "../../../Include/RmlUi/Core/Profiling.h"
 #include "ContainerBox.h"
 #include "FormattingContext.h"
+#include "IntrinsicSizeCache.h"
 #include "LayoutEngine.h"
 #include <float.h>
 
@@ -207,11 +208,13 @@ ContainingBlock LayoutDetails::GetContainingBlock(ContainerBox* parent_container
 		// make positioned boxes contribute to the scrollable area.
 		if (Element* element = container->GetElement())
 		{
-			ElementScroll* element_scroll = element->GetElementScroll();
-			if (containing_block.x >= 0.f)
-				containing_block.x = Math::Max(containing_block.x - element_scroll->GetScrollbarSize(ElementScroll::VERTICAL), 0.f);
-			if (containing_block.y >= 0.f)
-				containing_block.y = Math::Max(containing_block.y - element_scroll->GetScrollbarSize(ElementScroll::HORIZONTAL), 0.f);
+			if (ElementScroll* element_scroll = element->GetElementScrollIfCreated())
+			{
+				if (containing_block.x >= 0.f)
+					containing_block.x = Math::Max(containing_block.x - element_scroll->GetScrollbarSize(ElementScroll::VERTICAL), 0.f);
+				if (containing_block.y >= 0.f)
+					containing_block.y = Math::Max(containing_block.y - element_scroll->GetScrollbarSize(ElementScroll::HORIZONTAL), 0.f);
+			}
 		}
 	}
 
@@ -264,6 +267,27 @@ float LayoutDetails::GetShrinkToFitWidth(Element* element, Vector2f containing_b
 		return 0.f;
 	}
 
+	// The measurement below formats the whole subtree, reuse any previous result from the current layout pass.
+	IntrinsicSizeCache* intrinsic_size_cache = IntrinsicSizeCache::GetActive();
+	float shrink_to_fit_width = 0.f;
+	if (!intrinsic_size_cache || !intrinsic_size_cache->GetShrinkToFitWidth(element, containing_block, shrink_to_fit_width))
+	{
+		shrink_to_fit_width = MeasureMaxContentWidth(element, box, containing_block);
+		if (intrinsic_size_cache)
+			intrinsic_size_cache->SetShrinkToFitWidth(element, containing_block, shrink_to_fit_width);
+	}
+
+	if (containing_block.x >= 0)
+	{
+		const float available_width =
+			Math::Max(0.f, containing_block.x - box.GetSizeAcross(BoxDirection::Horizontal, BoxArea::Margin, BoxArea::Padding));
+		shrink_to_fit_width = Math::Min(shrink_to_fit_width, available_width);
+	}
+	return shrink_to_fit_width;
+}
+
+float LayoutDetails::MeasureMaxContentWidth(Element* element, Box box, Vector2f containing_block)
+{
 	// Use a large size for the box content width, so that it is practically unconstrained. This makes the formatting
 	// procedure act as if under a maximum content constraint. Children with percentage sizing values may be scaled
 	// based on this width (such as 'width' or 'margin'), if so, the layout is considered undefined like in CSS 2.
@@ -277,14 +301,7 @@ float LayoutDetails::GetShrinkToFitWidth(Element* element, Vector2f containing_b
 	RootBox root(Math::Max(containing_block, Vector2f(0.f)));
 	UniquePtr<LayoutBox> layout_box = FormattingContext::FormatIndependent(&root, element, &box, FormattingContextType::Block);
 
-	float shrink_to_fit_width = layout_box->GetShrinkToFitWidth();
-	if (containing_block.x >= 0)
-	{
-		const float available_width =
-			Math::Max(0.f, containing_block.x - box.GetSizeAcross(BoxDirection::Horizontal, BoxArea::Margin, BoxArea::Padding));
-		shrink_to_fit_width = Math::Min(shrink_to_fit_width, available_width);
-	}
-	return shrink_to_fit_width;
+	return layout_box->GetShrinkToFitWidth();
 }
 
 ComputedAxisSize LayoutDetails::BuildComputedHorizontalSize(const ComputedValues& computed)
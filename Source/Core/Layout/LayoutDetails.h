@@ -125,6 +125,10 @@ public:
 	}
 
 private:
+	/// Formats the element under a practically unconstrained width to measure its shrink-to-fit width.
+	/// @param[in] box The box of the element, with an auto content width.
+	static float MeasureMaxContentWidth(Element* element, Box box, Vector2f containing_block);
+
 	/// Calculates and returns the content size for replaced elements.
 	static Vector2f CalculateSizeForReplacedElement(Vector2f specified_content_size, Vector2f min_size, Vector2f max_size, Vector2f intrinsic_size,
 		float intrinsic_ratio);
@@ -32,6 +32,7 @@
 #include "../../../Include/RmlUi/Core/Profiling.h"
 #include "ContainerBox.h"
 #include "FormattingContext.h"
+#include "IntrinsicSizeCache.h"
 
 namespace Rml {
 
@@ -40,6 +41,7 @@ void LayoutEngine::FormatElement(Element* element, Vector2f containing_block)
 	RMLUI_ASSERT(element && containing_block.x >= 0 && containing_block.y >= 0);
 
 	RootBox root(containing_block);
+	IntrinsicSizeCache intrinsic_size_cache;
 
 	auto layout_box = FormattingContext::FormatIndependent(&root, element, nullptr, FormattingContextType::Block);
 	if (!layout_box)
@@ -39,6 +39,29 @@
 
 namespace Rml {
 
+// Returns true if the layout of the element or its descendants may depend on the height of their containing block, such as with percentage heights.
+// Then the cell containing the element may be formatted differently with an indefinite and a definite height, even if the cell height is the same.
+static bool DependsOnContainingBlockHeight(Element* element)
+{
+	const ComputedValues& computed = element->GetComputedValues();
+	if (computed.display() == Style::Display::None)
+		return false;
+
+	if (computed.height().type == Style::Height::Percentage || computed.min_height().type == Style::MinHeight::Percentage ||
+		computed.max_height().type == Style::MaxHeight::Percentage || computed.top().type == Style::Top::Percentage ||
+		computed.bottom().type == Style::Bottom::Percentage || computed.flex_basis().type == Style::FlexBasis::Percentage)
+		return true;
+
+	const int num_children = element->GetNumChildren();
+	for (int i = 0; i < num_children; i++)
+	{
+		if (DependsOnContainingBlockHeight(element->GetChild(i)))
+			return true;
+	}
+
+	return false;
+}
+
 UniquePtr<LayoutBox> TableFormattingContext::Format(ContainerBox* parent_container, Element* element_table, const Box* override_initial_box)
 {
 	auto table_wrapper_box = MakeUnique<TableWrapper>(element_table, parent_container);
@@ -120,18 +143,22 @@ void TableFormattingContext::FormatTable(Vector2f& table_content_size, Vector2f&
 	TrackBoxList rows;
 	// Defines the boxes for all cells in this table.
 	BoxList cells;
+	// Cells already formatted while determining row heights, which may be reused when formatting the cells.
+	LayoutBoxList cell_layouts;
 
 	DetermineColumnWidths(columns, table_content_size.x);
 
 	InitializeCellBoxes(cells, columns);
 
-	DetermineRowHeights(rows, cells, table_content_size.y);
+	cell_layouts.resize(cells.size());
+
+	DetermineRowHeights(rows, cells, cell_layouts, table_content_size.y);
 
 	FormatRows(rows, table_content_size.x);
 
 	FormatColumns(columns, table_content_size.y);
 
-	FormatCells(cells, table_overflow_size, rows, columns, table_baseline);
+	FormatCells(cells, cell_layouts, table_overflow_size, rows, columns, table_baseline);
 }
 
 void TableFormattingContext::DetermineColumnWidths(TrackBoxList& columns, float& table_content_width) const
@@ -221,7 +248,7 @@ void TableFormattingContext::InitializeCellBoxes(BoxList& cells, const TrackBoxL
 	}
 }
 
-void TableFormattingContext::DetermineRowHeights(TrackBoxList& rows, BoxList& cells, float& table_content_height) const
+void TableFormattingContext::DetermineRowHeights(TrackBoxList& rows, BoxList& cells, LayoutBoxList& cell_layouts, float& table_content_height) const
 {
 	/*
 	    The table height algorithm works similar to the table width algorithm. The major difference is that 'auto' row height
@@ -305,8 +332,11 @@ void TableFormattingContext::DetermineRowHeights(TrackBoxList& rows, BoxList& ce
 				// If both the row and the cell heights are 'auto', we need to format the cell to get its height.
 				if (box.GetSize().y < 0)
 				{
-					FormattingContext::FormatIndependent(table_wrapper_box, element_cell, &box, FormattingContextType::Block);
+					auto cell_box = FormattingContext::FormatIndependent(table_wrapper_box, element_cell, &box, FormattingContextType::Block);
 					box.SetContent(element_cell->GetBox().GetSize());
+
+					if (!DependsOnContainingBlockHeight(element_cell))
+						cell_layouts[cell_index] = std::move(cell_box);
 				}
 
 				// Find the height of the cell which applies only to this row.
@@ -402,8 +432,8 @@ void TableFormattingContext::FormatColumns(const TrackBoxList& columns, float ta
 	}
 }
 
-void TableFormattingContext::FormatCells(BoxList& cells, Vector2f& table_overflow_size, const TrackBoxList& rows, const TrackBoxList& columns,
-	float& table_baseline) const
+void TableFormattingContext::FormatCells(BoxList& cells, LayoutBoxList& cell_layouts, Vector2f& table_overflow_size, const TrackBoxList& rows,
+	const TrackBoxList& columns, float& table_baseline) const
 {
 	RMLUI_ASSERT(cells.size() == grid.cells.size());
 
@@ -441,7 +471,15 @@ void TableFormattingContext::FormatCells(BoxList& cells, Vector2f& table_overflo
 
 		const float available_height = cell_border_height - box.GetSizeAcross(BoxDirection::Vertical, BoxArea::Border);
 
-		if (available_height > 0)
+		UniquePtr<LayoutBox> cell_box;
+
+		if (available_height <= 0 && cell_layouts[cell_index])
+		{
+			// A cell formatted while determining the row heights already has its final box when it fills its row. Then we reuse its layout
+			// instead of formatting the cell again. Its layout is only kept when none of its content depends on the now definite cell height.
+			cell_box = std::move(cell_layouts[cell_index]);
+		}
+		else if (available_height > 0)
 		{
 			// Pad the cell for vertical alignment
 			float add_padding_top;
@@ -472,7 +510,8 @@ void TableFormattingContext::FormatCells(BoxList& cells, Vector2f& table_overflo
 		// @performance: We may have already formatted the element during the above procedures without the extra padding. In that case, we may
 		//   instead set the new box and offset all descending elements whose offset parent is the cell, to account for the new padding box.
 		//   That should be faster than formatting the element again, but there may be edge-cases not accounted for.
-		auto cell_box = FormattingContext::FormatIndependent(table_wrapper_box, element_cell, &box, FormattingContextType::Block);
+		if (!cell_box)
+			cell_box = FormattingContext::FormatIndependent(table_wrapper_box, element_cell, &box, FormattingContextType::Block);
 		Vector2f cell_visible_overflow_size = cell_box->GetVisibleOverflowSize();
 
 		// Set the position of the element within the table container
@@ -52,6 +52,7 @@ private:
 	TableFormattingContext() = default;
 
 	using BoxList = Vector<Box>;
+	using LayoutBoxList = Vector<UniquePtr<LayoutBox>>;
 
 	/// Format the table and its children.
 	/// @param[out] table_content_size The final size of the table which will be determined by the size of its columns, rows, and spacing.
@@ -66,8 +67,9 @@ private:
 	// Generate the initial boxes for all cells, content height may be indeterminate for now (-1).
 	void InitializeCellBoxes(BoxList& cells, const TrackBoxList& columns) const;
 
-	// Determines the row heights, and populates the rows.
-	void DetermineRowHeights(TrackBoxList& rows, BoxList& cells, float& table_content_height) const;
+	// Determines the row heights, and populates the rows. Cells formatted to find the row heights are kept in the cell layouts when their layout
+	// can be reused during cell formatting.
+	void DetermineRowHeights(TrackBoxList& rows, BoxList& cells, LayoutBoxList& cell_layouts, float& table_content_height) const;
 
 	// Format the table row and row group elements.
 	void FormatRows(const TrackBoxList& rows, float table_content_width) const;
@@ -76,8 +78,8 @@ private:
 	void FormatColumns(const TrackBoxList& columns, float table_content_height) const;
 
 	// Format the table cell elements.
-	void FormatCells(BoxList& cells, Vector2f& table_overflow_size, const TrackBoxList& rows, const TrackBoxList& columns,
-		float& table_baseline) const;
+	void FormatCells(BoxList& cells, LayoutBoxList& cell_layouts, Vector2f& table_overflow_size, const TrackBoxList& rows,
+		const TrackBoxList& columns, float& table_baseline) const;
 
 	Element* element_table = nullptr;
 	TableWrapper* table_wrapper_box = nullptr;
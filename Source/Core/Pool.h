@@ -33,6 +33,7 @@
 #include "../../Include/RmlUi/Core/Header.h"
 #include "../../Include/RmlUi/Core/Traits.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include <mutex>
 
 namespace Rml {
 
@@ -97,11 +98,13 @@ public:
 	void Initialise(int chunk_size, bool grow = false);
 
 	/// Returns the head of the linked list of allocated objects.
+	/// @note Iteration is not synchronized with allocations made on other threads.
 	inline Iterator Begin();
 
 	/// Attempts to allocate an object into a free slot in the memory pool and construct it using the given arguments.
 	/// If the process is successful, the newly constructed object is returned. Otherwise, if the process fails due to
 	/// no free objects being available, nullptr is returned.
+	/// @note Allocation and deallocation may be called concurrently, the objects are constructed and destroyed outside the lock.
 	template <typename... Args>
 	inline PoolType* AllocateAndConstruct(Args&&... args);
 
@@ -118,8 +121,10 @@ public:
 	inline int GetNumAllocatedObjects() const;
 
 private:
-	// Creates a new pool chunk and appends its nodes to the beginning of the free list.
+	// Creates a new pool chunk and appends its nodes to the beginning of the free list. Requires the lock to be held.
 	void CreateChunk();
+	// Moves the node from the allocated list to the free list. Requires the lock to be held.
+	void UnlinkAllocatedNode(PoolNode* node);
 
 	int chunk_size;
 	bool grow;
@@ -132,6 +137,9 @@ private:
 
 	int num_allocated_objects;
 
+	// Guards the linked lists and chunks, so that the shared pools can be used from concurrently updated contexts.
+	std::mutex mutex;
+
 #ifdef RMLUI_DEBUG
 	int max_num_allocated_objects = 0;
 #endif
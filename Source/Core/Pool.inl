@@ -94,52 +94,58 @@ template<typename PoolType>
 template<typename ...Args>
 inline PoolType* Pool<PoolType>::AllocateAndConstruct(Args&&... args)
 {
-	// We can't allocate a new object if the deallocated list is empty.
-	if (first_free_node == nullptr)
+	PoolNode* allocated_object = nullptr;
 	{
-		// Attempt to grow the pool first.
-		if (grow)
+		std::lock_guard<std::mutex> lock(mutex);
+
+		// We can't allocate a new object if the deallocated list is empty.
+		if (first_free_node == nullptr)
 		{
-			CreateChunk();
-			if (first_free_node == nullptr)
+			// Attempt to grow the pool first.
+			if (grow)
+			{
+				CreateChunk();
+				if (first_free_node == nullptr)
+					return nullptr;
+			}
+			else
 				return nullptr;
 		}
-		else
-			return nullptr;
-	}
 
-	// We're about to allocate an object.
-	++num_allocated_objects;
+		// We're about to allocate an object.
+		++num_allocated_objects;
 
 #ifdef RMLUI_DEBUG
-	if (num_allocated_objects > max_num_allocated_objects)
-		max_num_allocated_objects = num_allocated_objects;
+		if (num_allocated_objects > max_num_allocated_objects)
+			max_num_allocated_objects = num_allocated_objects;
 #endif
 
-	// This one!
-	PoolNode* allocated_object = first_free_node;
+		// This one!
+		allocated_object = first_free_node;
 
-	// Remove the newly allocated object from the list of deallocated objects.
-	first_free_node = first_free_node->next;
-	if (first_free_node != nullptr)
-		first_free_node->previous = nullptr;
+		// Remove the newly allocated object from the list of deallocated objects.
+		first_free_node = first_free_node->next;
+		if (first_free_node != nullptr)
+			first_free_node->previous = nullptr;
 
-	// Add the newly allocated object to the head of the list of allocated objects.
-	if (first_allocated_node != nullptr)
-	{
-		allocated_object->previous = nullptr;
-		allocated_object->next = first_allocated_node;
-		first_allocated_node->previous = allocated_object;
-	}
-	else
-	{
-		// This object is the only allocated object.
-		allocated_object->previous = nullptr;
-		allocated_object->next = nullptr;
-	}
+		// Add the newly allocated object to the head of the list of allocated objects.
+		if (first_allocated_node != nullptr)
+		{
+			allocated_object->previous = nullptr;
+			allocated_object->next = first_allocated_node;
+			first_allocated_node->previous = allocated_object;
+		}
+		else
+		{
+			// This object is the only allocated object.
+			allocated_object->previous = nullptr;
+			allocated_object->next = nullptr;
+		}
 
-	first_allocated_node = allocated_object;
+		first_allocated_node = allocated_object;
+	}
 
+	// Construct outside the lock, the constructor may itself allocate from this pool.
 	return new (allocated_object->object) PoolType(std::forward<Args>(args)...);
 }
 
@@ -147,41 +153,16 @@ inline PoolType* Pool<PoolType>::AllocateAndConstruct(Args&&... args)
 template < typename PoolType >
 void Pool< PoolType >::DestroyAndDeallocate(Iterator& iterator)
 {
-	// We're about to deallocate an object.
-	--num_allocated_objects;
-
 	PoolNode* object = iterator.node;
-	reinterpret_cast<PoolType*>(object->object)->~PoolType();
-
-	// Get the previous and next pointers now, because they will be overwritten
-	// before we're finished.
-	PoolNode* previous_object = object->previous;
-	PoolNode* next_object = object->next;
-
-	if (previous_object != nullptr)
-		previous_object->next = next_object;
-	else
-	{
-		RMLUI_ASSERT(first_allocated_node == object);
-		first_allocated_node = next_object;
-	}
 
-	if (next_object != nullptr)
-		next_object->previous = previous_object;
+	// Destroy outside the lock, the destructor may itself release other objects from this pool.
+	reinterpret_cast<PoolType*>(object->object)->~PoolType();
 
-	// Insert the freed node at the beginning of the free object list.
-	if (first_free_node == nullptr)
-	{
-		object->previous = nullptr;
-		object->next = nullptr;
-	}
-	else
-	{
-		object->previous = nullptr;
-		object->next = first_free_node;
-	}
+	std::lock_guard<std::mutex> lock(mutex);
 
-	first_free_node = object;
+	// Get the next pointer now, because it will be overwritten before we're finished.
+	PoolNode* next_object = object->next;
+	UnlinkAllocatedNode(object);
 
 	// Increment the iterator, so it points to the next active object.
 	iterator.node = next_object;
@@ -227,6 +208,34 @@ int Pool< PoolType >::GetNumAllocatedObjects() const
 	return num_allocated_objects;
 }
 
+// Moves the node from the allocated list to the free list.
+template < typename PoolType >
+void Pool< PoolType >::UnlinkAllocatedNode(PoolNode* object)
+{
+	// We're about to deallocate an object.
+	--num_allocated_objects;
+
+	PoolNode* previous_object = object->previous;
+	PoolNode* next_object = object->next;
+
+	if (previous_object != nullptr)
+		previous_object->next = next_object;
+	else
+	{
+		RMLUI_ASSERT(first_allocated_node == object);
+		first_allocated_node = next_object;
+	}
+
+	if (next_object != nullptr)
+		next_object->previous = previous_object;
+
+	// Insert the freed node at the beginning of the free object list.
+	object->previous = nullptr;
+	object->next = first_free_node;
+
+	first_free_node = object;
+}
+
 // Creates a new pool chunk and appends its nodes to the beginning of the free list.
 template < typename PoolType >
 void Pool< PoolType >::CreateChunk()
@@ -28,12 +28,13 @@
 #ifndef RMLUI_CORE_PROPERTIESITERATOR_H
 #define RMLUI_CORE_PROPERTIESITERATOR_H
 
-#include "../../Include/RmlUi/Core/PropertyIdSet.h"
 #include "../../Include/RmlUi/Core/Types.h"
 
 namespace Rml {
 
 // An iterator for local properties defined on an element.
+// Both property maps are sorted by id, and are merged during iteration such that local style properties take precedence over the properties
+// with the same id given by the element's definition.
 // Note: Modifying the underlying style invalidates the iterator.
 class PropertiesIterator {
 public:
@@ -48,58 +49,37 @@ public:
 
 	PropertiesIterator& operator++()
 	{
-		if (it_style != it_style_end)
-			// We iterate over the local style properties first
+		if (from_style)
 			++it_style;
 		else
-			// .. and then over the properties given by the element's definition
 			++it_definition;
-		// If we reached the end of one of the iterator pairs, we need to continue iteration on the next pair.
 		ProceedToNextValid();
 		return *this;
 	}
 
 	ValueType operator*() const
 	{
-		if (it_style != it_style_end)
+		if (from_style)
 			return {it_style->first, it_style->second};
 		return {it_definition->first, it_definition->second};
 	}
 
-	bool AtEnd() const { return at_end; }
+	bool AtEnd() const { return it_style == it_style_end && it_definition == it_definition_end; }
 
 private:
-	PropertyIdSet iterated_properties;
 	PropertyIt it_style, it_style_end;
 	PropertyIt it_definition, it_definition_end;
-	bool at_end = false;
-
-	inline bool IsDirtyRemove(PropertyId id)
-	{
-		if (!iterated_properties.Contains(id))
-		{
-			iterated_properties.Insert(id);
-			return true;
-		}
-		return false;
-	}
+	bool from_style = false;
 
 	inline void ProceedToNextValid()
 	{
-		for (; it_style != it_style_end; ++it_style)
-		{
-			if (IsDirtyRemove(it_style->first))
-				return;
-		}
+		const bool style_valid = (it_style != it_style_end);
 
-		for (; it_definition != it_definition_end; ++it_definition)
-		{
-			if (IsDirtyRemove(it_definition->first))
-				return;
-		}
+		// Skip the definition property when it is overridden by the local style.
+		if (style_valid && it_definition != it_definition_end && it_definition->first == it_style->first)
+			++it_definition;
 
-		// All iterators are now at the end
-		at_end = true;
+		from_style = (style_valid && (it_definition == it_definition_end || it_style->first < it_definition->first));
 	}
 };
 
@@ -76,6 +76,18 @@ void PropertyDictionary::Import(const PropertyDictionary& other, int property_sp
 
 void PropertyDictionary::Merge(const PropertyDictionary& other, int specificity_offset)
 {
+	// Copy the sorted properties as a whole when possible, rather than inserting them one by one.
+	if (properties.empty())
+	{
+		properties = other.properties;
+		if (specificity_offset != 0)
+		{
+			for (auto& pair : properties)
+				pair.second.specificity += specificity_offset;
+		}
+		return;
+	}
+
 	for (const auto& pair : other.properties)
 	{
 		const PropertyId id = pair.first;
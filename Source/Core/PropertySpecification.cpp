@@ -106,6 +106,11 @@ const PropertyDefinition* PropertySpecification::GetProperty(const String& prope
 	return GetProperty(property_map->GetId(property_name));
 }
 
+const String& PropertySpecification::GetPropertyName(PropertyId id) const
+{
+	return property_map->GetName(id);
+}
+
 const PropertyIdSet& PropertySpecification::GetRegisteredProperties() const
 {
 	return property_ids;
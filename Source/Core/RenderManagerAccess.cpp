@@ -68,4 +68,9 @@ void RenderManagerAccess::ReleaseAllCompiledGeometry(RenderManager* render_manag
 	render_manager->ReleaseAllCompiledGeometry();
 }
 
+BoxShadowCache& RenderManagerAccess::GetBoxShadowCache(RenderManager* render_manager)
+{
+	return render_manager->texture_database->box_shadow_cache;
+}
+
 } // namespace Rml
@@ -35,6 +35,7 @@
 
 namespace Rml {
 
+class BoxShadowCache;
 class CompiledFilter;
 class CompiledShader;
 class CallbackTexture;
@@ -60,11 +61,14 @@ private:
 	static void ReleaseAllTextures(RenderManager* render_manager);
 	static void ReleaseAllCompiledGeometry(RenderManager* render_manager);
 
+	static BoxShadowCache& GetBoxShadowCache(RenderManager* render_manager);
+
 	friend class CompiledFilter;
 	friend class CompiledShader;
 	friend class CallbackTexture;
 	friend class Geometry;
 	friend class Texture;
+	friend class GeometryBoxShadow;
 
 	friend StringList Rml::GetTextureSourceList();
 	friend bool Rml::ReleaseTexture(const String&, RenderInterface*);
@@ -88,13 +88,20 @@ void StyleSheet::MergeStyleSheet(const StyleSheet& other_sheet)
 	spritesheet_list.Reserve(spritesheet_list.NumSpriteSheets() + other_sheet.spritesheet_list.NumSpriteSheets(),
 		spritesheet_list.NumSprites() + other_sheet.spritesheet_list.NumSprites());
 	spritesheet_list.Merge(other_sheet.spritesheet_list);
+
+	node_index_built = false;
 }
 
 void StyleSheet::BuildNodeIndex()
 {
 	RMLUI_ZoneScoped;
+	std::lock_guard<std::mutex> lock(cache_mutex);
+	if (node_index_built)
+		return;
+
 	styled_node_index = {};
 	root->BuildIndex(styled_node_index);
+	node_index_built = true;
 }
 
 const NamedDecorator* StyleSheet::GetNamedDecorator(const String& name) const
@@ -117,7 +124,9 @@ const DecoratorPtrList& StyleSheet::InstanceDecorators(RenderManager& render_man
 	const PropertySource* source) const
 {
 	RMLUI_ASSERT_NONRECURSIVE; // Since we may return a reference to the below static variable.
-	static DecoratorPtrList non_cached_decorator_list;
+	static thread_local DecoratorPtrList non_cached_decorator_list;
+
+	std::lock_guard<std::mutex> lock(cache_mutex);
 
 	// Empty declaration values are used for interpolated values which we don't want to cache.
 	const bool enable_cache = !declaration_list.value.empty();
@@ -136,14 +145,22 @@ const DecoratorPtrList& StyleSheet::InstanceDecorators(RenderManager& render_man
 
 		auto it_cache = decorator_cache.find(key);
 		if (it_cache != decorator_cache.end())
-			return it_cache->second;
+			return *it_cache->second;
 	}
 	else
 	{
 		non_cached_decorator_list.clear();
 	}
 
-	DecoratorPtrList& decorators = enable_cache ? decorator_cache[key] : non_cached_decorator_list;
+	DecoratorPtrList* decorators_ptr = &non_cached_decorator_list;
+	if (enable_cache)
+	{
+		UniquePtr<DecoratorPtrList>& cache_entry = decorator_cache[key];
+		cache_entry = MakeUnique<DecoratorPtrList>();
+		decorators_ptr = cache_entry.get();
+	}
+
+	DecoratorPtrList& decorators = *decorators_ptr;
 	decorators.reserve(declaration_list.list.size());
 
 	for (const DecoratorDeclaration& declaration : declaration_list.list)
@@ -195,7 +212,7 @@ SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Elemen
 	RMLUI_ASSERT_NONRECURSIVE;
 
 	// Using static to avoid allocations. Make sure we don't call this function recursively.
-	static Vector<const StyleSheetNode*> applicable_nodes;
+	static thread_local Vector<const StyleSheetNode*> applicable_nodes;
 	applicable_nodes.clear();
 
 	auto AddApplicableNodes = [element](const StyleSheetIndex::NodeIndex& node_index, const String& key) {
@@ -254,6 +271,7 @@ SharedPtr<const ElementDefinition> StyleSheet::GetElementDefinition(const Elemen
 	});
 
 	// Check if this puppy has already been cached in the node index.
+	std::lock_guard<std::mutex> lock(cache_mutex);
 	SharedPtr<const ElementDefinition>& definition = node_cache[applicable_nodes];
 	if (!definition)
 	{
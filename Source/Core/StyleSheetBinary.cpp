@@ -0,0 +1,1236 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "StyleSheetBinary.h"
+#include "../../Include/RmlUi/Core/Animation.h"
+#include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/DecorationTypes.h"
+#include "../../Include/RmlUi/Core/Decorator.h"
+#include "../../Include/RmlUi/Core/Factory.h"
+#include "../../Include/RmlUi/Core/Filter.h"
+#include "../../Include/RmlUi/Core/Log.h"
+#include "../../Include/RmlUi/Core/PropertyDefinition.h"
+#include "../../Include/RmlUi/Core/PropertySpecification.h"
+#include "../../Include/RmlUi/Core/Stream.h"
+#include "../../Include/RmlUi/Core/StyleSheet.h"
+#include "../../Include/RmlUi/Core/StyleSheetSpecification.h"
+#include "../../Include/RmlUi/Core/Transform.h"
+#include "StyleSheetNode.h"
+#include "StyleSheetParser.h"
+#include <algorithm>
+#include <string.h>
+#include <type_traits>
+
+namespace Rml {
+
+static const char binary_signature[StyleSheetBinary::SignatureSize] = {'\x89', 'R', 'C', 'S', 'S', 'B', '\r', '\n'};
+static constexpr uint32_t binary_format_version = 2;
+
+// Sizes of the types that are copied directly between memory and the binary data, used to reject data written on a different platform.
+struct BinaryTypeLayout {
+	uint32_t vector4f = sizeof(Vector4f);
+	uint32_t transform_primitive = sizeof(TransformPrimitive);
+};
+
+static bool IsValidUnit(int32_t value)
+{
+	// Properties and numeric values hold a single unit, or none.
+	return value >= 0 && value <= static_cast<int32_t>(Unit::BOXSHADOWLIST) && (value & (value - 1)) == 0;
+}
+
+static bool IsValidAttributeSelectorType(int32_t value)
+{
+	switch (static_cast<AttributeSelectorType>(value))
+	{
+	case AttributeSelectorType::Always:
+	case AttributeSelectorType::Equal:
+	case AttributeSelectorType::InList:
+	case AttributeSelectorType::BeginsWithThenHyphen:
+	case AttributeSelectorType::BeginsWith:
+	case AttributeSelectorType::EndsWith:
+	case AttributeSelectorType::Contains: return true;
+	}
+	return false;
+}
+
+static bool IsValidTweenType(int32_t value)
+{
+	// Callback functions are never stored, thus neither is their type.
+	return value >= 0 && value < static_cast<int32_t>(Tween::Count) && value != static_cast<int32_t>(Tween::Callback);
+}
+
+struct StyleSheetBinary::Writer {
+	explicit Writer(String& data) : data(data) {}
+
+	template <typename T>
+	void Value(const T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written directly.");
+		static_assert(!std::is_enum<T>::value && !std::is_same<T, bool>::value, "Enumerations and booleans must be written with Enum() and Bool().");
+		data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+	template <typename T>
+	void Enum(T value)
+	{
+		static_assert(std::is_enum<T>::value, "Only enumerations can be written as enumerations.");
+		Value(static_cast<int32_t>(value));
+	}
+	void Bool(bool value) { Value(static_cast<uint8_t>(value)); }
+	void Size(size_t size) { Value(static_cast<uint32_t>(size)); }
+	void Text(const String& str)
+	{
+		Size(str.size());
+		data.append(str);
+	}
+	void Number(const NumericValue& value)
+	{
+		Value(value.number);
+		Enum(value.unit);
+	}
+
+	String& data;
+	UnorderedMap<const PropertySource*, uint32_t> sources;
+	bool valid = true;
+};
+
+struct StyleSheetBinary::Reader {
+	Reader(const char* begin, const char* end) : it(begin), end(end) {}
+
+	template <typename T>
+	bool Value(T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read directly.");
+		static_assert(!std::is_enum<T>::value && !std::is_same<T, bool>::value, "Enumerations and booleans must be read with Enum() and Bool().");
+		if (Remaining() < sizeof(T))
+			return false;
+		memcpy(static_cast<void*>(&value), it, sizeof(T));
+		it += sizeof(T);
+		return true;
+	}
+	// Reads an enumeration value, and ensures that it is one of the values accepted by 'is_valid'.
+	template <typename T, typename Predicate>
+	bool Enum(T& value, Predicate is_valid)
+	{
+		int32_t integer = 0;
+		if (!Value(integer) || !is_valid(integer))
+			return false;
+		value = static_cast<T>(integer);
+		return true;
+	}
+	// Reads an enumeration value, and ensures that it is in the range [0, last].
+	template <typename T>
+	bool Enum(T& value, T last)
+	{
+		return Enum(value, [last](int32_t integer) { return integer >= 0 && integer <= static_cast<int32_t>(last); });
+	}
+	bool Bool(bool& value)
+	{
+		uint8_t integer = 0;
+		if (!Value(integer) || integer > 1)
+			return false;
+		value = (integer != 0);
+		return true;
+	}
+	// Reads an element count, and ensures that the data holds at least 'min_element_size' bytes for each of them.
+	bool Size(size_t& size, size_t min_element_size = 1)
+	{
+		uint32_t value = 0;
+		if (!Value(value) || Remaining() / min_element_size < value)
+			return false;
+		size = value;
+		return true;
+	}
+	bool Text(String& str)
+	{
+		size_t size = 0;
+		if (!Size(size))
+			return false;
+		str.assign(it, size);
+		it += size;
+		return true;
+	}
+	bool Number(NumericValue& value) { return Value(value.number) && Enum(value.unit, IsValidUnit); }
+
+	size_t Remaining() const { return static_cast<size_t>(end - it); }
+
+	const char* it;
+	const char* end;
+	Vector<SharedPtr<const PropertySource>> sources;
+};
+
+bool StyleSheetBinary::IsBinary(Stream* stream)
+{
+	char signature[SignatureSize];
+	if (stream->Length() < SignatureSize)
+		return false;
+	return stream->Peek(signature, SignatureSize) == SignatureSize && memcmp(signature, binary_signature, SignatureSize) == 0;
+}
+
+bool StyleSheetBinary::Write(const MediaBlockList& media_blocks, String& out_data)
+{
+	Writer writer(out_data);
+
+	out_data.append(binary_signature, SignatureSize);
+	writer.Value(binary_format_version);
+	writer.Value(BinaryTypeLayout{});
+	writer.Text(GetVersion());
+
+	writer.Size(media_blocks.size());
+	for (const MediaBlock& media_block : media_blocks)
+	{
+		writer.Enum(media_block.modifier);
+		WriteProperties(writer, media_block.properties, StyleSheetParser::GetMediaQuerySpecification());
+		WriteStyleSheet(writer, *media_block.stylesheet);
+	}
+
+	return writer.valid;
+}
+
+bool StyleSheetBinary::Read(MediaBlockList& media_blocks, const String& data)
+{
+	Reader reader(data.data(), data.data() + data.size());
+
+	if (reader.Remaining() < SignatureSize || memcmp(reader.it, binary_signature, SignatureSize) != 0)
+		return false;
+	reader.it += SignatureSize;
+
+	uint32_t format_version = 0;
+	BinaryTypeLayout layout, expected_layout;
+	String version;
+	if (!reader.Value(format_version) || !reader.Value(layout) || !reader.Text(version))
+		return false;
+
+	if (format_version != binary_format_version || memcmp(&layout, &expected_layout, sizeof(BinaryTypeLayout)) != 0 || version != GetVersion())
+	{
+		Log::Message(Log::LT_ERROR, "Compiled style sheet was written by an incompatible version or platform (RmlUi %s), it must be recompiled.",
+			version.c_str());
+		return false;
+	}
+
+	size_t num_media_blocks = 0;
+	if (!reader.Size(num_media_blocks))
+		return false;
+
+	MediaBlockList new_media_blocks;
+	new_media_blocks.reserve(num_media_blocks);
+
+	for (size_t i = 0; i < num_media_blocks; i++)
+	{
+		MediaBlock media_block;
+		media_block.stylesheet = SharedPtr<StyleSheet>(new StyleSheet());
+
+		if (!reader.Enum(media_block.modifier, MediaQueryModifier::Not) ||
+			!ReadProperties(reader, media_block.properties, StyleSheetParser::GetMediaQuerySpecification()) ||
+			!ReadStyleSheet(reader, *media_block.stylesheet))
+			return false;
+
+		new_media_blocks.push_back(std::move(media_block));
+	}
+
+	if (reader.Remaining() != 0)
+		return false;
+
+	media_blocks.insert(media_blocks.end(), std::make_move_iterator(new_media_blocks.begin()), std::make_move_iterator(new_media_blocks.end()));
+	return true;
+}
+
+template <typename NodeType>
+void StyleSheetBinary::CollectNodes(NodeType* node, Vector<NodeType*>& nodes)
+{
+	nodes.push_back(node);
+	for (const auto& child : node->children)
+		CollectNodes<NodeType>(child.get(), nodes);
+}
+
+void StyleSheetBinary::WriteStyleSheet(Writer& writer, const StyleSheet& sheet)
+{
+	const PropertySpecification& specification = StyleSheetSpecification::GetPropertySpecification();
+
+	writer.Value(static_cast<int32_t>(sheet.specificity_offset));
+	WriteNode(writer, *sheet.root);
+
+	writer.Size(sheet.keyframes.size());
+	for (const auto& pair : sheet.keyframes)
+	{
+		const Keyframes& keyframes = pair.second;
+		writer.Text(pair.first);
+
+		writer.Size(keyframes.property_ids.size());
+		for (PropertyId id : keyframes.property_ids)
+			WritePropertyId(writer, id, specification);
+
+		writer.Size(keyframes.blocks.size());
+		for (const KeyframeBlock& block : keyframes.blocks)
+		{
+			writer.Value(block.normalized_time);
+			WriteProperties(writer, block.properties, specification);
+		}
+	}
+
+	writer.Size(sheet.named_decorator_map.size());
+	for (const auto& pair : sheet.named_decorator_map)
+	{
+		const NamedDecorator& decorator = pair.second;
+		writer.Text(pair.first);
+		writer.Text(decorator.type);
+		WriteProperties(writer, decorator.properties, decorator.instancer->GetPropertySpecification());
+	}
+
+	// Sprites are stored with their sprite sheet, so that the sheets can be added back in their original order.
+	const SpritesheetList& spritesheet_list = sheet.spritesheet_list;
+	UnorderedMap<const Spritesheet*, SpriteDefinitionList> sprite_definitions;
+	for (const auto& pair : spritesheet_list.sprite_map)
+		sprite_definitions[pair.second.sprite_sheet].emplace_back(pair.first, pair.second.rectangle);
+
+	writer.Size(spritesheet_list.spritesheets.size());
+	for (const SharedPtr<const Spritesheet>& spritesheet : spritesheet_list.spritesheets)
+	{
+		writer.Text(spritesheet->name);
+		writer.Text(spritesheet->texture_source.GetSource());
+		writer.Text(spritesheet->texture_source.GetDefinitionSource());
+		writer.Value(static_cast<int32_t>(spritesheet->definition_line_number));
+		writer.Value(spritesheet->display_scale);
+
+		const SpriteDefinitionList& sprites = sprite_definitions[spritesheet.get()];
+		writer.Size(sprites.size());
+		for (const auto& sprite : sprites)
+		{
+			writer.Text(sprite.first);
+			writer.Value(sprite.second);
+		}
+	}
+}
+
+bool StyleSheetBinary::ReadStyleSheet(Reader& reader, StyleSheet& sheet)
+{
+	const PropertySpecification& specification = StyleSheetSpecification::GetPropertySpecification();
+
+	int32_t specificity_offset = 0;
+	if (!reader.Value(specificity_offset) || !ReadNode(reader, *sheet.root))
+		return false;
+	sheet.specificity_offset = specificity_offset;
+
+	size_t num_keyframes = 0;
+	if (!reader.Size(num_keyframes))
+		return false;
+	sheet.keyframes.reserve(num_keyframes);
+
+	for (size_t i = 0; i < num_keyframes; i++)
+	{
+		String name;
+		size_t num_property_ids = 0;
+		if (!reader.Text(name) || !reader.Size(num_property_ids))
+			return false;
+
+		Keyframes& keyframes = sheet.keyframes[name];
+		keyframes.property_ids.resize(num_property_ids);
+		for (PropertyId& id : keyframes.property_ids)
+		{
+			if (!ReadPropertyId(reader, id, specification))
+				return false;
+		}
+
+		size_t num_blocks = 0;
+		if (!reader.Size(num_blocks))
+			return false;
+		keyframes.blocks.reserve(num_blocks);
+
+		for (size_t j = 0; j < num_blocks; j++)
+		{
+			float normalized_time = 0.f;
+			if (!reader.Value(normalized_time))
+				return false;
+			keyframes.blocks.emplace_back(normalized_time);
+			if (!ReadProperties(reader, keyframes.blocks.back().properties, specification))
+				return false;
+		}
+	}
+
+	size_t num_decorators = 0;
+	if (!reader.Size(num_decorators))
+		return false;
+	sheet.named_decorator_map.reserve(num_decorators);
+
+	for (size_t i = 0; i < num_decorators; i++)
+	{
+		String name;
+		NamedDecorator decorator;
+		if (!reader.Text(name) || !reader.Text(decorator.type))
+			return false;
+
+		decorator.instancer = Factory::GetDecoratorInstancer(decorator.type);
+		if (!decorator.instancer)
+		{
+			Log::Message(Log::LT_ERROR, "Compiled style sheet uses unknown decorator type '%s'.", decorator.type.c_str());
+			return false;
+		}
+		if (!ReadProperties(reader, decorator.properties, decorator.instancer->GetPropertySpecification()))
+			return false;
+
+		sheet.named_decorator_map.emplace(std::move(name), std::move(decorator));
+	}
+
+	size_t num_spritesheets = 0;
+	if (!reader.Size(num_spritesheets))
+		return false;
+
+	for (size_t i = 0; i < num_spritesheets; i++)
+	{
+		String name, image_source, definition_source;
+		int32_t definition_line_number = 0;
+		float display_scale = 1.f;
+		size_t num_sprites = 0;
+		if (!reader.Text(name) || !reader.Text(image_source) || !reader.Text(definition_source) || !reader.Value(definition_line_number) ||
+			!reader.Value(display_scale) || !reader.Size(num_sprites))
+			return false;
+
+		SpriteDefinitionList sprites(num_sprites);
+		for (auto& sprite : sprites)
+		{
+			if (!reader.Text(sprite.first) || !reader.Value(sprite.second))
+				return false;
+		}
+
+		sheet.spritesheet_list.AddSpriteSheet(name, image_source, definition_source, definition_line_number, display_scale, sprites);
+	}
+
+	return true;
+}
+
+void StyleSheetBinary::WriteNode(Writer& writer, const StyleSheetNode& node)
+{
+	writer.Value(static_cast<int32_t>(node.specificity));
+	WriteProperties(writer, node.properties, StyleSheetSpecification::GetPropertySpecification());
+
+	writer.Size(node.children.size());
+	for (const auto& child : node.children)
+	{
+		WriteSelector(writer, child->selector);
+		WriteNode(writer, *child);
+	}
+}
+
+bool StyleSheetBinary::ReadNode(Reader& reader, StyleSheetNode& node)
+{
+	int32_t specificity = 0;
+	size_t num_children = 0;
+	if (!reader.Value(specificity) || !ReadProperties(reader, node.properties, StyleSheetSpecification::GetPropertySpecification()) ||
+		!reader.Size(num_children))
+		return false;
+	node.specificity = specificity;
+
+	node.children.reserve(num_children);
+	for (size_t i = 0; i < num_children; i++)
+	{
+		CompoundSelector selector;
+		if (!ReadSelector(reader, selector))
+			return false;
+		node.children.push_back(MakeUnique<StyleSheetNode>(&node, std::move(selector)));
+		if (!ReadNode(reader, *node.children.back()))
+			return false;
+	}
+
+	return true;
+}
+
+void StyleSheetBinary::WriteSelector(Writer& writer, const CompoundSelector& selector)
+{
+	writer.Text(selector.tag);
+	writer.Text(selector.id);
+
+	writer.Size(selector.class_names.size());
+	for (const String& name : selector.class_names)
+		writer.Text(name);
+
+	writer.Size(selector.pseudo_class_names.size());
+	for (const String& name : selector.pseudo_class_names)
+		writer.Text(name);
+
+	writer.Size(selector.attributes.size());
+	for (const AttributeSelector& attribute : selector.attributes)
+	{
+		writer.Enum(attribute.type);
+		writer.Text(attribute.name);
+		writer.Text(attribute.value);
+	}
+
+	writer.Size(selector.structural_selectors.size());
+	for (const StructuralSelector& structural : selector.structural_selectors)
+	{
+		writer.Enum(structural.type);
+		writer.Value(static_cast<int32_t>(structural.a));
+		writer.Value(static_cast<int32_t>(structural.b));
+		writer.Value(static_cast<int32_t>(structural.specificity));
+		writer.Bool(structural.selector_tree != nullptr);
+		if (structural.selector_tree)
+			WriteSelectorTree(writer, *structural.selector_tree);
+	}
+
+	writer.Enum(selector.combinator);
+}
+
+bool StyleSheetBinary::ReadSelector(Reader& reader, CompoundSelector& selector)
+{
+	size_t num_class_names = 0;
+	if (!reader.Text(selector.tag) || !reader.Text(selector.id) || !reader.Size(num_class_names))
+		return false;
+
+	selector.class_names.resize(num_class_names);
+	for (String& name : selector.class_names)
+	{
+		if (!reader.Text(name))
+			return false;
+	}
+
+	size_t num_pseudo_class_names = 0;
+	if (!reader.Size(num_pseudo_class_names))
+		return false;
+
+	selector.pseudo_class_names.resize(num_pseudo_class_names);
+	for (String& name : selector.pseudo_class_names)
+	{
+		if (!reader.Text(name))
+			return false;
+	}
+
+	size_t num_attributes = 0;
+	if (!reader.Size(num_attributes))
+		return false;
+
+	selector.attributes.resize(num_attributes);
+	for (AttributeSelector& attribute : selector.attributes)
+	{
+		if (!reader.Enum(attribute.type, IsValidAttributeSelectorType) || !reader.Text(attribute.name) || !reader.Text(attribute.value))
+			return false;
+	}
+
+	size_t num_structural_selectors = 0;
+	if (!reader.Size(num_structural_selectors))
+		return false;
+
+	selector.structural_selectors.reserve(num_structural_selectors);
+	for (size_t i = 0; i < num_structural_selectors; i++)
+	{
+		StructuralSelectorType type = StructuralSelectorType::Invalid;
+		int32_t a = 0, b = 0, specificity = 0;
+		bool has_selector_tree = false;
+		if (!reader.Enum(type, StructuralSelectorType::Scope) || !reader.Value(a) || !reader.Value(b) || !reader.Value(specificity) ||
+			!reader.Bool(has_selector_tree))
+			return false;
+
+		StructuralSelector structural(type, a, b);
+		structural.specificity = specificity;
+		if (has_selector_tree)
+		{
+			auto tree = MakeShared<SelectorTree>();
+			if (!ReadSelectorTree(reader, *tree))
+				return false;
+			structural.selector_tree = std::move(tree);
+		}
+
+		selector.structural_selectors.push_back(std::move(structural));
+	}
+
+	return reader.Enum(selector.combinator, SelectorCombinator::SubsequentSibling);
+}
+
+void StyleSheetBinary::WriteSelectorTree(Writer& writer, const SelectorTree& tree)
+{
+	WriteNode(writer, *tree.root);
+
+	// Leafs are identified by their index in a depth-first traversal of the tree, which matches the order the nodes are written in.
+	Vector<const StyleSheetNode*> nodes;
+	CollectNodes<const StyleSheetNode>(tree.root.get(), nodes);
+
+	writer.Size(tree.leafs.size());
+	for (const StyleSheetNode* leaf : tree.leafs)
+	{
+		const auto it = std::find(nodes.begin(), nodes.end(), leaf);
+		RMLUI_ASSERT(it != nodes.end());
+		writer.Value(static_cast<uint32_t>(it - nodes.begin()));
+	}
+}
+
+bool StyleSheetBinary::ReadSelectorTree(Reader& reader, SelectorTree& tree)
+{
+	tree.root = MakeUnique<StyleSheetNode>();
+	if (!ReadNode(reader, *tree.root))
+		return false;
+
+	Vector<StyleSheetNode*> nodes;
+	CollectNodes<StyleSheetNode>(tree.root.get(), nodes);
+
+	size_t num_leafs = 0;
+	if (!reader.Size(num_leafs, sizeof(uint32_t)))
+		return false;
+
+	tree.leafs.resize(num_leafs);
+	for (StyleSheetNode*& leaf : tree.leafs)
+	{
+		uint32_t index = 0;
+		if (!reader.Value(index) || index >= nodes.size())
+			return false;
+		leaf = nodes[index];
+	}
+
+	return true;
+}
+
+void StyleSheetBinary::WriteProperties(Writer& writer, const PropertyDictionary& dictionary, const PropertySpecification& specification)
+{
+	const PropertyMap& properties = dictionary.GetProperties();
+	writer.Size(properties.size());
+	for (const auto& pair : properties)
+	{
+		WritePropertyId(writer, pair.first, specification);
+		WriteProperty(writer, pair.second);
+	}
+}
+
+bool StyleSheetBinary::ReadProperties(Reader& reader, PropertyDictionary& dictionary, const PropertySpecification& specification)
+{
+	size_t num_properties = 0;
+	if (!reader.Size(num_properties))
+		return false;
+
+	for (size_t i = 0; i < num_properties; i++)
+	{
+		PropertyId id = PropertyId::Invalid;
+		Property property;
+		if (!ReadPropertyId(reader, id, specification) || !ReadProperty(reader, property, specification.GetProperty(id)))
+			return false;
+		dictionary.SetProperty(id, property);
+	}
+
+	return true;
+}
+
+void StyleSheetBinary::WriteProperty(Writer& writer, const Property& property)
+{
+	writer.Enum(property.unit);
+	writer.Value(static_cast<int32_t>(property.specificity));
+	writer.Value(static_cast<int32_t>(property.parser_index));
+	writer.Bool(property.definition != nullptr);
+	WriteSource(writer, property.source.get());
+	WriteVariant(writer, property.value);
+}
+
+bool StyleSheetBinary::ReadProperty(Reader& reader, Property& property, const PropertyDefinition* definition)
+{
+	int32_t specificity = 0, parser_index = 0;
+	bool has_definition = false;
+	if (!reader.Enum(property.unit, IsValidUnit) || !reader.Value(specificity) || !reader.Value(parser_index) || !reader.Bool(has_definition) ||
+		!ReadSource(reader, property.source) || !ReadVariant(reader, property.value, definition))
+		return false;
+
+	property.specificity = specificity;
+	property.parser_index = parser_index;
+	property.definition = (has_definition ? definition : nullptr);
+	return true;
+}
+
+void StyleSheetBinary::WritePropertyId(Writer& writer, PropertyId id, const PropertySpecification& specification)
+{
+	// Properties are stored by name, since the ids of custom properties depend on their registration order.
+	writer.Text(id == PropertyId::Invalid ? String() : specification.GetPropertyName(id));
+}
+
+bool StyleSheetBinary::ReadPropertyId(Reader& reader, PropertyId& id, const PropertySpecification& specification)
+{
+	String name;
+	if (!reader.Text(name))
+		return false;
+
+	id = PropertyId::Invalid;
+	if (name.empty())
+		return true;
+
+	const PropertyDefinition* definition = specification.GetProperty(name);
+	if (!definition)
+	{
+		Log::Message(Log::LT_ERROR, "Compiled style sheet uses unknown property '%s'.", name.c_str());
+		return false;
+	}
+
+	id = definition->GetId();
+	return true;
+}
+
+void StyleSheetBinary::WriteSource(Writer& writer, const PropertySource* source)
+{
+	// Sources are shared between all properties of a rule, each source is written once and then referred to by its one-based index.
+	if (!source)
+	{
+		writer.Value(uint32_t(0));
+		return;
+	}
+
+	auto it = writer.sources.find(source);
+	if (it != writer.sources.end())
+	{
+		writer.Value(it->second);
+		return;
+	}
+
+	const uint32_t index = static_cast<uint32_t>(writer.sources.size()) + 1;
+	writer.sources.emplace(source, index);
+	writer.Value(index);
+	writer.Text(source->path);
+	writer.Value(static_cast<int32_t>(source->line_number));
+	writer.Text(source->rule_name);
+}
+
+bool StyleSheetBinary::ReadSource(Reader& reader, SharedPtr<const PropertySource>& source)
+{
+	uint32_t index = 0;
+	if (!reader.Value(index))
+		return false;
+
+	if (index == 0)
+	{
+		source.reset();
+		return true;
+	}
+	if (index <= reader.sources.size())
+	{
+		source = reader.sources[index - 1];
+		return true;
+	}
+	if (index != reader.sources.size() + 1)
+		return false;
+
+	String path, rule_name;
+	int32_t line_number = 0;
+	if (!reader.Text(path) || !reader.Value(line_number) || !reader.Text(rule_name))
+		return false;
+
+	source = MakeShared<const PropertySource>(std::move(path), line_number, std::move(rule_name));
+	reader.sources.push_back(source);
+	return true;
+}
+
+void StyleSheetBinary::WriteTween(Writer& writer, const Tween& tween)
+{
+	// Callback functions can only be set from code, and cannot be stored.
+	if (tween.type_in == Tween::Callback || tween.type_out == Tween::Callback)
+	{
+		Log::Message(Log::LT_ERROR, "Cannot compile style sheet property holding a tween with a callback function.");
+		writer.valid = false;
+	}
+	writer.Enum(tween.type_in);
+	writer.Enum(tween.type_out);
+}
+
+bool StyleSheetBinary::ReadTween(Reader& reader, Tween& tween)
+{
+	// The direction of a tween is given by which of its in and out types are set.
+	Tween::Type type_in = Tween::None, type_out = Tween::None;
+	if (!reader.Enum(type_in, IsValidTweenType) || !reader.Enum(type_out, IsValidTweenType))
+		return false;
+	tween = Tween(type_in, type_out);
+	return true;
+}
+
+template <size_t N>
+static bool HasValidUnits(const Transforms::UnresolvedPrimitive<N>& primitive)
+{
+	return std::all_of(primitive.values.begin(), primitive.values.end(),
+		[](const NumericValue& value) { return IsValidUnit(static_cast<int32_t>(value.unit)); });
+}
+
+static bool HasValidUnits(const TransformPrimitive& primitive)
+{
+	switch (primitive.type)
+	{
+	case TransformPrimitive::TRANSLATEX: return HasValidUnits(primitive.translate_x);
+	case TransformPrimitive::TRANSLATEY: return HasValidUnits(primitive.translate_y);
+	case TransformPrimitive::TRANSLATEZ: return HasValidUnits(primitive.translate_z);
+	case TransformPrimitive::TRANSLATE2D: return HasValidUnits(primitive.translate_2d);
+	case TransformPrimitive::TRANSLATE3D: return HasValidUnits(primitive.translate_3d);
+	case TransformPrimitive::PERSPECTIVE: return HasValidUnits(primitive.perspective);
+	default: break;
+	}
+	// Other primitives are resolved, and only hold plain numbers.
+	return true;
+}
+
+template <typename T>
+static bool ReadVariantValue(T& value, Variant& variant, bool result)
+{
+	if (result)
+		variant = std::move(value);
+	return result;
+}
+
+void StyleSheetBinary::WriteVariant(Writer& writer, const Variant& variant)
+{
+	const Variant::Type type = variant.GetType();
+	writer.Value(static_cast<uint8_t>(type));
+
+	switch (type)
+	{
+	case Variant::NONE: break;
+	case Variant::BOOL: writer.Bool(variant.GetReference<bool>()); break;
+	case Variant::BYTE: writer.Value(variant.GetReference<byte>()); break;
+	case Variant::CHAR: writer.Value(variant.GetReference<char>()); break;
+	case Variant::FLOAT: writer.Value(variant.GetReference<float>()); break;
+	case Variant::DOUBLE: writer.Value(variant.GetReference<double>()); break;
+	case Variant::INT: writer.Value(variant.GetReference<int>()); break;
+	case Variant::INT64: writer.Value(variant.GetReference<int64_t>()); break;
+	case Variant::UINT: writer.Value(variant.GetReference<unsigned int>()); break;
+	case Variant::UINT64: writer.Value(variant.GetReference<uint64_t>()); break;
+	case Variant::VECTOR2: writer.Value(variant.GetReference<Vector2f>()); break;
+	case Variant::VECTOR3: writer.Value(variant.GetReference<Vector3f>()); break;
+	case Variant::VECTOR4: writer.Value(variant.GetReference<Vector4f>()); break;
+	case Variant::COLOURF: writer.Value(variant.GetReference<Colourf>()); break;
+	case Variant::COLOURB: writer.Value(variant.GetReference<Colourb>()); break;
+	case Variant::STRING: writer.Text(variant.GetReference<String>()); break;
+	case Variant::TRANSFORMPTR:
+	{
+		const TransformPtr& transform = variant.GetReference<TransformPtr>();
+		writer.Bool(transform != nullptr);
+		if (!transform)
+			break;
+
+		// The type of each primitive is written separately, so that it can be validated before the primitive is copied.
+		const Transform::PrimitiveList& primitives = transform->GetPrimitives();
+		writer.Size(primitives.size());
+		for (const TransformPrimitive& primitive : primitives)
+		{
+			writer.Enum(primitive.type);
+			writer.Value(primitive);
+		}
+	}
+	break;
+	case Variant::TRANSITIONLIST:
+	{
+		const TransitionList& transition_list = variant.GetReference<TransitionList>();
+		writer.Bool(transition_list.none);
+		writer.Bool(transition_list.all);
+		writer.Size(transition_list.transitions.size());
+		for (const Transition& transition : transition_list.transitions)
+		{
+			WritePropertyId(writer, transition.id, StyleSheetSpecification::GetPropertySpecification());
+			WriteTween(writer, transition.tween);
+			writer.Value(transition.duration);
+			writer.Value(transition.delay);
+			writer.Value(transition.reverse_adjustment_factor);
+		}
+	}
+	break;
+	case Variant::ANIMATIONLIST:
+	{
+		const AnimationList& animation_list = variant.GetReference<AnimationList>();
+		writer.Size(animation_list.size());
+		for (const Animation& animation : animation_list)
+		{
+			writer.Value(animation.duration);
+			WriteTween(writer, animation.tween);
+			writer.Value(animation.delay);
+			writer.Bool(animation.alternate);
+			writer.Bool(animation.paused);
+			writer.Value(static_cast<int32_t>(animation.num_iterations));
+			writer.Text(animation.name);
+		}
+	}
+	break;
+	case Variant::DECORATORSPTR:
+	{
+		const DecoratorsPtr& decorators = variant.GetReference<DecoratorsPtr>();
+		writer.Bool(decorators != nullptr);
+		if (!decorators)
+			break;
+
+		writer.Text(decorators->value);
+		writer.Size(decorators->list.size());
+		for (const DecoratorDeclaration& declaration : decorators->list)
+		{
+			// Declarations without an instancer refer to a named @decorator, and have no properties of their own.
+			writer.Text(declaration.type);
+			writer.Enum(declaration.paint_area);
+			writer.Bool(declaration.instancer != nullptr);
+			if (declaration.instancer)
+				WriteProperties(writer, declaration.properties, declaration.instancer->GetPropertySpecification());
+		}
+	}
+	break;
+	case Variant::FILTERSPTR:
+	{
+		const FiltersPtr& filters = variant.GetReference<FiltersPtr>();
+		writer.Bool(filters != nullptr);
+		if (!filters)
+			break;
+
+		writer.Text(filters->value);
+		writer.Size(filters->list.size());
+		for (const FilterDeclaration& declaration : filters->list)
+		{
+			writer.Text(declaration.type);
+			writer.Bool(declaration.instancer != nullptr);
+			if (declaration.instancer)
+				WriteProperties(writer, declaration.properties, declaration.instancer->GetPropertySpecification());
+		}
+	}
+	break;
+	case Variant::FONTEFFECTSPTR:
+	{
+		// Font effects are instanced while parsing, only their source value is stored and they are parsed again on load.
+		const FontEffectsPtr& font_effects = variant.GetReference<FontEffectsPtr>();
+		writer.Bool(font_effects != nullptr);
+		if (font_effects)
+			writer.Text(font_effects->value);
+	}
+	break;
+	case Variant::COLORSTOPLIST:
+	{
+		const ColorStopList& color_stops = variant.GetReference<ColorStopList>();
+		writer.Size(color_stops.size());
+		for (const ColorStop& color_stop : color_stops)
+		{
+			writer.Value(color_stop.color);
+			writer.Number(color_stop.position);
+		}
+	}
+	break;
+	case Variant::BOXSHADOWLIST:
+	{
+		const BoxShadowList& shadows = variant.GetReference<BoxShadowList>();
+		writer.Size(shadows.size());
+		for (const BoxShadow& shadow : shadows)
+		{
+			writer.Value(shadow.color);
+			writer.Number(shadow.offset_x);
+			writer.Number(shadow.offset_y);
+			writer.Number(shadow.blur_radius);
+			writer.Number(shadow.spread_distance);
+			writer.Bool(shadow.inset);
+		}
+	}
+	break;
+	case Variant::SCRIPTINTERFACE:
+	case Variant::VOIDPTR:
+	{
+		Log::Message(Log::LT_ERROR, "Cannot compile style sheet property holding a pointer value.");
+		writer.valid = false;
+	}
+	break;
+	}
+}
+
+bool StyleSheetBinary::ReadVariant(Reader& reader, Variant& variant, const PropertyDefinition* definition)
+{
+	uint8_t type_value = 0;
+	if (!reader.Value(type_value))
+		return false;
+
+	switch (static_cast<Variant::Type>(type_value))
+	{
+	case Variant::NONE: variant.Clear(); return true;
+	case Variant::BOOL:
+	{
+		bool value = false;
+		return ReadVariantValue(value, variant, reader.Bool(value));
+	}
+	case Variant::BYTE:
+	{
+		byte value = 0;
+		return ReadVariantValue(value, variant, reader.Value(value));
+	}
+	case Variant::CHAR:
+	{
+		char value = 0;
+		return ReadVariantValue(value, variant, reader.Value(value));
+	}
+	case Variant::FLOAT:
+	{
+		float value = 0;
+		return ReadVariantValue(value, variant, reader.Value(value));
+	}
+	case Variant::DOUBLE:
+	{
+		double value = 0;
+		return ReadVariantValue(value, variant, reader.Value(value));
+	}
+	case Variant::INT:
+	{
+		int value = 0;
+		return ReadVariantValue(value, variant, reader.Value(value));
+	}
+	case Variant::INT64:
+	{
+		int64_t value = 0;
+		return ReadVariantValue(value, variant, reader.Value(value));
+	}
+	case Variant::UINT:
+	{
+		unsigned int value = 0;
+		return ReadVariantValue(value, variant, reader.Value(value));
+	}
+	case Variant::UINT64:
+	{
+		uint64_t value = 0;
+		return ReadVariantValue(value, variant, reader.Value(value));
+	}
+	case Variant::VECTOR2:
+	{
+		Vector2f value;
+		return ReadVariantValue(value, variant, reader.Value(value));
+	}
+	case Variant::VECTOR3:
+	{
+		Vector3f value;
+		return ReadVariantValue(value, variant, reader.Value(value));
+	}
+	case Variant::VECTOR4:
+	{
+		Vector4f value;
+		return ReadVariantValue(value, variant, reader.Value(value));
+	}
+	case Variant::COLOURF:
+	{
+		Colourf value;
+		return ReadVariantValue(value, variant, reader.Value(value));
+	}
+	case Variant::COLOURB:
+	{
+		Colourb value;
+		return ReadVariantValue(value, variant, reader.Value(value));
+	}
+	case Variant::STRING:
+	{
+		String value;
+		return ReadVariantValue(value, variant, reader.Text(value));
+	}
+	case Variant::TRANSFORMPTR:
+	{
+		bool has_transform = false;
+		if (!reader.Bool(has_transform))
+			return false;
+
+		TransformPtr transform;
+		if (has_transform)
+		{
+			size_t num_primitives = 0;
+			if (!reader.Size(num_primitives, sizeof(int32_t) + sizeof(TransformPrimitive)))
+				return false;
+
+			Transform::PrimitiveList primitives;
+			primitives.reserve(num_primitives);
+			for (size_t i = 0; i < num_primitives; i++)
+			{
+				TransformPrimitive::Type type = TransformPrimitive::MATRIX2D;
+				if (!reader.Enum(type, TransformPrimitive::DECOMPOSEDMATRIX4))
+					return false;
+
+				// Primitives are not default constructible, thus construct a placeholder to copy the data into.
+				primitives.emplace_back(Transforms::TranslateX(0.f));
+				TransformPrimitive& primitive = primitives.back();
+				if (!reader.Value(primitive))
+					return false;
+				primitive.type = type;
+				if (!HasValidUnits(primitive))
+					return false;
+			}
+			transform = MakeShared<Transform>(std::move(primitives));
+		}
+		variant = std::move(transform);
+		return true;
+	}
+	case Variant::TRANSITIONLIST:
+	{
+		TransitionList transition_list;
+		size_t num_transitions = 0;
+		if (!reader.Bool(transition_list.none) || !reader.Bool(transition_list.all) || !reader.Size(num_transitions))
+			return false;
+
+		transition_list.transitions.resize(num_transitions);
+		for (Transition& transition : transition_list.transitions)
+		{
+			if (!ReadPropertyId(reader, transition.id, StyleSheetSpecification::GetPropertySpecification()) || !ReadTween(reader, transition.tween) ||
+				!reader.Value(transition.duration) || !reader.Value(transition.delay) || !reader.Value(transition.reverse_adjustment_factor))
+				return false;
+		}
+		variant = std::move(transition_list);
+		return true;
+	}
+	case Variant::ANIMATIONLIST:
+	{
+		AnimationList animation_list;
+		size_t num_animations = 0;
+		if (!reader.Size(num_animations))
+			return false;
+
+		animation_list.resize(num_animations);
+		for (Animation& animation : animation_list)
+		{
+			int32_t num_iterations = 0;
+			if (!reader.Value(animation.duration) || !ReadTween(reader, animation.tween) || !reader.Value(animation.delay) ||
+				!reader.Bool(animation.alternate) || !reader.Bool(animation.paused) || !reader.Value(num_iterations) || !reader.Text(animation.name))
+				return false;
+			animation.num_iterations = num_iterations;
+		}
+		variant = std::move(animation_list);
+		return true;
+	}
+	case Variant::DECORATORSPTR:
+	{
+		bool has_decorators = false;
+		if (!reader.Bool(has_decorators))
+			return false;
+		if (!has_decorators)
+		{
+			variant = DecoratorsPtr();
+			return true;
+		}
+
+		auto decorators = MakeShared<DecoratorDeclarationList>();
+		size_t num_declarations = 0;
+		if (!reader.Text(decorators->value) || !reader.Size(num_declarations))
+			return false;
+
+		decorators->list.resize(num_declarations);
+		for (DecoratorDeclaration& declaration : decorators->list)
+		{
+			bool has_instancer = false;
+			if (!reader.Text(declaration.type) || !reader.Enum(declaration.paint_area, BoxArea::Auto) || !reader.Bool(has_instancer))
+				return false;
+
+			declaration.instancer = nullptr;
+			if (has_instancer)
+			{
+				declaration.instancer = Factory::GetDecoratorInstancer(declaration.type);
+				if (!declaration.instancer)
+				{
+					Log::Message(Log::LT_ERROR, "Compiled style sheet uses unknown decorator type '%s'.", declaration.type.c_str());
+					return false;
+				}
+				if (!ReadProperties(reader, declaration.properties, declaration.instancer->GetPropertySpecification()))
+					return false;
+			}
+		}
+		variant = DecoratorsPtr(std::move(decorators));
+		return true;
+	}
+	case Variant::FILTERSPTR:
+	{
+		bool has_filters = false;
+		if (!reader.Bool(has_filters))
+			return false;
+		if (!has_filters)
+		{
+			variant = FiltersPtr();
+			return true;
+		}
+
+		auto filters = MakeShared<FilterDeclarationList>();
+		size_t num_declarations = 0;
+		if (!reader.Text(filters->value) || !reader.Size(num_declarations))
+			return false;
+
+		filters->list.resize(num_declarations);
+		for (FilterDeclaration& declaration : filters->list)
+		{
+			bool has_instancer = false;
+			if (!reader.Text(declaration.type) || !reader.Bool(has_instancer))
+				return false;
+
+			declaration.instancer = nullptr;
+			if (has_instancer)
+			{
+				declaration.instancer = Factory::GetFilterInstancer(declaration.type);
+				if (!declaration.instancer)
+				{
+					Log::Message(Log::LT_ERROR, "Compiled style sheet uses unknown filter type '%s'.", declaration.type.c_str());
+					return false;
+				}
+				if (!ReadProperties(reader, declaration.properties, declaration.instancer->GetPropertySpecification()))
+					return false;
+			}
+		}
+		variant = FiltersPtr(std::move(filters));
+		return true;
+	}
+	case Variant::FONTEFFECTSPTR:
+	{
+		bool has_font_effects = false;
+		if (!reader.Bool(has_font_effects))
+			return false;
+		if (!has_font_effects)
+		{
+			variant = FontEffectsPtr();
+			return true;
+		}
+
+		String value;
+		Property property;
+		if (!reader.Text(value) || !definition || !definition->ParseValue(property, value))
+			return false;
+		variant = std::move(property.value);
+		return true;
+	}
+	case Variant::COLORSTOPLIST:
+	{
+		ColorStopList color_stops;
+		size_t num_color_stops = 0;
+		if (!reader.Size(num_color_stops))
+			return false;
+
+		color_stops.resize(num_color_stops);
+		for (ColorStop& color_stop : color_stops)
+		{
+			if (!reader.Value(color_stop.color) || !reader.Number(color_stop.position))
+				return false;
+		}
+		variant = std::move(color_stops);
+		return true;
+	}
+	case Variant::BOXSHADOWLIST:
+	{
+		BoxShadowList shadows;
+		size_t num_shadows = 0;
+		if (!reader.Size(num_shadows))
+			return false;
+
+		shadows.resize(num_shadows);
+		for (BoxShadow& shadow : shadows)
+		{
+			if (!reader.Value(shadow.color) || !reader.Number(shadow.offset_x) || !reader.Number(shadow.offset_y) ||
+				!reader.Number(shadow.blur_radius) || !reader.Number(shadow.spread_distance) || !reader.Bool(shadow.inset))
+				return false;
+		}
+		variant = std::move(shadows);
+		return true;
+	}
+	case Variant::SCRIPTINTERFACE:
+	case Variant::VOIDPTR: break;
+	}
+
+	return false;
+}
+
+} // namespace Rml
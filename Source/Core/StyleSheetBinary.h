@@ -0,0 +1,100 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_STYLESHEETBINARY_H
+#define RMLUI_CORE_STYLESHEETBINARY_H
+
+#include "../../Include/RmlUi/Core/StyleSheetTypes.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class PropertyDefinition;
+class PropertySpecification;
+class Stream;
+class Tween;
+struct CompoundSelector;
+struct SelectorTree;
+
+/**
+    Serializes parsed style sheets to and from a compact binary representation.
+
+    The binary data contains the final in-memory state of a style sheet container after parsing: its media blocks, style
+    sheet node trees with their selectors and properties, keyframes, named decorators, and sprite sheets. Loading it only
+    rebuilds the objects, without tokenizing any RCSS or running property parsers. Properties are identified by name so
+    that the data stays valid regardless of the registration order of custom properties, however, the data can only be read
+    by the same library version and platform that wrote it.
+ */
+
+class StyleSheetBinary {
+public:
+	static constexpr size_t SignatureSize = 8;
+
+	/// Returns true if the stream starts with the signature of a compiled style sheet, without consuming it.
+	static bool IsBinary(Stream* stream);
+
+	/// Writes the given media blocks to binary data.
+	/// @return False if the style sheets contain values that cannot be serialized.
+	static bool Write(const MediaBlockList& media_blocks, String& out_data);
+
+	/// Reads media blocks from binary data previously produced by Write().
+	/// @return False if the data is invalid or was compiled by an incompatible library.
+	static bool Read(MediaBlockList& media_blocks, const String& data);
+
+private:
+	struct Writer;
+	struct Reader;
+
+	static void WriteStyleSheet(Writer& writer, const StyleSheet& sheet);
+	static void WriteNode(Writer& writer, const StyleSheetNode& node);
+	static void WriteSelector(Writer& writer, const CompoundSelector& selector);
+	static void WriteSelectorTree(Writer& writer, const SelectorTree& tree);
+	static void WriteProperties(Writer& writer, const PropertyDictionary& dictionary, const PropertySpecification& specification);
+	static void WriteProperty(Writer& writer, const Property& property);
+	static void WritePropertyId(Writer& writer, PropertyId id, const PropertySpecification& specification);
+	static void WriteSource(Writer& writer, const PropertySource* source);
+	static void WriteVariant(Writer& writer, const Variant& variant);
+	static void WriteTween(Writer& writer, const Tween& tween);
+
+	static bool ReadStyleSheet(Reader& reader, StyleSheet& sheet);
+	static bool ReadNode(Reader& reader, StyleSheetNode& node);
+	static bool ReadSelector(Reader& reader, CompoundSelector& selector);
+	static bool ReadSelectorTree(Reader& reader, SelectorTree& tree);
+	static bool ReadProperties(Reader& reader, PropertyDictionary& dictionary, const PropertySpecification& specification);
+	static bool ReadProperty(Reader& reader, Property& property, const PropertyDefinition* definition);
+	static bool ReadPropertyId(Reader& reader, PropertyId& id, const PropertySpecification& specification);
+	static bool ReadSource(Reader& reader, SharedPtr<const PropertySource>& source);
+	static bool ReadVariant(Reader& reader, Variant& variant, const PropertyDefinition* definition);
+	static bool ReadTween(Reader& reader, Tween& tween);
+
+	template <typename NodeType>
+	static void CollectNodes(NodeType* node, Vector<NodeType*>& nodes);
+};
+
+} // namespace Rml
+#endif
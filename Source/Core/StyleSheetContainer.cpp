@@ -29,11 +29,15 @@
 #include "../../Include/RmlUi/Core/StyleSheetContainer.h"
 #include "../../Include/RmlUi/Core/ComputedValues.h"
 #include "../../Include/RmlUi/Core/Context.h"
+#include "../../Include/RmlUi/Core/Log.h"
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/PropertyDictionary.h"
+#include "../../Include/RmlUi/Core/Stream.h"
 #include "../../Include/RmlUi/Core/StyleSheet.h"
 #include "../../Include/RmlUi/Core/Utilities.h"
 #include "ComputeProperty.h"
+#include "StyleSheetBinary.h"
+#include "StyleSheetFactory.h"
 #include "StyleSheetParser.h"
 
 namespace Rml {
@@ -44,11 +48,28 @@ StyleSheetContainer::~StyleSheetContainer() {}
 
 bool StyleSheetContainer::LoadStyleSheetContainer(Stream* stream, int begin_line_number)
 {
+	if (StyleSheetBinary::IsBinary(stream))
+	{
+		String data;
+		stream->Read(data, stream->Length() - stream->Tell());
+		if (!StyleSheetBinary::Read(media_blocks, data))
+		{
+			Log::Message(Log::LT_ERROR, "Failed to load compiled style sheet '%s'.", stream->GetSourceURL().GetURL().c_str());
+			return false;
+		}
+		return true;
+	}
+
 	StyleSheetParser parser;
 	bool result = parser.Parse(media_blocks, stream, begin_line_number);
 	return result;
 }
 
+bool StyleSheetContainer::SerializeStyleSheetContainer(String& out_data) const
+{
+	return StyleSheetBinary::Write(media_blocks, out_data);
+}
+
 bool StyleSheetContainer::UpdateCompiledStyleSheet(const Context* context)
 {
 	RMLUI_ZoneScoped;
@@ -152,27 +173,30 @@ bool StyleSheetContainer::UpdateCompiledStyleSheet(const Context* context)
 
 	if (style_sheet_changed)
 	{
-		StyleSheet* first_sheet = nullptr;
-		UniquePtr<StyleSheet> new_sheet;
+		SharedPtr<StyleSheet> new_sheet;
 
-		for (int index : new_active_media_block_indices)
+		if (new_active_media_block_indices.size() == 1)
 		{
-			MediaBlock& media_block = media_blocks[index];
-			if (!first_sheet)
-				first_sheet = media_block.stylesheet.get();
-			else if (!new_sheet)
-				new_sheet = first_sheet->CombineStyleSheet(*media_block.stylesheet);
-			else
-				new_sheet->MergeStyleSheet(*media_block.stylesheet);
+			compiled_style_sheet = media_blocks[new_active_media_block_indices[0]].stylesheet.get();
 		}
-
-		if (!first_sheet)
+		else if (new_active_media_block_indices.empty())
 		{
 			new_sheet.reset(new StyleSheet);
-			first_sheet = new_sheet.get();
+			compiled_style_sheet = new_sheet.get();
+		}
+		else
+		{
+			// Combined style sheets are shared with any other containers combining the very same style sheets, such as
+			// documents linking the same set of style sheet files.
+			Vector<const StyleSheet*> active_sheets;
+			active_sheets.reserve(new_active_media_block_indices.size());
+			for (int index : new_active_media_block_indices)
+				active_sheets.push_back(media_blocks[index].stylesheet.get());
+
+			new_sheet = StyleSheetFactory::GetCombinedStyleSheet(active_sheets, context->GetRenderManager());
+			compiled_style_sheet = new_sheet.get();
 		}
 
-		compiled_style_sheet = (new_sheet ? new_sheet.get() : first_sheet);
 		combined_compiled_style_sheet = std::move(new_sheet);
 
 		compiled_style_sheet->BuildNodeIndex();
@@ -183,6 +207,14 @@ bool StyleSheetContainer::UpdateCompiledStyleSheet(const Context* context)
 	return style_sheet_changed;
 }
 
+void StyleSheetContainer::BuildNodeIndices()
+{
+	RMLUI_ZoneScoped;
+
+	for (MediaBlock& media_block : media_blocks)
+		media_block.stylesheet->BuildNodeIndex();
+}
+
 StyleSheet* StyleSheetContainer::GetCompiledStyleSheet()
 {
 	return compiled_style_sheet;
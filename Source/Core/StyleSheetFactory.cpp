@@ -28,15 +28,60 @@
 
 #include "StyleSheetFactory.h"
 #include "../../Include/RmlUi/Core/Log.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "../../Include/RmlUi/Core/StreamMemory.h"
 #include "../../Include/RmlUi/Core/StyleSheetContainer.h"
+#include "../../Include/RmlUi/Core/StyleSheet.h"
+#include "ControlledLifetimeResource.h"
 #include "StreamFile.h"
 #include "StyleSheetNode.h"
 #include "StyleSheetParser.h"
 #include "StyleSheetSelector.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <mutex>
 
 namespace Rml {
 
+// Identifies a combined style sheet by the style sheets it was combined from, and the render manager used for instancing its decorators.
+struct CombinedStyleSheetKey {
+	const RenderManager* render_manager;
+	Vector<const StyleSheet*> sheets;
+
+	bool operator==(const CombinedStyleSheetKey& other) const { return render_manager == other.render_manager && sheets == other.sheets; }
+};
+
+} // namespace Rml
+
+namespace std {
+template <>
+struct hash<::Rml::CombinedStyleSheetKey> {
+	size_t operator()(const ::Rml::CombinedStyleSheetKey& key) const noexcept
+	{
+		size_t seed = std::hash<const void*>{}(key.render_manager);
+		for (const ::Rml::StyleSheet* sheet : key.sheets)
+			::Rml::Utilities::HashCombine(seed, sheet);
+		return seed;
+	}
+};
+} // namespace std
+
+namespace Rml {
+
+struct CombinedStyleSheetCache {
+	// Combined style sheets are requested while updating contexts, which may happen concurrently.
+	std::mutex mutex;
+	// The cache does not own the combined sheets. Their owners also own the source sheets, thus the source sheet addresses of an
+	// entry cannot be reused by other sheets for as long as the entry can be retrieved.
+	UnorderedMap<CombinedStyleSheetKey, WeakPtr<StyleSheet>> sheets;
+};
+
+// The inline style sheet cache is flushed when it grows beyond this number of sheets, which bounds its memory usage when lots of
+// documents with unique style blocks are loaded.
+static constexpr size_t MaxNumCachedInlineStyleSheets = 256;
+
 static UniquePtr<StyleSheetFactory> instance;
+static ControlledLifetimeResource<CombinedStyleSheetCache> combined_style_sheet_cache;
 
 StyleSheetFactory::StyleSheetFactory() :
 	selectors{
@@ -62,11 +107,13 @@ bool StyleSheetFactory::Initialise()
 {
 	RMLUI_ASSERT(instance == nullptr);
 	instance = UniquePtr<StyleSheetFactory>(new StyleSheetFactory);
+	combined_style_sheet_cache.Initialize();
 	return true;
 }
 
 void StyleSheetFactory::Shutdown()
 {
+	combined_style_sheet_cache.Shutdown();
 	instance.reset();
 }
 
@@ -90,9 +137,136 @@ const StyleSheetContainer* StyleSheetFactory::GetStyleSheetContainer(const Strin
 	return result;
 }
 
+bool StyleSheetFactory::PreloadStyleSheetContainers(Span<const String> sheet_names, int num_threads)
+{
+	RMLUI_ZoneScoped;
+
+	struct PendingSheet {
+		String name;
+		URL source_url;
+		String source;
+		UniquePtr<StyleSheetContainer> sheet;
+	};
+	Vector<PendingSheet> pending_sheets;
+
+	bool result = true;
+
+	// Read the files on the calling thread, as the file interface is not required to be thread-safe.
+	for (const String& sheet_name : sheet_names)
+	{
+		if (instance->stylesheets.count(sheet_name) ||
+			std::any_of(pending_sheets.begin(), pending_sheets.end(), [&](const PendingSheet& pending) { return pending.name == sheet_name; }))
+			continue;
+
+		StreamFile file_stream;
+		if (!file_stream.Open(sheet_name))
+		{
+			result = false;
+			continue;
+		}
+
+		PendingSheet pending;
+		pending.name = sheet_name;
+		pending.source_url = file_stream.GetSourceURL();
+		file_stream.Read(pending.source, file_stream.Length());
+		pending_sheets.push_back(std::move(pending));
+	}
+
+	// Parse and index the sheets concurrently, each task only touches its own sheet.
+	ThreadPool thread_pool(num_threads);
+	for (PendingSheet& pending : pending_sheets)
+	{
+		thread_pool.Submit([&pending]() {
+			StreamMemory stream(reinterpret_cast<const byte*>(pending.source.data()), pending.source.size());
+			stream.SetSourceURL(pending.source_url);
+
+			auto sheet = MakeUnique<StyleSheetContainer>();
+			if (sheet->LoadStyleSheetContainer(&stream))
+			{
+				sheet->BuildNodeIndices();
+				pending.sheet = std::move(sheet);
+			}
+		});
+	}
+	thread_pool.Wait();
+
+	for (PendingSheet& pending : pending_sheets)
+	{
+		if (pending.sheet)
+			instance->stylesheets[pending.name] = std::move(pending.sheet);
+		else
+			result = false;
+	}
+
+	return result;
+}
+
+SharedPtr<const StyleSheetContainer> StyleSheetFactory::GetInlineStyleSheetContainer(const String& content, const String& source_path,
+	int line_number)
+{
+	String key;
+	key.reserve(source_path.size() + content.size() + 16);
+	key += source_path;
+	key += '\n';
+	key += ToString(line_number);
+	key += '\n';
+	key += content;
+
+	auto it = instance->inline_stylesheets.find(key);
+	if (it != instance->inline_stylesheets.end())
+		return it->second;
+
+	auto sheet = MakeShared<StyleSheetContainer>();
+	StreamMemory stream(reinterpret_cast<const byte*>(content.data()), content.size());
+	stream.SetSourceURL(source_path);
+	if (!sheet->LoadStyleSheetContainer(&stream, line_number))
+		return nullptr;
+
+	if (instance->inline_stylesheets.size() >= MaxNumCachedInlineStyleSheets)
+		instance->inline_stylesheets.clear();
+	instance->inline_stylesheets.emplace(std::move(key), sheet);
+
+	return sheet;
+}
+
+SharedPtr<StyleSheet> StyleSheetFactory::GetCombinedStyleSheet(const Vector<const StyleSheet*>& sheets, const RenderManager& render_manager)
+{
+	RMLUI_ZoneScoped;
+	RMLUI_ASSERT(sheets.size() >= 2);
+
+	std::lock_guard<std::mutex> lock(combined_style_sheet_cache->mutex);
+	auto& cached_sheets = combined_style_sheet_cache->sheets;
+
+	CombinedStyleSheetKey key{&render_manager, sheets};
+	auto it = cached_sheets.find(key);
+	if (it != cached_sheets.end())
+	{
+		if (SharedPtr<StyleSheet> sheet = it->second.lock())
+			return sheet;
+	}
+
+	SharedPtr<StyleSheet> new_sheet = sheets[0]->CombineStyleSheet(*sheets[1]);
+	for (size_t i = 2; i < sheets.size(); i++)
+		new_sheet->MergeStyleSheet(*sheets[i]);
+
+	// Remove entries of sheets which are no longer in use before adding the new one.
+	for (auto it_entry = cached_sheets.begin(); it_entry != cached_sheets.end();)
+	{
+		if (it_entry->second.expired())
+			it_entry = cached_sheets.erase(it_entry);
+		else
+			++it_entry;
+	}
+
+	cached_sheets[std::move(key)] = new_sheet;
+
+	return new_sheet;
+}
+
 void StyleSheetFactory::ClearStyleSheetCache()
 {
 	instance->stylesheets.clear();
+	instance->inline_stylesheets.clear();
 }
 
 StructuralSelector StyleSheetFactory::GetSelector(const String& name)
@@ -33,6 +33,8 @@
 
 namespace Rml {
 
+class RenderManager;
+class StyleSheet;
 class StyleSheetContainer;
 enum class StructuralSelectorType;
 struct StructuralSelector;
@@ -57,6 +59,27 @@ public:
 	/// @lifetime Returned pointer is valid until the next call to ClearStyleSheetCache or Shutdown, it should not be stored around.
 	static const StyleSheetContainer* GetStyleSheetContainer(const String& sheet);
 
+	/// Loads the given sheets into the cache, parsing them concurrently. Sheets which are already cached are skipped.
+	/// @param[in] sheets The names of the sheets to load.
+	/// @param[in] num_threads The number of worker threads in addition to the calling thread.
+	/// @return True if all the sheets were loaded successfully.
+	static bool PreloadStyleSheetContainers(Span<const String> sheets, int num_threads);
+
+	/// Returns the sheet parsed from the contents of an inline style block, retrieving it from the cache if the same block
+	/// has already been loaded.
+	/// @param[in] content The contents of the style block.
+	/// @param[in] source_path The path of the document containing the style block.
+	/// @param[in] line_number The line number of the style block within the document.
+	/// @return The loaded sheet, or null if it could not be parsed.
+	static SharedPtr<const StyleSheetContainer> GetInlineStyleSheetContainer(const String& content, const String& source_path, int line_number);
+
+	/// Returns a compiled style sheet combining the given style sheets in order. The result is shared by all callers combining
+	/// the same style sheets for the same render manager, for as long as any of them holds on to it.
+	/// @param[in] sheets The style sheets to combine, at least two.
+	/// @param[in] render_manager The render manager that decorators of the combined sheet are instanced with.
+	/// @lifetime The given style sheets must be kept alive for as long as the returned sheet is used.
+	static SharedPtr<StyleSheet> GetCombinedStyleSheet(const Vector<const StyleSheet*>& sheets, const RenderManager& render_manager);
+
 	/// Clear the style sheet cache.
 	static void ClearStyleSheetCache();
 
@@ -75,6 +98,10 @@ private:
 	using StyleSheets = UnorderedMap<String, UniquePtr<const StyleSheetContainer>>;
 	StyleSheets stylesheets;
 
+	// Inline style sheets, keyed by their source location and contents.
+	using InlineStyleSheets = UnorderedMap<String, SharedPtr<const StyleSheetContainer>>;
+	InlineStyleSheets inline_stylesheets;
+
 	// Custom complex selectors available for style sheets.
 	using SelectorMap = UnorderedMap<String, StructuralSelectorType>;
 	SelectorMap selectors;
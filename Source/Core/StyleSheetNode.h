@@ -36,6 +36,7 @@
 namespace Rml {
 
 struct StyleSheetIndex;
+class StyleSheetBinary;
 class StyleSheetNode;
 using StyleSheetNodeList = Vector<UniquePtr<StyleSheetNode>>;
 
@@ -102,6 +103,8 @@ private:
 	PropertyDictionary properties;
 
 	StyleSheetNodeList children;
+
+	friend Rml::StyleSheetBinary;
 };
 
 } // namespace Rml
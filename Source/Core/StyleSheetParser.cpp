@@ -33,7 +33,7 @@
 #include "../../Include/RmlUi/Core/Profiling.h"
 #include "../../Include/RmlUi/Core/PropertyDefinition.h"
 #include "../../Include/RmlUi/Core/PropertySpecification.h"
-#include "../../Include/RmlUi/Core/StreamMemory.h"
+#include "../../Include/RmlUi/Core/Stream.h"
 #include "../../Include/RmlUi/Core/StyleSheet.h"
 #include "../../Include/RmlUi/Core/StyleSheetContainer.h"
 #include "../../Include/RmlUi/Core/StyleSheetSpecification.h"
@@ -42,10 +42,40 @@
 #include "StyleSheetFactory.h"
 #include "StyleSheetNode.h"
 #include <algorithm>
+#include <mutex>
 #include <string.h>
 
 namespace Rml {
 
+/*
+ *  Lookup table of the characters that interrupt a run of ordinary characters while tokenizing. Line breaks and slashes
+ *  always interrupt a run, for line counting and for detecting comments.
+ */
+class DelimiterSet {
+public:
+	explicit DelimiterSet(const char* delimiters)
+	{
+		table[static_cast<unsigned char>('\n')] = Special;
+		table[static_cast<unsigned char>('/')] = Special;
+		for (; *delimiters; delimiters++)
+			table[static_cast<unsigned char>(*delimiters)] = Delimiter;
+	}
+
+	// Returns the first delimiter or special character in the range, or 'end' if there is none.
+	const char* Find(const char* it, const char* end) const
+	{
+		while (it != end && table[static_cast<unsigned char>(*it)] == Ordinary)
+			++it;
+		return it;
+	}
+
+	bool IsDelimiter(char c) const { return table[static_cast<unsigned char>(c)] == Delimiter; }
+
+private:
+	enum Type : uint8_t { Ordinary, Special, Delimiter };
+	Type table[256] = {};
+};
+
 class AbstractPropertyParser : NonCopyMoveable {
 protected:
 	~AbstractPropertyParser() = default;
@@ -205,12 +235,16 @@ public:
 		RMLUI_ASSERT(properties);
 		return specification.ParsePropertyDeclaration(*properties, name, value);
 	}
+
+	const PropertySpecification& GetSpecification() const { return specification; }
 };
 
 struct StyleSheetParserData {
 	// The following parsers are reasonably heavy to initialize, so we construct them during library initialization.
 	SpritesheetPropertyParser spritesheet;
 	MediaQueryPropertyParser media_query;
+	// The parsers above hold their results, thus they must be locked while in use when style sheets are parsed concurrently.
+	std::mutex mutex;
 };
 
 static ControlledLifetimeResource<StyleSheetParserData> style_sheet_property_parsers;
@@ -219,7 +253,8 @@ StyleSheetParser::StyleSheetParser()
 {
 	line_number = 0;
 	stream = nullptr;
-	parse_buffer_pos = 0;
+	parse_position = nullptr;
+	parse_end = nullptr;
 }
 
 StyleSheetParser::~StyleSheetParser() {}
@@ -234,6 +269,11 @@ void StyleSheetParser::Shutdown()
 	style_sheet_property_parsers.Shutdown();
 }
 
+const PropertySpecification& StyleSheetParser::GetMediaQuerySpecification()
+{
+	return style_sheet_property_parsers->media_query.GetSpecification();
+}
+
 static bool IsValidIdentifier(const String& str)
 {
 	if (str.empty())
@@ -402,6 +442,7 @@ bool StyleSheetParser::ParseDecoratorBlock(const String& at_name, NamedDecorator
 
 bool StyleSheetParser::ParseMediaFeatureMap(const String& rules, PropertyDictionary& properties, MediaQueryModifier& modifier)
 {
+	std::lock_guard<std::mutex> lock(style_sheet_property_parsers->mutex);
 	style_sheet_property_parsers->media_query.SetTargetProperties(&properties);
 
 	enum ParseState { Global, Name, Value };
@@ -539,12 +580,14 @@ bool StyleSheetParser::Parse(MediaBlockList& style_sheets, Stream* _stream, int
 	// At-rules given by the following syntax in global space: @identifier name { block }
 	String at_rule_name;
 
+	static const DelimiterSet block_delimiters("{@}");
+
 	// Look for more styles while data is available
 	while (FillBuffer())
 	{
 		String pre_token_str;
 
-		while (char token = FindToken(pre_token_str, "{@}", true))
+		while (char token = FindToken(pre_token_str, block_delimiters, true))
 		{
 			switch (state)
 			{
@@ -632,6 +675,7 @@ bool StyleSheetParser::Parse(MediaBlockList& style_sheets, Stream* _stream, int
 					}
 					else if (at_rule_identifier == "spritesheet")
 					{
+						std::lock_guard<std::mutex> lock(style_sheet_property_parsers->mutex);
 						auto& spritesheet_property_parser = style_sheet_property_parsers->spritesheet;
 						ReadProperties(spritesheet_property_parser);
 
@@ -764,11 +808,13 @@ bool StyleSheetParser::Parse(MediaBlockList& style_sheets, Stream* _stream, int
 bool StyleSheetParser::ParseProperties(PropertyDictionary& parsed_properties, const String& properties)
 {
 	RMLUI_ASSERT(!stream);
-	StreamMemory stream_owner((const byte*)properties.c_str(), properties.size());
-	stream = &stream_owner;
+	// The properties are read directly from the string, there is no need to go through a stream.
+	parse_position = properties.data();
+	parse_end = properties.data() + properties.size();
 	PropertySpecificationParser parser(parsed_properties, StyleSheetSpecification::GetPropertySpecification());
 	bool success = ReadProperties(parser);
-	stream = nullptr;
+	parse_position = nullptr;
+	parse_end = nullptr;
 	return success;
 }
 
@@ -798,17 +844,23 @@ bool StyleSheetParser::ReadProperties(AbstractPropertyParser& property_parser)
 {
 	RMLUI_ZoneScoped;
 
+	static const DelimiterSet name_delimiters(";}:");
+	static const DelimiterSet value_delimiters(";}\"");
+	static const DelimiterSet quote_delimiters("\"}");
+
 	String name;
 	String value;
 
 	enum ParseState { NAME, VALUE, QUOTE };
 	ParseState state = NAME;
 
-	char character;
-	char previous_character = 0;
-	while (ReadCharacter(character))
+	while (true)
 	{
-		parse_buffer_pos++;
+		const char character = (state == NAME ? ReadUntil(name, name_delimiters) : ReadUntil(value, state == VALUE ? value_delimiters : quote_delimiters));
+		if (!character)
+			break;
+
+		parse_position++;
 
 		switch (state)
 		{
@@ -837,8 +889,6 @@ bool StyleSheetParser::ReadProperties(AbstractPropertyParser& property_parser)
 				name = StringUtilities::StripWhitespace(name);
 				state = VALUE;
 			}
-			else
-				name += character;
 		}
 		break;
 
@@ -856,23 +906,19 @@ bool StyleSheetParser::ReadProperties(AbstractPropertyParser& property_parser)
 				value.clear();
 				state = NAME;
 			}
-			else if (character == '}')
-			{
-				break;
-			}
-			else
+			else if (character == '"')
 			{
 				value += character;
-				if (character == '"')
-					state = QUOTE;
+				state = QUOTE;
 			}
 		}
 		break;
 
 		case QUOTE:
 		{
+			const bool escaped = (!value.empty() && value.back() == '\\');
 			value += character;
-			if (character == '"' && previous_character != '\\')
+			if (character == '"' && !escaped)
 				state = VALUE;
 		}
 		break;
@@ -880,7 +926,6 @@ bool StyleSheetParser::ReadProperties(AbstractPropertyParser& property_parser)
 
 		if (character == '}')
 			break;
-		previous_character = character;
 	}
 
 	if (state == VALUE && !name.empty() && !value.empty())
@@ -1042,98 +1087,75 @@ StyleSheetNode* StyleSheetParser::ImportProperties(StyleSheetNode* node, const S
 	return leaf_node;
 }
 
-char StyleSheetParser::FindToken(String& buffer, const char* tokens, bool remove_token)
+char StyleSheetParser::FindToken(String& buffer, const DelimiterSet& tokens, bool remove_token)
 {
 	buffer.clear();
-	char character;
-	while (ReadCharacter(character))
-	{
-		if (strchr(tokens, character) != nullptr)
-		{
-			if (remove_token)
-				parse_buffer_pos++;
-			return character;
-		}
-		else
-		{
-			buffer += character;
-			parse_buffer_pos++;
-		}
-	}
-
-	return 0;
+	const char token = ReadUntil(buffer, tokens);
+	if (token && remove_token)
+		parse_position++;
+	return token;
 }
 
-bool StyleSheetParser::ReadCharacter(char& buffer)
+char StyleSheetParser::ReadUntil(String& buffer, const DelimiterSet& delimiters)
 {
-	bool comment = false;
+	const char* it = parse_position;
+	const char* const end = parse_end;
+	char delimiter = 0;
 
-	// Continuously fill the buffer until either we run out of
-	// stream or we find the requested token
-	do
+	while (it != end)
 	{
-		while (parse_buffer_pos < parse_buffer.size())
-		{
-			if (parse_buffer[parse_buffer_pos] == '\n')
-				line_number++;
-			else if (comment)
-			{
-				// Check for closing comment
-				if (parse_buffer[parse_buffer_pos] == '*')
-				{
-					parse_buffer_pos++;
-					if (parse_buffer_pos >= parse_buffer.size())
-					{
-						if (!FillBuffer())
-							return false;
-					}
+		// Copy the whole run of ordinary characters at once.
+		const char* run_end = delimiters.Find(it, end);
+		buffer.append(it, run_end);
+		it = run_end;
 
-					if (parse_buffer[parse_buffer_pos] == '/')
-						comment = false;
-				}
-			}
-			else
+		if (it == end)
+			break;
+
+		const char character = *it;
+		if (character == '\n')
+		{
+			// Line breaks are not part of the content.
+			line_number++;
+			++it;
+		}
+		else if (character == '/' && it + 1 != end && it[1] == '*')
+		{
+			// Skip the comment, an unterminated comment runs until the end of the source.
+			const char* comment_end = it + 2;
+			while (true)
 			{
-				// Check for an opening comment
-				if (parse_buffer[parse_buffer_pos] == '/')
+				comment_end = static_cast<const char*>(memchr(comment_end, '*', end - comment_end));
+				if (!comment_end || comment_end + 1 == end)
 				{
-					parse_buffer_pos++;
-					if (parse_buffer_pos >= parse_buffer.size())
-					{
-						if (!FillBuffer())
-						{
-							buffer = '/';
-							parse_buffer = "/";
-							return true;
-						}
-					}
-
-					if (parse_buffer[parse_buffer_pos] == '*')
-						comment = true;
-					else
-					{
-						buffer = '/';
-						if (parse_buffer_pos == 0)
-							parse_buffer.insert(parse_buffer_pos, 1, '/');
-						else
-							parse_buffer_pos--;
-						return true;
-					}
+					comment_end = end;
+					break;
 				}
-
-				if (!comment)
+				if (comment_end[1] == '/')
 				{
-					// If we find a character, return it
-					buffer = parse_buffer[parse_buffer_pos];
-					return true;
+					comment_end += 2;
+					break;
 				}
+				++comment_end;
 			}
 
-			parse_buffer_pos++;
+			line_number += static_cast<int>(std::count(it, comment_end, '\n'));
+			it = comment_end;
 		}
-	} while (FillBuffer());
+		else if (delimiters.IsDelimiter(character))
+		{
+			delimiter = character;
+			break;
+		}
+		else
+		{
+			buffer += character;
+			++it;
+		}
+	}
 
-	return false;
+	parse_position = it;
+	return delimiter;
 }
 
 bool StyleSheetParser::FillBuffer()
@@ -1142,11 +1164,12 @@ bool StyleSheetParser::FillBuffer()
 	if (stream->IsEOS())
 		return false;
 
-	// Read in some data (4092 instead of 4096 to avoid the buffer growing when we have to add back
-	// a character after a failed comment parse.)
+	// Read all remaining data at once, so that it can be tokenized from contiguous memory.
 	parse_buffer.clear();
-	bool read = stream->Read(parse_buffer, 4092) > 0;
-	parse_buffer_pos = 0;
+	const size_t remaining = stream->Length() - stream->Tell();
+	bool read = stream->Read(parse_buffer, remaining) > 0;
+	parse_position = parse_buffer.data();
+	parse_end = parse_buffer.data() + parse_buffer.size();
 
 	return read;
 }
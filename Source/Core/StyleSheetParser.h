@@ -34,10 +34,12 @@
 
 namespace Rml {
 
+class PropertySpecification;
 class PropertyDictionary;
 class Stream;
 class StyleSheetNode;
 class AbstractPropertyParser;
+class DelimiterSet;
 struct PropertySource;
 using StyleSheetNodeListRaw = Vector<StyleSheetNode*>;
 
@@ -76,13 +78,17 @@ public:
 	// Reset property parsers.
 	static void Shutdown();
 
+	// Returns the specification of the properties admissible in @media queries.
+	static const PropertySpecification& GetMediaQuerySpecification();
+
 private:
 	// Stream we're parsing from.
 	Stream* stream;
-	// Parser memory buffer.
+	// Parser memory buffer, holds the entire contents of the stream.
 	String parse_buffer;
-	// How far we've read through the buffer.
-	size_t parse_buffer_pos;
+	// The source text being parsed, either located in the parse buffer or in external memory, and how far we've read through it.
+	const char* parse_position;
+	const char* parse_end;
 
 	// The name of the file we're parsing.
 	String stream_file_name;
@@ -116,16 +122,17 @@ private:
 	// Attempts to find one of the given character tokens in the active stream
 	// If it's found, buffer is filled with all content up until the token
 	// @param buffer The buffer that receives the content
-	// @param characters The character tokens to find
+	// @param tokens The set of character tokens to find
 	// @param remove_token If the token that caused the find to stop should be removed from the stream
-	char FindToken(String& buffer, const char* tokens, bool remove_token);
+	char FindToken(String& buffer, const DelimiterSet& tokens, bool remove_token);
 
-	// Attempts to find the next character in the active stream.
-	// If it's found, buffer is filled with the character
-	// @param buffer The buffer that receives the character, if read.
-	bool ReadCharacter(char& buffer);
+	// Appends all characters up until the next delimiter to the buffer, skipping comments and line breaks.
+	// @param buffer The buffer that receives the content
+	// @param delimiters The set of delimiters to find
+	// @return The delimiter found, which is not consumed, or zero if the end of the source was reached.
+	char ReadUntil(String& buffer, const DelimiterSet& delimiters);
 
-	// Fill the internal parse buffer
+	// Fill the internal parse buffer with the remaining contents of the stream
 	bool FillBuffer();
 };
 
@@ -30,6 +30,7 @@
 #include "../../Include/RmlUi/Core/ElementUtilities.h"
 #include "../../Include/RmlUi/Core/XMLParser.h"
 #include "XMLParseTools.h"
+#include "XMLPrototype.h"
 #include <string.h>
 
 namespace Rml {
@@ -112,7 +113,7 @@ Element* Template::ParseTemplate(Element* element)
 	body->Seek(0, SEEK_SET);
 
 	XMLParser parser(element);
-	parser.Parse(body.get());
+	XMLPrototype::Parse(parser, body.get(), XMLPrototype::CacheMode::Always);
 
 	// If theres an inject attribute on the template,
 	// attempt to find the required element
@@ -32,6 +32,7 @@
 #include "../../Include/RmlUi/Core/CallbackTexture.h"
 #include "../../Include/RmlUi/Core/StableVector.h"
 #include "../../Include/RmlUi/Core/Types.h"
+#include "BoxShadowCache.h"
 
 namespace Rml {
 
@@ -97,6 +98,7 @@ class TextureDatabase {
 public:
 	FileTextureDatabase file_database;
 	CallbackTextureDatabase callback_database;
+	BoxShadowCache box_shadow_cache;
 };
 
 } // namespace Rml
@@ -0,0 +1,188 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "ThreadPool.h"
+#include "../../Include/RmlUi/Core/Math.h"
+
+namespace Rml {
+
+static thread_local const ThreadPool* current_pool = nullptr;
+static thread_local int current_queue_index = -1;
+
+ThreadPool::ThreadPool(int num_threads)
+{
+	RMLUI_ASSERT(num_threads >= 0);
+	num_threads = Math::Max(num_threads, 0);
+
+	queues.reserve(num_threads + 1);
+	for (int i = 0; i < num_threads + 1; i++)
+		queues.push_back(MakeUnique<TaskQueue>());
+
+	threads.reserve(num_threads);
+	for (int i = 0; i < num_threads; i++)
+		threads.emplace_back(&ThreadPool::WorkerMain, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		shutdown = true;
+	}
+	wake_condition.notify_all();
+
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+void ThreadPool::Submit(Task task)
+{
+	// Count the task before making it available, so that the counters never drop below zero.
+	num_pending_tasks += 1;
+	num_queued_tasks += 1;
+
+	TaskQueue& queue = *queues[GetQueueIndex()];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.tasks.push_back(std::move(task));
+	}
+
+	{
+		// Lock to avoid a lost wake-up between the sleeping thread's condition check and its wait. The thread in Wait() is woken as well,
+		// so that it can help execute the new task.
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		if (!threads.empty())
+			wake_condition.notify_one();
+		done_condition.notify_one();
+	}
+}
+
+void ThreadPool::Wait()
+{
+	RMLUI_ASSERTMSG(current_pool != this, "ThreadPool::Wait() called from within a running task.");
+	const int queue_index = GetQueueIndex();
+
+	while (num_pending_tasks > 0)
+	{
+		Task task;
+		if (PopTask(queue_index, task))
+		{
+			RunTask(task);
+			continue;
+		}
+
+		// All remaining tasks are being executed by the workers.
+		std::unique_lock<std::mutex> lock(sleep_mutex);
+		done_condition.wait(lock, [this] { return num_pending_tasks == 0 || num_queued_tasks > 0; });
+	}
+}
+
+int ThreadPool::GetNumThreads() const
+{
+	return (int)threads.size();
+}
+
+int ThreadPool::GetQueueIndex() const
+{
+	if (current_pool == this)
+		return current_queue_index;
+	return (int)queues.size() - 1;
+}
+
+bool ThreadPool::PopTask(int queue_index, Task& out_task)
+{
+	if (num_queued_tasks == 0)
+		return false;
+
+	// Take the newest task from our own queue first, for locality.
+	{
+		TaskQueue& queue = *queues[queue_index];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.tasks.empty())
+		{
+			out_task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+			num_queued_tasks -= 1;
+			return true;
+		}
+	}
+
+	// Otherwise, steal the oldest task from another queue, these tend to represent the largest pieces of work.
+	const int num_queues = (int)queues.size();
+	for (int offset = 1; offset < num_queues; offset++)
+	{
+		TaskQueue& queue = *queues[(queue_index + offset) % num_queues];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.tasks.empty())
+		{
+			out_task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+			num_queued_tasks -= 1;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ThreadPool::RunTask(Task& task)
+{
+	task();
+
+	if (--num_pending_tasks == 0)
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		done_condition.notify_all();
+	}
+}
+
+void ThreadPool::WorkerMain(int queue_index)
+{
+	current_pool = this;
+	current_queue_index = queue_index;
+
+	while (true)
+	{
+		Task task;
+		if (PopTask(queue_index, task))
+		{
+			RunTask(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleep_mutex);
+		wake_condition.wait(lock, [this] { return shutdown || num_queued_tasks > 0; });
+		if (shutdown)
+			break;
+	}
+
+	current_pool = nullptr;
+	current_queue_index = -1;
+}
+
+} // namespace Rml
@@ -0,0 +1,97 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_THREADPOOL_H
+#define RMLUI_CORE_THREADPOOL_H
+
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Rml {
+
+/**
+    A work-stealing thread pool.
+
+    Each worker owns a task queue. Tasks submitted from within a running task are placed on the current worker's queue and executed in last-in
+    first-out order, while idle workers steal the oldest tasks from the other queues. This makes it well suited for recursively splitting work
+    over trees.
+ */
+
+class ThreadPool : NonCopyMoveable {
+public:
+	using Task = Function<void()>;
+
+	/// @param[in] num_threads The number of worker threads to spawn. The thread calling Wait() executes tasks as well.
+	explicit ThreadPool(int num_threads);
+	~ThreadPool();
+
+	/// Submits a task for execution. May be called from any thread, including from within running tasks.
+	void Submit(Task task);
+
+	/// Executes tasks on the calling thread until all submitted tasks have completed.
+	/// @note Must not be called from within a running task.
+	void Wait();
+
+	/// Returns the number of worker threads, not including the thread calling Wait().
+	int GetNumThreads() const;
+
+private:
+	struct TaskQueue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	// Returns the index of the queue owned by the calling thread.
+	int GetQueueIndex() const;
+
+	// Pops a task from the given queue, or steals one from any of the other queues.
+	bool PopTask(int queue_index, Task& out_task);
+	void RunTask(Task& task);
+
+	void WorkerMain(int queue_index);
+
+	// One queue per worker thread, and a final queue shared by all external threads.
+	Vector<UniquePtr<TaskQueue>> queues;
+	Vector<std::thread> threads;
+
+	std::atomic<int> num_queued_tasks{0};
+	std::atomic<int> num_pending_tasks{0};
+
+	std::mutex sleep_mutex;
+	std::condition_variable wake_condition;
+	std::condition_variable done_condition;
+	bool shutdown = false;
+};
+
+} // namespace Rml
+#endif
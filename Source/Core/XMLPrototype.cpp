@@ -0,0 +1,225 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "XMLPrototype.h"
+#include "../../Include/RmlUi/Core/Profiling.h"
+#include "../../Include/RmlUi/Core/Stream.h"
+#include "../../Include/RmlUi/Core/URL.h"
+#include "../../Include/RmlUi/Core/XMLParser.h"
+#include "../../Include/RmlUi/Core/Utilities.h"
+#include "ControlledLifetimeResource.h"
+#include <algorithm>
+#include <mutex>
+
+namespace Rml {
+
+// The least recently used prototypes are released when the cache grows beyond this number of prototypes, which bounds its memory usage.
+static constexpr size_t MaxNumCachedPrototypes = 256;
+// The number of recently parsed sources remembered for sources which are only cached when repeated.
+static constexpr size_t NumRememberedSources = 256;
+
+struct CachedPrototype {
+	size_t hash;
+	String url;
+	String source;
+	SharedPtr<const XMLPrototype> prototype;
+};
+
+struct XMLPrototypeCache {
+	std::mutex mutex;
+
+	// Ordered from most to least recently used.
+	List<CachedPrototype> prototypes;
+	UnorderedMap<size_t, List<CachedPrototype>::iterator> prototype_map;
+
+	// Ring buffer with the hashes of recently parsed sources which were not cached.
+	Vector<size_t> remembered_sources;
+	size_t remembered_sources_next = 0;
+};
+
+static ControlledLifetimeResource<XMLPrototypeCache> prototype_cache;
+
+static size_t HashSource(const String& url, const String& source)
+{
+	size_t seed = Hash<String>()(source);
+	Utilities::HashCombine(seed, url);
+	return seed;
+}
+
+void XMLPrototype::Initialize()
+{
+	prototype_cache.Initialize();
+}
+
+void XMLPrototype::Shutdown()
+{
+	prototype_cache.Shutdown();
+}
+
+void XMLPrototype::Parse(XMLParser& parser, Stream* stream, CacheMode cache_mode)
+{
+	RMLUI_ZoneScoped;
+
+	const URL& source_url = stream->GetSourceURL();
+
+	String source;
+	stream->Read(source, stream->Length());
+
+	// Handlers may resolve paths relative to the source URL, thus it is part of the key together with the source contents. The contents are
+	// always read so that any changes to the underlying file are picked up.
+	const size_t hash = HashSource(source_url.GetURL(), source);
+	bool record = (cache_mode == CacheMode::Always);
+
+	SharedPtr<const XMLPrototype> prototype;
+	{
+		std::lock_guard<std::mutex> lock(prototype_cache->mutex);
+
+		auto it = prototype_cache->prototype_map.find(hash);
+		if (it != prototype_cache->prototype_map.end() && it->second->source == source && it->second->url == source_url.GetURL())
+		{
+			prototype_cache->prototypes.splice(prototype_cache->prototypes.begin(), prototype_cache->prototypes, it->second);
+			prototype = it->second->prototype;
+		}
+		else if (cache_mode == CacheMode::WhenRepeated)
+		{
+			// Only record sources that have been parsed recently, dynamically generated contents are often unique and only used once.
+			Vector<size_t>& remembered = prototype_cache->remembered_sources;
+			record = (std::find(remembered.begin(), remembered.end(), hash) != remembered.end());
+			if (!record)
+			{
+				if (remembered.size() < NumRememberedSources)
+					remembered.push_back(hash);
+				else
+					remembered[prototype_cache->remembered_sources_next] = hash;
+				prototype_cache->remembered_sources_next = (prototype_cache->remembered_sources_next + 1) % NumRememberedSources;
+			}
+		}
+	}
+
+	if (prototype)
+	{
+		prototype->Replay(parser, source_url);
+		return;
+	}
+
+	auto new_prototype = (record ? MakeShared<XMLPrototype>() : nullptr);
+
+	parser.source_url = &source_url;
+	parser.xml_source = std::move(source);
+	parser.prototype_recording = new_prototype.get();
+
+	parser.ParseSource();
+
+	// Only sources that were parsed without errors are stored, so that any parse warnings are reported every time.
+	const bool parsed_completely = (parser.open_tag_depth == 0);
+
+	source = std::move(parser.xml_source);
+	parser.prototype_recording = nullptr;
+	parser.xml_source.clear();
+	parser.source_url = nullptr;
+
+	if (new_prototype && parsed_completely)
+	{
+		std::lock_guard<std::mutex> lock(prototype_cache->mutex);
+
+		auto it = prototype_cache->prototype_map.find(hash);
+		if (it != prototype_cache->prototype_map.end())
+		{
+			// Replace any entry with a colliding hash, or one added concurrently.
+			prototype_cache->prototypes.erase(it->second);
+			prototype_cache->prototype_map.erase(it);
+		}
+		else if (prototype_cache->prototypes.size() >= MaxNumCachedPrototypes)
+		{
+			prototype_cache->prototype_map.erase(prototype_cache->prototypes.back().hash);
+			prototype_cache->prototypes.pop_back();
+		}
+
+		prototype_cache->prototypes.push_front(CachedPrototype{hash, source_url.GetURL(), std::move(source), std::move(new_prototype)});
+		prototype_cache->prototype_map.emplace(hash, prototype_cache->prototypes.begin());
+	}
+}
+
+void XMLPrototype::ClearCache()
+{
+	if (!prototype_cache)
+		return;
+
+	std::lock_guard<std::mutex> lock(prototype_cache->mutex);
+	prototype_cache->prototypes.clear();
+	prototype_cache->prototype_map.clear();
+	prototype_cache->remembered_sources.clear();
+	prototype_cache->remembered_sources_next = 0;
+}
+
+size_t XMLPrototype::GetNumCachedPrototypes()
+{
+	if (!prototype_cache)
+		return 0;
+
+	std::lock_guard<std::mutex> lock(prototype_cache->mutex);
+	return prototype_cache->prototypes.size();
+}
+
+void XMLPrototype::RecordElementStart(const String& name, const XMLAttributes& attributes, int line_number)
+{
+	events.push_back(Event{EventType::ElementStart, XMLDataType::Text, line_number, line_number, name, attributes});
+}
+
+void XMLPrototype::RecordElementEnd(const String& name, int line_number, int line_number_open_tag)
+{
+	events.push_back(Event{EventType::ElementEnd, XMLDataType::Text, line_number, line_number_open_tag, name, XMLAttributes()});
+}
+
+void XMLPrototype::RecordData(const String& data, XMLDataType data_type, int line_number, int line_number_open_tag)
+{
+	events.push_back(Event{EventType::Data, data_type, line_number, line_number_open_tag, data, XMLAttributes()});
+}
+
+void XMLPrototype::Replay(BaseXMLParser& parser, const URL& source_url) const
+{
+	parser.source_url = &source_url;
+
+	for (const Event& event : events)
+	{
+		// Line numbers are restored for the handlers to report the same locations as during the original parse.
+		parser.line_number = event.line_number;
+		parser.line_number_open_tag = event.line_number_open_tag;
+
+		switch (event.type)
+		{
+		case EventType::ElementStart: parser.HandleElementStart(event.value, event.attributes); break;
+		case EventType::ElementEnd: parser.HandleElementEnd(event.value); break;
+		case EventType::Data: parser.HandleData(event.value, event.data_type); break;
+		}
+	}
+
+	parser.source_url = nullptr;
+}
+
+} // namespace Rml
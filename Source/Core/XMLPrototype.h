@@ -0,0 +1,94 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#ifndef RMLUI_CORE_XMLPROTOTYPE_H
+#define RMLUI_CORE_XMLPROTOTYPE_H
+
+#include "../../Include/RmlUi/Core/BaseXMLParser.h"
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+
+class XMLParser;
+
+/**
+    An immutable recording of everything the XML parser submits to its handlers for a given RML source.
+
+    The recording represents the flattened node tree of the source: element tags with their attributes, text data, and the
+    raw inner RML of structural data views. Replaying it into a new parser instances the same elements, without reading and
+    tokenizing the source again. Prototypes are cached by their full source, thus loading the same document repeatedly, or
+    instancing the same RML contents for each row of a data view, only tokenizes the source a limited number of times. The least
+    recently used prototypes are released once the cache is full.
+ */
+
+class XMLPrototype : NonCopyMoveable {
+public:
+	static void Initialize();
+	static void Shutdown();
+
+	enum class CacheMode {
+		Always,      // Record a prototype the first time the source is parsed, such as for documents and templates.
+		WhenRepeated // Only record a prototype when the same source was recently parsed, such as for dynamically generated inner RML.
+	};
+
+	/// Parses the stream with the given parser, replaying a previously recorded prototype of the same source if available.
+	/// Otherwise, the source is parsed as normal, while recording a new prototype for later use as determined by the cache mode.
+	static void Parse(XMLParser& parser, Stream* stream, CacheMode cache_mode);
+
+	/// Releases all cached prototypes.
+	static void ClearCache();
+
+	/// Returns the number of cached prototypes.
+	static size_t GetNumCachedPrototypes();
+
+	XMLPrototype() = default;
+
+	void RecordElementStart(const String& name, const XMLAttributes& attributes, int line_number);
+	void RecordElementEnd(const String& name, int line_number, int line_number_open_tag);
+	void RecordData(const String& data, XMLDataType data_type, int line_number, int line_number_open_tag);
+
+private:
+	void Replay(BaseXMLParser& parser, const URL& source_url) const;
+
+	enum class EventType : uint8_t { ElementStart, ElementEnd, Data };
+
+	struct Event {
+		EventType type;
+		XMLDataType data_type;
+		int line_number;
+		int line_number_open_tag;
+		String value;
+		XMLAttributes attributes;
+	};
+
+	Vector<Event> events;
+};
+
+} // namespace Rml
+#endif
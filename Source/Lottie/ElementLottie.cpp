@@ -36,14 +36,60 @@
 #include "../../Include/RmlUi/Core/PropertyIdSet.h"
 #include "../../Include/RmlUi/Core/RenderManager.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
+#include "../Core/ThreadPool.h"
+#include "LottieFrameCache.h"
+#include "LottiePlugin.h"
+#include <atomic>
 #include <cmath>
+#include <mutex>
 #include <rlottie.h>
 
 namespace Rml {
 
+/*
+    The mutex is held while the frame is rendered on the worker thread, thus the element can cancel the job or wait for its completion by
+    setting the cancelled flag under the lock.
+*/
+struct ElementLottie::AsyncFrame {
+	std::mutex mutex;
+	bool cancelled = false;
+	std::atomic<bool> done{false};
+
+	size_t frame = 0;
+	Vector2i dimensions;
+	size_t data_size = 0;
+	UniquePtr<byte[]> data;
+};
+
+// Renders the animation frame to the given buffer, with RmlUi's RGBA channel order.
+static void RenderFrame(rlottie::Animation& animation, size_t frame, byte* p_data, Vector2i dimensions)
+{
+	const size_t bytes_per_line = 4 * dimensions.x;
+	const size_t total_bytes = bytes_per_line * dimensions.y;
+
+	rlottie::Surface surface(reinterpret_cast<uint32_t*>(p_data), dimensions.x, dimensions.y, bytes_per_line);
+	animation.renderSync(frame, surface);
+
+	// Swizzle the channel order from rlottie's BGRA to RmlUi's RGBA.
+	for (size_t i = 0; i < total_bytes; i += 4)
+	{
+		// Swap the RB order for correct color channels.
+		std::swap(p_data[i], p_data[i + 2]);
+
+#ifdef RMLUI_DEBUG
+		const byte alpha = p_data[i + 3];
+		for (int c = 0; c < 3; c++)
+			RMLUI_ASSERTMSG(p_data[i + c] <= alpha, "Glyph data is assumed to be encoded in premultiplied alpha, but that is not the case.");
+#endif
+	}
+}
+
 ElementLottie::ElementLottie(const String& tag) : Element(tag) {}
 
-ElementLottie::~ElementLottie() {}
+ElementLottie::~ElementLottie()
+{
+	CancelAsyncFrame();
+}
 
 bool ElementLottie::GetIntrinsicDimensions(Vector2f& dimensions, float& ratio)
 {
@@ -76,7 +122,10 @@ void ElementLottie::OnUpdate()
 
 	double _unused;
 	const double frame_duration = 1.0 / animation->frameRate();
-	const double delay = std::modf((t - time_animation_start) / frame_duration, &_unused) * frame_duration;
+	double delay = std::modf((t - time_animation_start) / frame_duration, &_unused) * frame_duration;
+	if (async_frame_pending)
+		delay = 0;
+
 	if (IsVisible(true))
 	{
 		if (Context* ctx = GetContext())
@@ -92,7 +141,8 @@ void ElementLottie::OnRender()
 			GenerateGeometry();
 
 		UpdateTexture();
-		geometry.Render(GetAbsoluteOffset(BoxArea::Content).Round(), texture);
+		if (texture)
+			geometry.Render(GetAbsoluteOffset(BoxArea::Content).Round(), texture);
 	}
 }
 
@@ -143,6 +193,9 @@ bool ElementLottie::LoadAnimation()
 	animation_dirty = false;
 	intrinsic_dimensions = Vector2f{};
 	texture = {};
+	CancelAsyncFrame();
+	frames.reset();
+	animation_source.clear();
 	animation.reset();
 	prev_animation_frame = size_t(-1);
 	time_animation_start = -1;
@@ -183,6 +236,8 @@ bool ElementLottie::LoadAnimation()
 	intrinsic_dimensions.x = float(width);
 	intrinsic_dimensions.y = float(height);
 
+	animation_source = path;
+
 	return true;
 }
 
@@ -195,6 +250,31 @@ void ElementLottie::UpdateTexture()
 	if (!render_manager)
 		return;
 
+	if (async_frame_pending)
+	{
+		// Keep displaying the previous frame until the next one is ready.
+		if (!async_frame->done)
+			return;
+
+		// Swap the rendered frame into the front buffer, and make a texture from it.
+		std::swap(texture_data, async_frame->data);
+		std::swap(texture_data_size, async_frame->data_size);
+		async_frame_pending = false;
+
+		const Vector2i frame_dimensions = async_frame->dimensions;
+		if (frames && frames->GetDimensions() == frame_dimensions)
+			frames->Store(async_frame->frame, texture_data.get());
+		texture = render_manager->MakeCallbackTexture([this, frame_dimensions](const CallbackTextureInterface& texture_interface) -> bool {
+			const size_t total_bytes = 4 * frame_dimensions.x * frame_dimensions.y;
+			if (!texture_interface.GenerateTexture({texture_data.get(), total_bytes}, frame_dimensions))
+			{
+				Log::Message(Rml::Log::Type::LT_WARNING, "Could not generate texture for lottie animation: %s", GetAttribute<String>("src", "").c_str());
+				return false;
+			}
+			return true;
+		});
+	}
+
 	const double t = GetSystemInterface()->GetElapsedTime();
 
 	// Find the next animation frame to display.
@@ -210,8 +290,43 @@ void ElementLottie::UpdateTexture()
 		return;
 	}
 
-	// Resize the texture buffer if necessary.
+	if (!frames || frames->GetDimensions() != render_dimensions)
+		frames = Lottie::LottieFrameCache::GetFrames(animation_source, animation->totalFrame(), render_dimensions);
+
 	const size_t new_texture_data_size = 4 * render_dimensions.x * render_dimensions.y;
+
+	// Frames available in the cache are decoded directly, there is no need to render them on the worker thread.
+	ThreadPool* worker = Lottie::GetAsyncRenderWorker();
+	if (worker && !(frames && frames->Contains(next_frame)))
+	{
+		if (!async_frame)
+			async_frame = MakeShared<AsyncFrame>();
+
+		if (new_texture_data_size > async_frame->data_size)
+		{
+			async_frame->data.reset(new byte[new_texture_data_size]);
+			async_frame->data_size = new_texture_data_size;
+		}
+
+		async_frame->frame = next_frame;
+		async_frame->dimensions = render_dimensions;
+		async_frame->done = false;
+		async_frame_pending = true;
+
+		worker->Submit([frame = async_frame, animation = animation.get()]() {
+			std::lock_guard<std::mutex> lock(frame->mutex);
+			if (frame->cancelled)
+				return;
+			RenderFrame(*animation, frame->frame, frame->data.get(), frame->dimensions);
+			frame->done = true;
+		});
+
+		prev_animation_frame = next_frame;
+		texture_size_dirty = false;
+		return;
+	}
+
+	// Resize the texture buffer if necessary.
 	if (new_texture_data_size > texture_data_size)
 	{
 		texture_data.reset(new byte[new_texture_data_size]);
@@ -222,24 +337,15 @@ void ElementLottie::UpdateTexture()
 	auto texture_callback = [this, next_frame](const CallbackTextureInterface& texture_interface) -> bool {
 		RMLUI_ASSERT(animation);
 
-		const size_t bytes_per_line = 4 * render_dimensions.x;
-		const size_t total_bytes = bytes_per_line * render_dimensions.y;
+		const size_t total_bytes = 4 * render_dimensions.x * render_dimensions.y;
 		byte* p_data = texture_data.get();
 
-		rlottie::Surface surface(reinterpret_cast<uint32_t*>(p_data), render_dimensions.x, render_dimensions.y, bytes_per_line);
-		animation->renderSync(next_frame, surface);
-
-		// Swizzle the channel order from rlottie's BGRA to RmlUi's RGBA.
-		for (size_t i = 0; i < total_bytes; i += 4)
+		const bool use_frame_cache = (frames && frames->GetDimensions() == render_dimensions);
+		if (!use_frame_cache || !frames->Read(next_frame, p_data))
 		{
-			// Swap the RB order for correct color channels.
-			std::swap(p_data[i], p_data[i + 2]);
-
-#ifdef RMLUI_DEBUG
-			const byte alpha = p_data[i + 3];
-			for (int c = 0; c < 3; c++)
-				RMLUI_ASSERTMSG(p_data[i + c] <= alpha, "Glyph data is assumed to be encoded in premultiplied alpha, but that is not the case.");
-#endif
+			RenderFrame(*animation, next_frame, p_data, render_dimensions);
+			if (use_frame_cache)
+				frames->Store(next_frame, p_data);
 		}
 
 		if (!texture_interface.GenerateTexture({p_data, total_bytes}, render_dimensions))
@@ -256,4 +362,15 @@ void ElementLottie::UpdateTexture()
 	texture_size_dirty = false;
 }
 
+void ElementLottie::CancelAsyncFrame()
+{
+	if (async_frame)
+	{
+		std::lock_guard<std::mutex> lock(async_frame->mutex);
+		async_frame->cancelled = true;
+	}
+	async_frame.reset();
+	async_frame_pending = false;
+}
+
 } // namespace Rml
@@ -0,0 +1,219 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#include "LottieFrameCache.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/StringUtilities.h"
+#include "../Core/ControlledLifetimeResource.h"
+#include <string.h>
+
+namespace Rml {
+namespace Lottie {
+
+	struct LottieFrameCacheData {
+		UnorderedMap<String, WeakPtr<LottieFrames>> frames;
+		size_t memory_usage = 0;
+	};
+
+	static ControlledLifetimeResource<LottieFrameCacheData> frame_cache_data;
+	static size_t frame_cache_budget = 0;
+
+	LottieFrames::LottieFrames(size_t num_frames, Vector2i dimensions) : dimensions(dimensions), frames(num_frames) {}
+
+	LottieFrames::~LottieFrames()
+	{
+		LottieFrameCache::RemoveMemoryUsage(memory_usage);
+	}
+
+	bool LottieFrames::Contains(size_t frame) const
+	{
+		return frame < frames.size() && !frames[frame].data.empty();
+	}
+
+	bool LottieFrames::Read(size_t frame, byte* destination) const
+	{
+		if (!Contains(frame))
+			return false;
+
+		const EncodedFrame& encoded = frames[frame];
+		const size_t num_pixels = size_t(dimensions.x * dimensions.y);
+
+		if (!encoded.run_length_encoded)
+		{
+			memcpy(destination, encoded.data.data(), num_pixels * sizeof(uint32_t));
+			return true;
+		}
+
+		uint32_t* out = reinterpret_cast<uint32_t*>(destination);
+		for (size_t i = 0; i < encoded.data.size(); i += 2)
+		{
+			const uint32_t run_length = encoded.data[i];
+			const uint32_t pixel = encoded.data[i + 1];
+			for (uint32_t j = 0; j < run_length; j++)
+				out[j] = pixel;
+			out += run_length;
+		}
+
+		RMLUI_ASSERT(out == reinterpret_cast<uint32_t*>(destination) + num_pixels);
+		return true;
+	}
+
+	void LottieFrames::Store(size_t frame, const byte* source)
+	{
+		if (frame >= frames.size() || Contains(frame))
+			return;
+
+		const size_t num_pixels = size_t(dimensions.x * dimensions.y);
+		if (num_pixels == 0)
+			return;
+
+		// Once the budget is exhausted, avoid encoding frames that will not be stored anyway. Encoding is also stopped as soon as the encoded
+		// frame exceeds the remaining budget, or is no smaller than the raw pixels.
+		const size_t budget_size = LottieFrameCache::GetRemainingBudget() / sizeof(uint32_t);
+		if (budget_size == 0)
+			return;
+		const size_t max_encoded_size = Math::Min(num_pixels - 1, budget_size);
+
+		// Encode into a scratch buffer first, so that the stored frame can be allocated at its final size.
+		static thread_local Vector<uint32_t> scratch_data;
+		scratch_data.resize(max_encoded_size);
+
+		const uint32_t* pixels = reinterpret_cast<const uint32_t*>(source);
+		size_t encoded_size = 0;
+		bool run_length_encoded = true;
+
+		for (size_t i = 0; i < num_pixels;)
+		{
+			if (encoded_size + 2 > max_encoded_size)
+			{
+				run_length_encoded = false;
+				break;
+			}
+
+			const uint32_t pixel = pixels[i];
+			size_t run_end = i + 1;
+			while (run_end < num_pixels && pixels[run_end] == pixel)
+				run_end += 1;
+
+			scratch_data[encoded_size++] = uint32_t(run_end - i);
+			scratch_data[encoded_size++] = pixel;
+			i = run_end;
+		}
+
+		if (!run_length_encoded && num_pixels > budget_size)
+			return;
+
+		EncodedFrame encoded;
+		encoded.run_length_encoded = run_length_encoded;
+		if (run_length_encoded)
+			encoded.data.assign(scratch_data.begin(), scratch_data.begin() + encoded_size);
+		else
+			encoded.data.assign(pixels, pixels + num_pixels);
+
+		const size_t bytes = encoded.data.size() * sizeof(uint32_t);
+		if (!LottieFrameCache::AddMemoryUsage(bytes))
+			return;
+
+		memory_usage += bytes;
+		frames[frame] = std::move(encoded);
+	}
+
+	void LottieFrameCache::Initialize()
+	{
+		frame_cache_data.Initialize();
+	}
+
+	void LottieFrameCache::Shutdown()
+	{
+		frame_cache_data.Shutdown();
+	}
+
+	SharedPtr<LottieFrames> LottieFrameCache::GetFrames(const String& source, size_t num_frames, Vector2i dimensions)
+	{
+		if (frame_cache_budget == 0 || source.empty() || num_frames == 0 || dimensions.x <= 0 || dimensions.y <= 0)
+			return nullptr;
+
+		const String key = CreateString("%s|%dx%d", source.c_str(), dimensions.x, dimensions.y);
+
+		auto& frames_map = frame_cache_data->frames;
+
+		auto it_entry = frames_map.find(key);
+		if (it_entry != frames_map.end())
+		{
+			if (SharedPtr<LottieFrames> frames = it_entry->second.lock())
+				return frames;
+		}
+
+		// Remove expired entries while we are here.
+		for (auto it = frames_map.begin(); it != frames_map.end();)
+		{
+			if (it->second.expired())
+				it = frames_map.erase(it);
+			else
+				++it;
+		}
+
+		auto frames = MakeShared<LottieFrames>(num_frames, dimensions);
+		frames_map[key] = frames;
+		return frames;
+	}
+
+	void LottieFrameCache::SetBudget(size_t budget)
+	{
+		frame_cache_budget = budget;
+	}
+
+	size_t LottieFrameCache::GetRemainingBudget()
+	{
+		const size_t memory_usage = frame_cache_data->memory_usage;
+		return (memory_usage < frame_cache_budget ? frame_cache_budget - memory_usage : 0);
+	}
+
+	bool LottieFrameCache::AddMemoryUsage(size_t bytes)
+	{
+		size_t& memory_usage = frame_cache_data->memory_usage;
+		if (memory_usage + bytes > frame_cache_budget)
+			return false;
+		memory_usage += bytes;
+		return true;
+	}
+
+	void LottieFrameCache::RemoveMemoryUsage(size_t bytes)
+	{
+		if (frame_cache_data)
+			frame_cache_data->memory_usage -= bytes;
+	}
+
+	void SetFrameCacheBudget(size_t budget)
+	{
+		LottieFrameCache::SetBudget(budget);
+	}
+
+} // namespace Lottie
+} // namespace Rml
@@ -0,0 +1,104 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#ifndef RMLUI_LOTTIE_LOTTIE_FRAME_CACHE_H
+#define RMLUI_LOTTIE_LOTTIE_FRAME_CACHE_H
+
+#include "../../Include/RmlUi/Core/Traits.h"
+#include "../../Include/RmlUi/Core/Types.h"
+
+namespace Rml {
+namespace Lottie {
+
+	/*
+	    Rendered frames of an animation at a given size, shared between all elements displaying the animation at this size.
+
+	    Frames are stored run-length encoded, which is effective for the large uniform areas common in vector animations. Falls back to raw
+	    pixels for frames that do not compress.
+	*/
+	class LottieFrames : NonCopyMoveable {
+	public:
+		LottieFrames(size_t num_frames, Vector2i dimensions);
+		~LottieFrames();
+
+		Vector2i GetDimensions() const { return dimensions; }
+
+		/// Returns true if the given frame is available in the cache.
+		bool Contains(size_t frame) const;
+
+		/// Decodes a cached frame.
+		/// @param[out] destination A buffer of 4 * width * height bytes.
+		/// @return False if the frame is not cached.
+		bool Read(size_t frame, byte* destination) const;
+
+		/// Stores a rendered frame, unless it is already cached or the memory budget is exhausted.
+		/// @param[in] source The frame pixels, 4 * width * height bytes.
+		void Store(size_t frame, const byte* source);
+
+	private:
+		struct EncodedFrame {
+			bool run_length_encoded = false;
+			// Pairs of [run length, pixel] when run-length encoded, otherwise the raw pixels.
+			Vector<uint32_t> data;
+		};
+
+		Vector2i dimensions;
+		Vector<EncodedFrame> frames;
+		size_t memory_usage = 0;
+	};
+
+	/**
+	    Plugin-level cache of rendered animation frames, subject to a global memory budget.
+
+	    Frames are kept for as long as any element uses them. When the budget is exhausted, new frames are no longer stored instead of evicting
+	    older ones: looping playback visits every frame in order, so evicting the oldest frame would always discard the one needed next.
+	 */
+	class LottieFrameCache {
+	public:
+		static void Initialize();
+		static void Shutdown();
+
+		/// Returns the shared frames of the given animation at the given dimensions, or null if the frame cache is disabled.
+		static SharedPtr<LottieFrames> GetFrames(const String& source, size_t num_frames, Vector2i dimensions);
+
+		/// Sets the total memory budget in bytes for all cached frames, zero disables the cache.
+		static void SetBudget(size_t budget);
+
+	private:
+		// Returns the number of bytes which can still be added within the budget.
+		static size_t GetRemainingBudget();
+		// Adjusts the global memory usage, returns false if the increase does not fit within the budget.
+		static bool AddMemoryUsage(size_t bytes);
+		static void RemoveMemoryUsage(size_t bytes);
+		friend class LottieFrames;
+	};
+
+} // namespace Lottie
+} // namespace Rml
+#endif
@@ -32,14 +32,22 @@
 #include "../../Include/RmlUi/Core/Log.h"
 #include "../../Include/RmlUi/Core/Plugin.h"
 #include "../../Include/RmlUi/Lottie/ElementLottie.h"
+#include "../Core/ThreadPool.h"
+#include "LottieFrameCache.h"
+#include "LottiePlugin.h"
 
 namespace Rml {
 namespace Lottie {
 
+	static bool async_rendering_enabled = false;
+	static UniquePtr<ThreadPool> async_render_worker;
+
 	class LottiePlugin : public Plugin {
 	public:
 		void OnInitialise() override
 		{
+			LottieFrameCache::Initialize();
+
 			instancer = MakeUnique<ElementInstancerGeneric<ElementLottie>>();
 
 			Factory::RegisterElementInstancer("lottie", instancer.get());
@@ -47,7 +55,12 @@ namespace Lottie {
 			Log::Message(Log::LT_INFO, "Lottie plugin initialised.");
 		}
 
-		void OnShutdown() override { delete this; }
+		void OnShutdown() override
+		{
+			async_render_worker.reset();
+			LottieFrameCache::Shutdown();
+			delete this;
+		}
 
 		int GetEventClasses() override { return Plugin::EVT_BASIC; }
 
@@ -60,5 +73,19 @@ namespace Lottie {
 		RegisterPlugin(new LottiePlugin);
 	}
 
+	void SetAsyncRenderingEnabled(bool enable)
+	{
+		async_rendering_enabled = enable;
+	}
+
+	ThreadPool* GetAsyncRenderWorker()
+	{
+		if (!async_rendering_enabled)
+			return nullptr;
+		if (!async_render_worker)
+			async_render_worker = MakeUnique<ThreadPool>(1);
+		return async_render_worker.get();
+	}
+
 } // namespace Lottie
 } // namespace Rml
@@ -30,10 +30,16 @@
 #define RMLUI_LOTTIE_LOTTIE_PLUGIN_H
 
 namespace Rml {
+
+class ThreadPool;
+
 namespace Lottie {
 
 	void Initialise();
 
+	// Returns the worker for rendering animation frames, or null if asynchronous rendering is disabled.
+	ThreadPool* GetAsyncRenderWorker();
+
 }
 } // namespace Rml
 
@@ -28,6 +28,7 @@
 
 #include "../../Include/RmlUi/SVG/ElementSVG.h"
 #include "../../Include/RmlUi/Core/ComputedValues.h"
+#include "../../Include/RmlUi/Core/Context.h"
 #include "../../Include/RmlUi/Core/Core.h"
 #include "../../Include/RmlUi/Core/ElementDocument.h"
 #include "../../Include/RmlUi/Core/FileInterface.h"
@@ -36,9 +37,7 @@
 #include "../../Include/RmlUi/Core/PropertyIdSet.h"
 #include "../../Include/RmlUi/Core/RenderManager.h"
 #include "../../Include/RmlUi/Core/SystemInterface.h"
-#include <cmath>
-#include <lunasvg.h>
-#include <string.h>
+#include "SVGCache.h"
 
 namespace Rml {
 
@@ -73,15 +72,28 @@ void ElementSVG::EnsureSourceLoaded()
 		LoadSource();
 }
 
+void ElementSVG::OnUpdate()
+{
+	if (pending_raster)
+	{
+		if (Context* ctx = GetContext())
+			ctx->RequestNextUpdate(0);
+	}
+}
+
 void ElementSVG::OnRender()
 {
 	if (svg_document)
 	{
+		UpdateTexture();
+
+		if (!raster)
+			return;
+
 		if (geometry_dirty)
 			GenerateGeometry();
 
-		UpdateTexture();
-		geometry.Render(GetAbsoluteOffset(BoxArea::Content), Texture(texture));
+		geometry.Render(GetAbsoluteOffset(BoxArea::Content), raster->GetTexture());
 	}
 }
 
@@ -122,11 +134,15 @@ void ElementSVG::GenerateGeometry()
 	const ComputedValues& computed = GetComputedValues();
 	ColourbPremultiplied quad_colour = computed.image_color().ToPremultiplied(computed.opacity());
 
-	const Vector2f render_dimensions_f = GetBox().GetSize(BoxArea::Content).Round();
-	render_dimensions = Vector2i(render_dimensions_f);
+	Vector2f tex_coord_top_left(0.f), tex_coord_bottom_right(1.f);
+	if (raster)
+	{
+		tex_coord_top_left = raster->GetTexCoordTopLeft();
+		tex_coord_bottom_right = raster->GetTexCoordBottomRight();
+	}
 
 	Mesh mesh = geometry.Release(Geometry::ReleaseMode::ClearMesh);
-	MeshUtilities::GenerateQuad(mesh, Vector2f(0), render_dimensions_f, quad_colour, Vector2f(0), Vector2f(1));
+	MeshUtilities::GenerateQuad(mesh, Vector2f(0), Vector2f(render_dimensions), quad_colour, tex_coord_top_left, tex_coord_bottom_right);
 	geometry = GetRenderManager()->MakeGeometry(std::move(mesh));
 
 	geometry_dirty = false;
@@ -137,7 +153,8 @@ bool ElementSVG::LoadSource()
 	source_dirty = false;
 	texture_dirty = true;
 	intrinsic_dimensions = Vector2f{};
-	texture = {};
+	raster.reset();
+	pending_raster.reset();
 	svg_document.reset();
 
 	const String attribute_src = GetAttribute<String>("src", "");
@@ -155,64 +172,46 @@ bool ElementSVG::LoadSource()
 		GetSystemInterface()->JoinPath(directory, document_source_url, "");
 	}
 
-	String svg_data;
-
-	if (path.empty() || !GetFileInterface()->LoadFile(path, svg_data))
-	{
-		Log::Message(Rml::Log::Type::LT_WARNING, "Could not load SVG file %s", path.c_str());
-		return false;
-	}
-
-	// We use a reset-release approach here in case clients use a non-std unique_ptr (lunasvg uses std::unique_ptr)
-	svg_document.reset(lunasvg::Document::loadFromData(svg_data).release());
-
+	svg_document = SVG::SVGCache::GetDocument(path);
 	if (!svg_document)
-	{
-		Log::Message(Rml::Log::Type::LT_WARNING, "Could not load SVG data from file %s", path.c_str());
 		return false;
-	}
 
-	intrinsic_dimensions.x = Math::Max(float(svg_document->width()), 1.0f);
-	intrinsic_dimensions.y = Math::Max(float(svg_document->height()), 1.0f);
+	intrinsic_dimensions = svg_document->intrinsic_dimensions;
 
 	return true;
 }
 
 void ElementSVG::UpdateTexture()
 {
-	if (!svg_document || !texture_dirty)
+	if (!svg_document)
 		return;
 
-	RenderManager* render_manager = GetRenderManager();
-	if (!render_manager)
-		return;
+	if (texture_dirty)
+	{
+		RenderManager* render_manager = GetRenderManager();
+		if (!render_manager)
+			return;
+
+		render_dimensions = Vector2i(GetBox().GetSize(BoxArea::Content).Round());
 
-	// Callback for generating texture.
-	auto texture_callback = [this](const CallbackTextureInterface& texture_interface) -> bool {
-		RMLUI_ASSERT(svg_document);
-		lunasvg::Bitmap bitmap = svg_document->renderToBitmap(render_dimensions.x, render_dimensions.y);
-		if (!bitmap.valid() || !bitmap.data())
-		{
-			Log::Message(Rml::Log::Type::LT_WARNING, "Could not render SVG to bitmap: %s", GetAttribute<String>("src", "").c_str());
-			return false;
-		}
-
-		// Swap red and blue channels, assuming LunaSVG v2.3.2 or newer, to convert to RmlUi's expected RGBA-ordering.
-		const size_t bitmap_byte_size = bitmap.width() * bitmap.height() * 4;
-		uint8_t* bitmap_data = bitmap.data();
-		for (size_t i = 0; i < bitmap_byte_size; i += 4)
-			std::swap(bitmap_data[i], bitmap_data[i + 2]);
-
-		if (!texture_interface.GenerateTexture({reinterpret_cast<const Rml::byte*>(bitmap.data()), bitmap_byte_size}, render_dimensions))
-		{
-			Log::Message(Rml::Log::Type::LT_WARNING, "Could not generate texture for SVG: %s", GetAttribute<String>("src", "").c_str());
-			return false;
-		}
-		return true;
-	};
-
-	texture = render_manager->MakeCallbackTexture(std::move(texture_callback));
-	texture_dirty = false;
+		if (render_dimensions.x > 0 && render_dimensions.y > 0)
+			pending_raster = SVG::SVGCache::GetRaster(*render_manager, svg_document, render_dimensions);
+		else
+			pending_raster.reset();
+
+		// Keep displaying the current rasterization until an asynchronous one is ready.
+		if (!pending_raster || pending_raster->IsReady())
+			raster = std::move(pending_raster);
+
+		// The texture coordinates may have changed with the new rasterization.
+		geometry_dirty = true;
+		texture_dirty = false;
+	}
+	else if (pending_raster && pending_raster->IsReady())
+	{
+		raster = std::move(pending_raster);
+		geometry_dirty = true;
+	}
 }
 
 } // namespace Rml
@@ -0,0 +1,389 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#include "SVGCache.h"
+#include "../../Include/RmlUi/Core/Core.h"
+#include "../../Include/RmlUi/Core/FileInterface.h"
+#include "../../Include/RmlUi/Core/Log.h"
+#include "../../Include/RmlUi/Core/Math.h"
+#include "../../Include/RmlUi/Core/RenderManager.h"
+#include "../../Include/RmlUi/SVG/ElementSVG.h"
+#include "../Core/ControlledLifetimeResource.h"
+#include "../Core/ThreadPool.h"
+#include <algorithm>
+#include <lunasvg.h>
+#include <string.h>
+
+namespace Rml {
+namespace SVG {
+
+	// Rasterizations no larger than this in either dimension are packed into atlas pages, when enabled.
+	static constexpr int atlas_max_item_size = 64;
+	static constexpr int atlas_page_size = 512;
+	// Transparent spacing between atlas items, avoids bleeding between neighbors during texture filtering.
+	static constexpr int atlas_item_spacing = 1;
+
+	/*
+	    A texture shared by multiple small rasterizations, packed into horizontal shelves.
+
+	    Regions are not re-used after being released, instead the page is released once all of its regions are released.
+	*/
+	class AtlasPage : NonCopyMoveable {
+	public:
+		AtlasPage(RenderManager* render_manager) : render_manager(render_manager), pixels(atlas_page_size * atlas_page_size * 4, 0) {}
+
+		// Finds a free region of the given size, returns false if there is no room left in this page.
+		bool Allocate(Vector2i dimensions, Vector2i& out_position)
+		{
+			const Vector2i size = dimensions + Vector2i(atlas_item_spacing);
+
+			// Find the shelf with the least wasted height which has room for the item.
+			Shelf* best_shelf = nullptr;
+			for (Shelf& shelf : shelves)
+			{
+				if (shelf.height >= size.y && shelf.x + size.x <= atlas_page_size && (!best_shelf || shelf.height < best_shelf->height))
+					best_shelf = &shelf;
+			}
+
+			if (!best_shelf)
+			{
+				const int y = (shelves.empty() ? 0 : shelves.back().y + shelves.back().height);
+				if (y + size.y > atlas_page_size || size.x > atlas_page_size)
+					return false;
+
+				shelves.push_back(Shelf{y, size.y, 0});
+				best_shelf = &shelves.back();
+			}
+
+			out_position = Vector2i(best_shelf->x, best_shelf->y);
+			best_shelf->x += size.x;
+			return true;
+		}
+
+		Texture GetTexture()
+		{
+			if (texture_dirty)
+			{
+				texture = render_manager->MakeCallbackTexture([this](const CallbackTextureInterface& texture_interface) -> bool {
+					return texture_interface.GenerateTexture(pixels, Vector2i(atlas_page_size));
+				});
+				texture_dirty = false;
+			}
+			return texture;
+		}
+
+		RenderManager* render_manager;
+		Vector<byte> pixels;
+		int num_regions = 0;
+		bool texture_dirty = true;
+
+	private:
+		struct Shelf {
+			int y, height, x;
+		};
+		Vector<Shelf> shelves;
+		CallbackTexture texture;
+	};
+
+	/*
+	    Rasterization of a document on the worker thread.
+
+	    The mutex is held while the job is executed, thus the owning raster can cancel the job or wait for its completion by setting the
+	    cancelled flag under the lock. This ensures that the document outlives any work done on it.
+	*/
+	struct AsyncRasterJob {
+		std::mutex mutex;
+		bool cancelled = false;
+		bool success = false;
+		lunasvg::Bitmap bitmap;
+		std::atomic<bool> done{false};
+	};
+
+	struct SVGCacheData {
+		UnorderedMap<String, WeakPtr<SVGDocument>> documents;
+		UnorderedMap<const SVGDocument*, Vector<WeakPtr<SVGRaster>>> rasters;
+		Vector<UniquePtr<AtlasPage>> atlas_pages;
+		UniquePtr<ThreadPool> worker;
+	};
+
+	static ControlledLifetimeResource<SVGCacheData> svg_cache_data;
+	static bool atlas_enabled = false;
+	static bool async_enabled = false;
+
+	// Renders the document to a bitmap with RGBA-ordered, premultiplied pixels. Safe to call from any thread.
+	static bool RasterizeDocument(SVGDocument& document, Vector2i dimensions, lunasvg::Bitmap& out_bitmap)
+	{
+		{
+			std::lock_guard<std::mutex> lock(document.render_mutex);
+			out_bitmap = document.document->renderToBitmap(dimensions.x, dimensions.y);
+		}
+		if (!out_bitmap.valid() || !out_bitmap.data())
+			return false;
+
+		// Swap red and blue channels, assuming LunaSVG v2.3.2 or newer, to convert to RmlUi's expected RGBA-ordering.
+		const size_t bitmap_byte_size = out_bitmap.height() * out_bitmap.stride();
+		uint8_t* bitmap_data = out_bitmap.data();
+		for (size_t i = 0; i < bitmap_byte_size; i += 4)
+			std::swap(bitmap_data[i], bitmap_data[i + 2]);
+
+		return true;
+	}
+
+	SVGDocument::~SVGDocument()
+	{
+		if (svg_cache_data)
+			svg_cache_data->rasters.erase(this);
+	}
+
+	SVGRaster::~SVGRaster()
+	{
+		if (async_job)
+		{
+			// Cancel the job if it has not started yet, otherwise wait for it to complete.
+			std::lock_guard<std::mutex> lock(async_job->mutex);
+			async_job->cancelled = true;
+		}
+
+		if (atlas_page)
+			SVGCache::ReleaseAtlasRegion(atlas_page);
+	}
+
+	bool SVGRaster::IsReady() const
+	{
+		return !async_job || async_job->done;
+	}
+
+	Texture SVGRaster::GetTexture()
+	{
+		if (atlas_page)
+			return atlas_page->GetTexture();
+		return texture;
+	}
+
+	void SVGCache::Initialize()
+	{
+		svg_cache_data.Initialize();
+	}
+
+	void SVGCache::Shutdown()
+	{
+		svg_cache_data.Shutdown();
+	}
+
+	SharedPtr<SVGDocument> SVGCache::GetDocument(const String& path)
+	{
+		auto& documents = svg_cache_data->documents;
+
+		auto it = documents.find(path);
+		if (it != documents.end())
+		{
+			if (SharedPtr<SVGDocument> document = it->second.lock())
+				return document;
+		}
+
+		String svg_data;
+		if (path.empty() || !GetFileInterface()->LoadFile(path, svg_data))
+		{
+			Log::Message(Rml::Log::Type::LT_WARNING, "Could not load SVG file %s", path.c_str());
+			return nullptr;
+		}
+
+		auto document = MakeShared<SVGDocument>();
+		document->source = path;
+
+		// We use a reset-release approach here in case clients use a non-std unique_ptr (lunasvg uses std::unique_ptr)
+		document->document.reset(lunasvg::Document::loadFromData(svg_data).release());
+
+		if (!document->document)
+		{
+			Log::Message(Rml::Log::Type::LT_WARNING, "Could not load SVG data from file %s", path.c_str());
+			return nullptr;
+		}
+
+		document->intrinsic_dimensions.x = Math::Max(float(document->document->width()), 1.0f);
+		document->intrinsic_dimensions.y = Math::Max(float(document->document->height()), 1.0f);
+
+		documents[path] = document;
+		return document;
+	}
+
+	SharedPtr<SVGRaster> SVGCache::GetRaster(RenderManager& render_manager, const SharedPtr<SVGDocument>& document, Vector2i dimensions)
+	{
+		RMLUI_ASSERT(document && document->document);
+
+		Vector<WeakPtr<SVGRaster>>& rasters = svg_cache_data->rasters[document.get()];
+		for (auto it = rasters.begin(); it != rasters.end();)
+		{
+			SharedPtr<SVGRaster> raster = it->lock();
+			if (!raster)
+			{
+				it = rasters.erase(it);
+				continue;
+			}
+			if (raster->render_manager == &render_manager && raster->dimensions == dimensions)
+				return raster;
+			++it;
+		}
+
+		auto raster = MakeShared<SVGRaster>();
+		raster->document = document;
+		raster->render_manager = &render_manager;
+		raster->dimensions = dimensions;
+
+		if (atlas_enabled && dimensions.x <= atlas_max_item_size && dimensions.y <= atlas_max_item_size)
+		{
+			// Small rasterizations are made immediately and copied into an atlas page, the page texture is then regenerated when next used.
+			lunasvg::Bitmap bitmap;
+			if (!RasterizeDocument(*document, dimensions, bitmap))
+			{
+				Log::Message(Rml::Log::Type::LT_WARNING, "Could not render SVG to bitmap: %s", document->source.c_str());
+				return nullptr;
+			}
+
+			auto& pages = svg_cache_data->atlas_pages;
+			AtlasPage* page = nullptr;
+			Vector2i position;
+			for (const UniquePtr<AtlasPage>& candidate : pages)
+			{
+				if (candidate->render_manager == &render_manager && candidate->Allocate(dimensions, position))
+				{
+					page = candidate.get();
+					break;
+				}
+			}
+
+			if (!page)
+			{
+				pages.push_back(MakeUnique<AtlasPage>(&render_manager));
+				page = pages.back().get();
+				const bool allocated = page->Allocate(dimensions, position);
+				RMLUI_ASSERT(allocated);
+				(void)allocated;
+			}
+
+			const int row_size = Math::Min(dimensions.x, (int)bitmap.width()) * 4;
+			const int num_rows = Math::Min(dimensions.y, (int)bitmap.height());
+			for (int y = 0; y < num_rows; y++)
+				memcpy(&page->pixels[((position.y + y) * atlas_page_size + position.x) * 4], bitmap.data() + y * bitmap.stride(), row_size);
+
+			page->num_regions += 1;
+			page->texture_dirty = true;
+
+			raster->atlas_page = page;
+			raster->tex_coord_top_left = Vector2f(position) / float(atlas_page_size);
+			raster->tex_coord_bottom_right = Vector2f(position + dimensions) / float(atlas_page_size);
+		}
+		else
+		{
+			SharedPtr<AsyncRasterJob> async_job;
+			if (async_enabled)
+			{
+				if (!svg_cache_data->worker)
+					svg_cache_data->worker = MakeUnique<ThreadPool>(1);
+
+				async_job = MakeShared<AsyncRasterJob>();
+				raster->async_job = async_job;
+
+				SVGDocument* document_ptr = document.get();
+				svg_cache_data->worker->Submit([async_job, document_ptr, dimensions]() {
+					std::lock_guard<std::mutex> lock(async_job->mutex);
+					if (async_job->cancelled)
+						return;
+					async_job->success = RasterizeDocument(*document_ptr, dimensions, async_job->bitmap);
+					async_job->done = true;
+				});
+			}
+
+			// Callback for generating the texture, the raster keeps the document alive for as long as the texture exists. Uses the result of
+			// the asynchronous job when available, otherwise, such as when regenerating the texture, the document is rasterized immediately.
+			SVGDocument* document_ptr = document.get();
+			auto texture_callback = [document_ptr, dimensions, async_job](const CallbackTextureInterface& texture_interface) -> bool {
+				lunasvg::Bitmap bitmap;
+				if (async_job && async_job->done && async_job->success)
+				{
+					bitmap = async_job->bitmap;
+					async_job->bitmap = {};
+					async_job->success = false;
+				}
+				else if (!RasterizeDocument(*document_ptr, dimensions, bitmap))
+				{
+					Log::Message(Rml::Log::Type::LT_WARNING, "Could not render SVG to bitmap: %s", document_ptr->source.c_str());
+					return false;
+				}
+
+				const size_t bitmap_byte_size = bitmap.height() * bitmap.stride();
+				if (!texture_interface.GenerateTexture({reinterpret_cast<const Rml::byte*>(bitmap.data()), bitmap_byte_size}, dimensions))
+				{
+					Log::Message(Rml::Log::Type::LT_WARNING, "Could not generate texture for SVG: %s", document_ptr->source.c_str());
+					return false;
+				}
+				return true;
+			};
+
+			raster->texture = render_manager.MakeCallbackTexture(std::move(texture_callback));
+		}
+
+		rasters.push_back(raster);
+		return raster;
+	}
+
+	void SVGCache::SetAtlasEnabled(bool enable)
+	{
+		atlas_enabled = enable;
+	}
+
+	void SVGCache::SetAsyncEnabled(bool enable)
+	{
+		async_enabled = enable;
+	}
+
+	void SVGCache::ReleaseAtlasRegion(AtlasPage* page)
+	{
+		page->num_regions -= 1;
+		if (page->num_regions > 0)
+			return;
+
+		auto& pages = svg_cache_data->atlas_pages;
+		auto it = std::find_if(pages.begin(), pages.end(), [page](const UniquePtr<AtlasPage>& candidate) { return candidate.get() == page; });
+		RMLUI_ASSERT(it != pages.end());
+		pages.erase(it);
+	}
+
+	void SetAtlasEnabled(bool enable)
+	{
+		SVGCache::SetAtlasEnabled(enable);
+	}
+
+	void SetAsyncRasterizationEnabled(bool enable)
+	{
+		SVGCache::SetAsyncEnabled(enable);
+	}
+
+} // namespace SVG
+} // namespace Rml
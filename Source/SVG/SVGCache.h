@@ -0,0 +1,136 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+
+#ifndef RMLUI_SVG_SVG_CACHE_H
+#define RMLUI_SVG_SVG_CACHE_H
+
+#include "../../Include/RmlUi/Core/CallbackTexture.h"
+#include "../../Include/RmlUi/Core/Texture.h"
+#include "../../Include/RmlUi/Core/Types.h"
+#include <mutex>
+
+namespace lunasvg {
+class Document;
+}
+
+namespace Rml {
+
+class RenderManager;
+
+namespace SVG {
+
+	class AtlasPage;
+	struct AsyncRasterJob;
+
+	/*
+	    A parsed SVG document, shared between all elements using the same source file.
+	*/
+	struct SVGDocument {
+		~SVGDocument();
+
+		String source;
+		UniquePtr<lunasvg::Document> document;
+		Vector2f intrinsic_dimensions;
+
+		// Guards rendering of the document, which may take place on both the main thread and the worker thread.
+		std::mutex render_mutex;
+	};
+
+	/*
+	    A rasterization of an SVG document at a given size, shared between all elements displaying the document at this size.
+
+	    The rasterization is either located in its own texture, or in a region of a shared atlas texture.
+	*/
+	class SVGRaster : NonCopyMoveable {
+	public:
+		~SVGRaster();
+
+		/// Returns true when the rasterization is available for rendering. Only false while it is being rasterized on the worker thread.
+		bool IsReady() const;
+
+		/// Returns the texture containing the rasterization.
+		Texture GetTexture();
+
+		/// Returns the texture coordinates of the rasterization inside the texture.
+		Vector2f GetTexCoordTopLeft() const { return tex_coord_top_left; }
+		Vector2f GetTexCoordBottomRight() const { return tex_coord_bottom_right; }
+
+	private:
+		SharedPtr<SVGDocument> document;
+		RenderManager* render_manager = nullptr;
+		Vector2i dimensions;
+
+		// Owned texture, when not located in an atlas.
+		CallbackTexture texture;
+
+		// Background rasterization in progress or completed, if rasterized asynchronously.
+		SharedPtr<AsyncRasterJob> async_job;
+
+		// Location in a shared atlas, if any.
+		AtlasPage* atlas_page = nullptr;
+
+		Vector2f tex_coord_top_left = Vector2f(0.f);
+		Vector2f tex_coord_bottom_right = Vector2f(1.f);
+
+		friend class SVGCache;
+	};
+
+	/**
+	    Plugin-level cache for SVG documents and their rasterizations.
+
+	    Documents are keyed by their resolved path, and rasterizations by their document, render manager, and pixel dimensions. The cache only
+	    holds weak references, all resources are owned by the elements using them. Any image color is applied when rendering, thus rasterizations
+	    can be shared independent of color.
+	 */
+	class SVGCache {
+	public:
+		static void Initialize();
+		static void Shutdown();
+
+		/// Returns the parsed document for the given path, loading and parsing the file only if it is not currently in use.
+		/// @return The document, or null if the file could not be loaded or parsed.
+		static SharedPtr<SVGDocument> GetDocument(const String& path);
+
+		/// Returns the rasterization of the document at the given dimensions, rasterizing the document only if the result is not currently in use.
+		/// @note With asynchronous rasterization enabled, the returned raster may not be ready yet, see SVGRaster::IsReady().
+		static SharedPtr<SVGRaster> GetRaster(RenderManager& render_manager, const SharedPtr<SVGDocument>& document, Vector2i dimensions);
+
+		/// Enables packing of small rasterizations into shared atlas textures, applies to rasterizations made after the call.
+		static void SetAtlasEnabled(bool enable);
+		/// Enables rasterization on a worker thread, applies to rasterizations made after the call.
+		static void SetAsyncEnabled(bool enable);
+
+	private:
+		static void ReleaseAtlasRegion(AtlasPage* page);
+		friend class SVGRaster;
+	};
+
+} // namespace SVG
+} // namespace Rml
+#endif
@@ -26,10 +26,12 @@
  *
  */
 
+#include "../../../Source/Core/ElementMeta.h"
 #include "../Common/TestsShell.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/ElementText.h>
 #include <RmlUi/Core/Types.h>
 #include <doctest.h>
 #include <nanobench.h>
@@ -315,3 +317,69 @@ TEST_CASE("element.asymptotic_complexity")
 
 	document->Close();
 }
+
+static void AccumulateElementBytes(Element* element, size_t& num_elements, size_t& num_scroll, size_t& num_bytes)
+{
+	num_elements += 1;
+	num_bytes += (rmlui_dynamic_cast<ElementText*>(element) ? sizeof(ElementText) : sizeof(Element)) + sizeof(ElementMeta);
+	if (element->GetElementScrollIfCreated())
+	{
+		num_scroll += 1;
+		num_bytes += sizeof(ElementScroll);
+	}
+
+	const int num_children = element->GetNumChildren(true);
+	for (int i = 0; i < num_children; i++)
+		AccumulateElementBytes(element->GetChild(i), num_elements, num_scroll, num_bytes);
+}
+
+TEST_CASE("element.memory_footprint")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* el = document->GetElementById("performance");
+	REQUIRE(el);
+
+	// Mostly leaf elements, each row generates four elements for a total of about 50k elements.
+	constexpr int num_rows = 12500;
+	String rml;
+	rml.reserve(num_rows * 48);
+	for (int i = 0; i < num_rows; i++)
+		rml += CreateString("<div><span class=\"icon\"/><span>%d</span></div>", i);
+
+	el->SetInnerRML(rml);
+	context->Update();
+	context->Render();
+
+	size_t num_elements = 0, num_scroll = 0, num_bytes = 0;
+	AccumulateElementBytes(el, num_elements, num_scroll, num_bytes);
+	REQUIRE(num_elements > 50000);
+
+	// The size every element would occupy if all its state was allocated up-front.
+	const size_t eager_meta_size = sizeof(ElementMeta) + sizeof(ElementScroll) + sizeof(ElementEffects) +
+		sizeof(SmallUnorderedMap<EventId, EventListener*>) - 3 * sizeof(UniquePtr<ElementScroll>);
+
+	MESSAGE(CreateString("\nElement memory footprint of %zu elements, of which %zu have instanced scroll state.\n"
+						 "  sizeof(Element): %zu bytes, sizeof(ElementText): %zu bytes, sizeof(ElementMeta): %zu bytes\n"
+						 "  Average element size: %.1f bytes (%.1f bytes with eagerly allocated scroll, effects, and listeners)\n",
+		num_elements, num_scroll, sizeof(Element), sizeof(ElementText), sizeof(ElementMeta), double(num_bytes) / double(num_elements),
+		double(num_bytes - num_scroll * sizeof(ElementScroll)) / double(num_elements) + double(eager_meta_size - sizeof(ElementMeta))));
+
+	nanobench::Bench bench;
+	bench.title("Element memory footprint");
+	bench.timeUnit(std::chrono::milliseconds(1), "ms");
+	bench.relative(true);
+	bench.epochs(1);
+
+	bench.run("SetInnerRML + Update (50k elements)", [&] {
+		el->SetInnerRML(rml);
+		context->Update();
+	});
+
+	document->Close();
+}
@@ -0,0 +1,111 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/Factory.h>
+#include <RmlUi/Core/StyleSheetContainer.h>
+#include <RmlUi/Core/Types.h>
+#include <doctest.h>
+#include <nanobench.h>
+
+using namespace ankerl;
+using namespace Rml;
+
+static const char* style_rule_template = R"(
+/* Rule %d: a comment preceding the rule,
+   spanning multiple lines. */
+#panel%d > div.item%d:hover, .list%d span[data-index="%d"] + p {
+	display: block;
+	position: relative;
+	margin: 2px 4px 2px 4px; /* margin comment */
+	padding: 5px;
+	width: %dpx;
+	height: 20%%;
+	color: #ffcc%02x;
+	background-color: rgba(20, 40, 60, 0.5);
+	border: 1px #303030;
+	font-family: "LatoLatin";
+	transition: opacity 0.2s cubic-in-out;
+	transform: rotate(%ddeg) translateX(4px);
+}
+)";
+
+static const char* inline_style = "display: block; position: relative; margin: 2px 4px; padding: 5px; width: 120px; height: 20%; color: #ffcc00; "
+								  "background-color: rgba(20, 40, 60, 0.5); border: 1px #303030; font-family: \"LatoLatin\";";
+
+TEST_CASE("style_sheet_parser")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	constexpr int num_rules = 2000;
+
+	String rcss;
+	for (int i = 0; i < num_rules; i++)
+		rcss += CreateString(style_rule_template, i, i, i, i, i, 100 + i % 50, i % 256, i % 360);
+
+	// Guard against accidentally benchmarking a failing parse.
+	const bool parsed = (Factory::InstanceStyleSheetString(rcss) != nullptr);
+	REQUIRE(parsed);
+
+	nanobench::Bench bench;
+	bench.title("Style sheet parser");
+	bench.timeUnit(std::chrono::microseconds(1), "us");
+
+	bench.run("Generated style sheet", [&]() {
+		SharedPtr<StyleSheetContainer> container = Factory::InstanceStyleSheetString(rcss);
+		nanobench::doNotOptimizeAway(container);
+	});
+
+	// A sheet dominated by comments and whitespace, where tokenization makes up most of the parsing time.
+	String rcss_comments;
+	const String comment = "/* " + String(400, 'x') + "\n" + String(400, 'y') + " */\n";
+	for (int i = 0; i < num_rules; i++)
+		rcss_comments += comment + "div {\n\tdisplay:    block;    /* trailing comment */\n}\n";
+
+	bench.run("Comment-heavy style sheet", [&]() {
+		SharedPtr<StyleSheetContainer> container = Factory::InstanceStyleSheetString(rcss_comments);
+		nanobench::doNotOptimizeAway(container);
+	});
+
+	ElementDocument* document = context->LoadDocumentFromMemory("<rml><body/></rml>");
+	REQUIRE(document);
+	Element* element = document->AppendChild(document->CreateElement("div"));
+
+	bench.run("Inline style attribute", [&]() {
+		element->SetAttribute("style", inline_style);
+		element->RemoveAttribute("style");
+		context->Update();
+	});
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
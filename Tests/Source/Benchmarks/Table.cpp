@@ -315,3 +315,43 @@ TEST_CASE("table_inline-block")
 
 	document->Close();
 }
+
+TEST_CASE("table_large")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(rml_table_document);
+	REQUIRE(document);
+	document->Show();
+
+	String rml = "<table id=\"table\"><col/><col span=\"2\"/><col/><tbody>";
+	for (int i = 0; i < 2000; i++)
+		rml += CreateString("<tr><td>%d</td><td>Name %d</td><td>%d</td><td>%d.%d</td></tr>", i, i, 7 * i % 100, i % 13, i % 10);
+	rml += "</tbody></table>";
+
+	document->SetInnerRML(rml);
+	Element* table = document->GetElementById("table");
+	REQUIRE(table);
+
+	// Rows size to their content, so that the cells are formatted to find the row heights.
+	ElementList cells;
+	table->GetElementsByTagName(cells, "td");
+	for (Element* cell : cells)
+		cell->SetProperty(PropertyId::Height, Property(Style::Height::Auto));
+
+	Element* cell = cells[cells.size() / 2];
+	context->Update();
+	context->Render();
+
+	nanobench::Bench bench;
+	bench.title("Table large");
+
+	int counter = 0;
+	bench.run("Change cell + Update", [&] {
+		cell->SetInnerRML(ToString(counter++));
+		context->Update();
+	});
+
+	document->Close();
+}
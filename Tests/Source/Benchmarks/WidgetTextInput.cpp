@@ -154,6 +154,45 @@ TEST_CASE("WidgetTextInput")
 		}
 	}
 
+	SUBCASE("EditLargeValue")
+	{
+		bench.title("WidgetTextInput.EditLargeValue");
+		bench.relative(false);
+
+		String value;
+		for (int i = 0; i < 5000; i++)
+			value += CreateString("Line %d: The quick brown fox jumps over the lazy dog, again and again.\n", i);
+
+		el->SetValue(value);
+		el->Focus();
+		context->Update();
+		context->Render();
+
+		// Place the cursor in the middle of the text, and keep it in view while editing.
+		const int cursor_index = (int)value.size() / 2;
+		el->SetSelectionRange(cursor_index, cursor_index);
+		context->Update();
+
+		bench.run("Insert character", [&] {
+			context->ProcessTextInput('x');
+			context->Update();
+			context->Render();
+		});
+
+		bench.run("Delete character", [&] {
+			context->ProcessKeyDown(Input::KI_BACK, 0);
+			context->ProcessKeyUp(Input::KI_BACK, 0);
+			context->Update();
+			context->Render();
+		});
+
+		bench.run("Scroll", [&] {
+			el->SetScrollTop(el->GetScrollTop() > 0.f ? 0.f : 0.5f * el->GetScrollHeight());
+			context->Update();
+			context->Render();
+		});
+	}
+
 	TestsShell::RenderLoop();
 
 	document->Close();
@@ -0,0 +1,88 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/BaseXMLParser.h>
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/Factory.h>
+#include <RmlUi/Core/StreamMemory.h>
+#include <RmlUi/Core/Types.h>
+#include <doctest.h>
+#include <nanobench.h>
+
+using namespace ankerl;
+using namespace Rml;
+
+static const char* document_row_rml = R"(
+		<!-- Row %d -->
+		<div class="row" id="row%d" data-index="%d" style="width: 200px; height: 20px;">
+			<span class="label">Item %d &amp; its description</span>
+			<input type="checkbox" name="check%d" value="%d" checked/>
+			<p>Some longer paragraph text which spans a few words, as found in most documents.</p>
+		</div>)";
+
+TEST_CASE("xml_parser")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	constexpr int num_rows = 1000;
+
+	String rml = R"(<rml>
+<head>
+	<link type="text/rcss" href="/../Tests/Data/style.rcss"/>
+	<style>
+		.row { display: block; }
+	</style>
+</head>
+<body>)";
+	for (int i = 0; i < num_rows; i++)
+		rml += CreateString(document_row_rml, i, i, i, i, i, i);
+	rml += "\n</body>\n</rml>\n";
+
+	nanobench::Bench bench;
+	bench.title("XML parser");
+	bench.timeUnit(std::chrono::microseconds(1), "us");
+
+	bench.run("Tokenize document", [&]() {
+		BaseXMLParser parser;
+		StreamMemory stream(reinterpret_cast<const byte*>(rml.data()), rml.size());
+		parser.Parse(&stream);
+	});
+
+	bench.run("Load document", [&]() {
+		// Clear the document cache to parse the source on every iteration.
+		Factory::ClearDocumentCache();
+		ElementDocument* document = context->LoadDocumentFromMemory(rml);
+		document->Close();
+		context->Update();
+	});
+
+	TestsShell::ShutdownShell();
+}
@@ -29,9 +29,11 @@
 #include "../Common/TestsInterface.h"
 #include "../Common/TestsShell.h"
 #include "../Common/TypesToString.h"
+#include <RmlUi/Core/ComputedValues.h>
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/EventListener.h>
 #include <doctest.h>
 #include <float.h>
 
@@ -651,3 +653,125 @@ TEST_CASE("animation.multiple_overlapping")
 	system_interface->SetTime(0.0);
 	TestsShell::ShutdownShell();
 }
+
+static const String document_animation_scheduler_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body {
+			font-family: LatoLatin;
+		}
+		@keyframes pulse {
+			from { opacity: 0.2; background-color: #f00; }
+			to   { opacity: 0.8; background-color: #00f8; }
+		}
+		#pulse {
+			width: 64px;
+			height: 64px;
+			animation: 1s cubic-in-out 2 alternate pulse;
+		}
+		#user {
+			width: 64px;
+			height: 64px;
+		}
+	</style>
+</head>
+
+<body>
+	<div id="pulse"><p id="child">Text</p></div>
+	<div id="user"/>
+</body>
+</rml>
+)";
+
+TEST_CASE("animation.scheduler")
+{
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	Context* context = TestsShell::GetContext();
+
+	struct Sample {
+		float opacity;
+		float child_opacity;
+		Colourb background_color;
+		Colourb user_background_color;
+	};
+
+	struct AnimationEndListener : EventListener {
+		void ProcessEvent(Event& /*event*/) override { num_events += 1; }
+		int num_events = 0;
+	};
+
+	auto RunAnimations = [&](bool enable_scheduler, int& num_animation_end_events) {
+		context->EnableAnimationScheduler(enable_scheduler);
+		REQUIRE(context->IsAnimationSchedulerEnabled() == enable_scheduler);
+
+		system_interface->SetTime(0.0);
+		ElementDocument* document = context->LoadDocumentFromMemory(document_animation_scheduler_rml, "assets/");
+		Element* pulse = document->GetElementById("pulse");
+		Element* child = document->GetElementById("child");
+		Element* user = document->GetElementById("user");
+
+		AnimationEndListener listener;
+		pulse->AddEventListener(EventId::Animationend, &listener);
+
+		document->Show();
+		const Property user_start_value(Colourb(0, 0, 0), Unit::COLOUR);
+		user->Animate("background-color", Property(Colourb(0, 255, 0), Unit::COLOUR), 0.5f, Tween{Tween::Sine, Tween::Out}, 1, false, 0.f,
+			&user_start_value);
+		TestsShell::RenderLoop();
+
+		Vector<Sample> samples;
+		const double dt = 1.0 / 60.0;
+		for (double t = dt; t < 2.5; t += dt)
+		{
+			system_interface->SetTime(t);
+			context->Update();
+
+			const Style::ComputedValues& values = pulse->GetComputedValues();
+			samples.push_back(Sample{values.opacity(), child->GetComputedValues().opacity(), values.background_color(),
+				user->GetComputedValues().background_color()});
+
+			// Scheduled animations only write to the computed values while running.
+			if (samples.size() == 30)
+				CHECK((pulse->GetProperty<float>("opacity") == values.opacity()) == !enable_scheduler);
+		}
+
+		// The scheduled animations should update their local properties once completed.
+		CHECK(pulse->GetLocalProperty("opacity") == nullptr);
+		CHECK(user->GetProperty<Colourb>("background-color") == Colourb(0, 255, 0));
+
+		pulse->RemoveEventListener(EventId::Animationend, &listener);
+		num_animation_end_events = listener.num_events;
+		document->Close();
+		context->Update();
+
+		return samples;
+	};
+
+	int num_events_regular = 0;
+	int num_events_scheduled = 0;
+	const Vector<Sample> samples_regular = RunAnimations(false, num_events_regular);
+	const Vector<Sample> samples_scheduled = RunAnimations(true, num_events_scheduled);
+
+	REQUIRE(samples_regular.size() == samples_scheduled.size());
+	for (size_t i = 0; i < samples_regular.size(); i++)
+	{
+		INFO("Sample: ", i);
+		CHECK(samples_regular[i].opacity == doctest::Approx(samples_scheduled[i].opacity));
+		CHECK(samples_regular[i].child_opacity == doctest::Approx(samples_scheduled[i].child_opacity));
+		CHECK(samples_regular[i].background_color == samples_scheduled[i].background_color);
+		CHECK(samples_regular[i].user_background_color == samples_scheduled[i].user_background_color);
+	}
+
+	// Both modes should end up with the values from the style sheet once the animation has completed.
+	CHECK(samples_scheduled.back().opacity == 1.f);
+	CHECK(samples_scheduled.back().child_opacity == 1.f);
+	CHECK(num_events_regular == 2);
+	CHECK(num_events_scheduled == num_events_regular);
+
+	context->EnableAnimationScheduler(false);
+	system_interface->SetTime(0.0);
+	TestsShell::ShutdownShell();
+}
@@ -26,10 +26,12 @@
  *
  */
 
+#include "../../../Source/Core/ElementArena.h"
 #include "../Common/TestsInterface.h"
 #include "../Common/TestsShell.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/DataModelHandle.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
 #include <Shell.h>
@@ -458,3 +460,169 @@ TEST_CASE("core.RemoveContext")
 
 	Shell::Shutdown();
 }
+
+TEST_CASE("core.update_contexts_parallel")
+{
+	TestsShell::GetContext();
+
+	String rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { font-family: LatoLatin; font-size: 16px; width: 400px; }
+		body.large { font-size: 20px; }
+		div.row { padding: 0.5em; border: 1px #000; }
+	</style>
+</head>
+<body>
+)";
+	for (int i = 0; i < 50; i++)
+		rml += "<div class='row'>Lorem ipsum <span>dolor</span> sit amet, consectetur adipiscing elit.</div>\n";
+	rml += "</body></rml>";
+
+	constexpr int num_contexts = 6;
+	const Vector2i window_size = {1280, 720};
+
+	// Every other context shares a render interface, these are updated together on the same thread.
+	TestsRenderInterface render_interfaces[num_contexts / 2];
+	Vector<Context*> contexts;
+	Vector<ElementDocument*> documents;
+	for (int i = 0; i < num_contexts; i++)
+	{
+		Context* context = Rml::CreateContext("parallel_" + ToString(i), window_size, &render_interfaces[i / 2]);
+		REQUIRE(context);
+		ElementDocument* document = context->LoadDocumentFromMemory(rml);
+		REQUIRE(document);
+		document->Show();
+		contexts.push_back(context);
+		documents.push_back(document);
+	}
+
+	auto CheckDocumentHeights = [&](float expected_min_height) {
+		const float height = documents[0]->GetBox().GetSize().y;
+		CHECK(height > expected_min_height);
+		for (ElementDocument* document : documents)
+			CHECK(document->GetBox().GetSize().y == height);
+		return height;
+	};
+
+	CHECK(Rml::UpdateContexts(contexts, 3));
+	const float small_height = CheckDocumentHeights(0.f);
+
+	for (ElementDocument* document : documents)
+		document->SetClass("large", true);
+	CHECK(Rml::UpdateContexts(contexts, 3));
+	CheckDocumentHeights(small_height);
+
+	// Should produce the same result as updating the contexts serially.
+	for (ElementDocument* document : documents)
+		document->SetClass("large", false);
+	CHECK(Rml::UpdateContexts(contexts, 0));
+	CHECK(CheckDocumentHeights(0.f) == small_height);
+
+	for (Context* context : contexts)
+		context->Render();
+
+	for (Context* context : contexts)
+		REQUIRE(Rml::RemoveContext(context->GetName()));
+	Rml::ReleaseRenderManagers();
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("core.element_arena")
+{
+	TestsShell::GetContext();
+	Context* context = Rml::CreateContext("arena", Vector2i(1280, 720), TestsShell::GetTestsRenderInterface());
+	REQUIRE(context);
+
+	String rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { font-family: LatoLatin; font-size: 16px; width: 400px; }
+	</style>
+</head>
+<body>
+	<div data-model="arena"><p data-for="item : items">{{ item }} <span>text</span></p></div>
+</body>
+</rml>
+)";
+
+	Vector<int> items = {1, 2, 3};
+	DataModelConstructor constructor = context->CreateDataModel("arena");
+	REQUIRE(constructor);
+	REQUIRE(constructor.RegisterArray<Vector<int>>());
+	REQUIRE(constructor.Bind("items", &items));
+	DataModelHandle handle = constructor.GetModelHandle();
+
+	CHECK(!context->IsElementArenaEnabled());
+	CHECK(!ElementArena::FromContext(context));
+	context->EnableElementArena(true);
+	CHECK(context->IsElementArenaEnabled());
+
+	ElementArena* arena = ElementArena::FromContext(context);
+	REQUIRE(arena);
+	CHECK(arena->GetNumAllocatedObjects() == 0);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+
+	ElementList paragraphs;
+	document->QuerySelectorAll(paragraphs, "p");
+	REQUIRE(paragraphs.size() == 4);
+	CHECK(paragraphs[0]->GetInnerRML() == "1 <span>text</span>");
+
+	// Elements of the loaded document, including their text and meta data, are allocated from the arena.
+	CHECK(ElementArena::FromElement(document) == arena);
+	CHECK(ElementArena::FromElement(paragraphs[0]) == arena);
+	CHECK(ElementArena::FromElement(paragraphs[0]->GetFirstChild()) == arena);
+	const int num_document_objects = arena->GetNumAllocatedObjects();
+	CHECK(num_document_objects > 0);
+
+	// Elements created by data views during update are also allocated from the arena.
+	items.push_back(4);
+	handle.DirtyVariable("items");
+	context->Update();
+	paragraphs.clear();
+	document->QuerySelectorAll(paragraphs, "p");
+	REQUIRE(paragraphs.size() == 5);
+	CHECK(paragraphs[3]->GetInnerRML() == "4 <span>text</span>");
+	CHECK(paragraphs[3]->GetBox().GetSize().y == paragraphs[0]->GetBox().GetSize().y);
+	CHECK(ElementArena::FromElement(paragraphs[3]) == arena);
+	CHECK(ElementArena::FromElement(paragraphs[3]->GetLastChild()) == arena);
+	CHECK(arena->GetNumAllocatedObjects() > num_document_objects);
+
+	// Elements may outlive both the arena's context and the arena being disabled.
+	ElementPtr detached_element = paragraphs[3]->GetParentNode()->RemoveChild(paragraphs[3]);
+	REQUIRE(detached_element);
+	CHECK(detached_element->GetNumChildren() == 2);
+
+	SUBCASE("DisableArena")
+	{
+		context->EnableElementArena(false);
+		CHECK(!context->IsElementArenaEnabled());
+		CHECK(!ElementArena::FromContext(context));
+
+		// New elements are allocated from the global pools, while existing elements keep their arena.
+		Element* element = document->AppendChild(document->CreateElement("p"));
+		CHECK(!ElementArena::FromElement(element));
+		CHECK(ElementArena::FromElement(document) == arena);
+		document->Close();
+		context->Update();
+		detached_element.reset();
+		REQUIRE(Rml::RemoveContext(context->GetName()));
+	}
+	SUBCASE("RemoveContext")
+	{
+		REQUIRE(Rml::RemoveContext(context->GetName()));
+		CHECK(detached_element->GetNumChildren() == 2);
+		detached_element.reset();
+	}
+
+	TestsShell::ShutdownShell();
+}
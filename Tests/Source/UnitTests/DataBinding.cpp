@@ -26,11 +26,13 @@
  *
  */
 
+#include "../Common/TestsInterface.h"
 #include "../Common/TestsShell.h"
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/DataModelHandle.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <algorithm>
 #include <cmath>
 #include <doctest.h>
 
@@ -710,3 +712,162 @@ TEST_CASE("data_binding.set_enum")
 	document->Close();
 	TestsShell::ShutdownShell();
 }
+
+static const String update_budget_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/template" href="/assets/window.rml"/>
+</head>
+<body template="window">
+<div data-model="budget">
+<p>{{ slow }}</p>
+<p>{{ slow }}</p>
+<p>{{ slow }}</p>
+<p>{{ slow }}</p>
+<p>{{ slow }}</p>
+<p>{{ slow }}</p>
+<p>{{ slow }}</p>
+<p>{{ slow }}</p>
+<p>{{ slow }}</p>
+<p>{{ slow }}</p>
+</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("data_binding.update_budget")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	double time = 0.0;
+	int value = 1;
+
+	// Each evaluation of the variable advances the clock by one millisecond.
+	DataModelConstructor constructor = context->CreateDataModel("budget");
+	REQUIRE(constructor);
+	constructor.BindFunc("slow", [&](Variant& variant) {
+		time += 0.001;
+		system_interface->SetTime(time);
+		variant = value;
+	});
+	DataModelHandle handle = constructor.GetModelHandle();
+
+	ElementDocument* document = context->LoadDocumentFromMemory(update_budget_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+
+	ElementList paragraphs;
+	document->GetElementsByTagName(paragraphs, "p");
+	REQUIRE(paragraphs.size() == 10);
+	CHECK(paragraphs.back()->GetInnerRML() == "1");
+
+	context->SetDataViewUpdateBudget(0.0025);
+	CHECK(context->GetDataViewUpdateBudget() == 0.0025);
+
+	value = 2;
+	handle.DirtyVariable("slow");
+	context->Update();
+
+	CHECK(context->GetDataViewCounters().processed_views == 3);
+	CHECK(context->GetDataViewCounters().deferred_views == 7);
+	CHECK(context->GetNextUpdateDelay() == 0);
+	CHECK(std::count_if(paragraphs.begin(), paragraphs.end(), [](Element* p) { return p->GetInnerRML() == "2"; }) == 3);
+
+	// Deferred views are carried over, even though the variable is no longer dirty.
+	int num_updates = 1;
+	while (context->GetDataViewCounters().deferred_views > 0 && num_updates < 10)
+	{
+		context->Update();
+		num_updates += 1;
+	}
+	CHECK(num_updates == 4);
+	CHECK(context->GetDataViewCounters().processed_views == 1);
+	CHECK(std::count_if(paragraphs.begin(), paragraphs.end(), [](Element* p) { return p->GetInnerRML() == "2"; }) == 10);
+
+	context->SetDataViewUpdateBudget(0);
+	value = 3;
+	handle.DirtyVariable("slow");
+	context->Update();
+	CHECK(context->GetDataViewCounters().processed_views == 10);
+	CHECK(context->GetDataViewCounters().deferred_views == 0);
+	CHECK(std::count_if(paragraphs.begin(), paragraphs.end(), [](Element* p) { return p->GetInnerRML() == "3"; }) == 10);
+
+	document->Close();
+	context->RemoveDataModel("budget");
+	system_interface->SetTime(0.0);
+
+	TestsShell::ShutdownShell();
+}
+
+static const String update_budget_chained_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/template" href="/assets/window.rml"/>
+</head>
+<body template="window">
+<div data-model="budget_chained">
+<p>{{ source }}</p>
+<p>{{ source }}</p>
+<p id="target">{{ target }}</p>
+</div>
+</body>
+</rml>
+)";
+
+TEST_CASE("data_binding.update_budget_chained")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	TestsSystemInterface* system_interface = TestsShell::GetTestsSystemInterface();
+	double time = 0.0;
+	int value = 1;
+
+	// Evaluating the source variable dirties the target variable, and exhausts the budget.
+	DataModelConstructor constructor = context->CreateDataModel("budget_chained");
+	REQUIRE(constructor);
+	DataModelHandle handle = constructor.GetModelHandle();
+	constructor.BindFunc("source", [&](Variant& variant) {
+		time += 0.001;
+		system_interface->SetTime(time);
+		handle.DirtyVariable("target");
+		variant = value;
+	});
+	constructor.BindFunc("target", [&](Variant& variant) { variant = value; });
+
+	ElementDocument* document = context->LoadDocumentFromMemory(update_budget_chained_rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+
+	Element* target = document->GetElementById("target");
+	CHECK(target->GetInnerRML() == "1");
+
+	context->SetDataViewUpdateBudget(0.0005);
+
+	value = 2;
+	handle.DirtyVariable("source");
+	context->Update();
+	CHECK(context->GetDataViewCounters().processed_views == 1);
+
+	int num_updates = 1;
+	while (context->GetDataViewCounters().deferred_views > 0 && num_updates < 10)
+	{
+		context->Update();
+		num_updates += 1;
+	}
+	CHECK(context->GetDataViewCounters().deferred_views == 0);
+	CHECK(target->GetInnerRML() == "2");
+
+	context->SetDataViewUpdateBudget(0);
+	document->Close();
+	context->RemoveDataModel("budget_chained");
+	system_interface->SetTime(0.0);
+
+	TestsShell::ShutdownShell();
+}
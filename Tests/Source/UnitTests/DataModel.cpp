@@ -117,3 +117,99 @@ TEST_CASE("Data variables")
 		CHECK(get_result.Get<String>() == "90");
 	}
 }
+
+TEST_CASE("Data variables.static_members")
+{
+	struct Stats {
+		int health = 50;
+		float speed = 1.5f;
+		bool alive = true;
+		String name = "invader";
+		Vector<int> scores = {1, 2, 3};
+	};
+
+	DataTypeRegister types;
+	DataModel model(&types);
+
+	DataModelConstructor handle(&model);
+	handle.RegisterArray<Vector<int>>();
+
+	if (auto stats_handle = handle.RegisterStruct<Stats>())
+	{
+		REQUIRE(stats_handle.RegisterMember<int, &Stats::health>("health"));
+		REQUIRE(stats_handle.RegisterMember<float, &Stats::speed>("speed"));
+		REQUIRE(stats_handle.RegisterMember<bool, &Stats::alive>("alive"));
+		REQUIRE(stats_handle.RegisterMember<String, &Stats::name>("name"));
+		REQUIRE(stats_handle.RegisterMember<Vector<int>, &Stats::scores>("scores"));
+	}
+
+	Stats stats;
+	handle.Bind("stats", &stats);
+
+	DataAddress address = model.ResolveAddress("stats.alive", nullptr);
+	REQUIRE(address.size() == 2);
+	CHECK(address[1].member_index == 2);
+
+	Variant result;
+	REQUIRE(model.GetVariableInto(address, result));
+	CHECK(result.Get<bool>() == true);
+
+	REQUIRE(model.GetVariableInto(model.ResolveAddress("stats.name", nullptr), result));
+	CHECK(result.Get<String>() == "invader");
+
+	REQUIRE(model.GetVariableInto(model.ResolveAddress("stats.scores[2]", nullptr), result));
+	CHECK(result.Get<int>() == 3);
+
+	REQUIRE(model.GetVariable(model.ResolveAddress("stats.health", nullptr)).Set(Variant(75)));
+	CHECK(stats.health == 75);
+
+	REQUIRE(model.GetVariable(model.ResolveAddress("stats.speed", nullptr)).Get(result));
+	CHECK(result.Get<float>() == 1.5f);
+
+	// Unresolved addresses still look up members by name.
+	REQUIRE(model.GetVariableInto(ParseAddress("stats.health"), result));
+	CHECK(result.Get<int>() == 75);
+}
+
+TEST_CASE("Data variables.static_enum_members")
+{
+	enum class Mode { Idle, Attack };
+	enum class Level { Low, High };
+
+	struct Unit {
+		Mode mode = Mode::Attack;
+		Level level = Level::High;
+	};
+
+	DataTypeRegister types;
+	DataModel model(&types);
+
+	DataModelConstructor handle(&model);
+
+	// Enum members with a custom scalar definition must go through that definition, even when registered at compile time.
+	REQUIRE(handle.RegisterScalar<Mode>([](const Mode& value, Variant& variant) { variant = (value == Mode::Attack ? "attack" : "idle"); },
+		[](Mode& value, const Variant& variant) { value = (variant.Get<String>() == "attack" ? Mode::Attack : Mode::Idle); }));
+
+	if (auto unit_handle = handle.RegisterStruct<Unit>())
+	{
+		REQUIRE(unit_handle.RegisterMember<Mode, &Unit::mode>("mode"));
+		REQUIRE(unit_handle.RegisterMember<Level, &Unit::level>("level"));
+	}
+
+	Unit unit;
+	handle.Bind("unit", &unit);
+
+	Variant result;
+	REQUIRE(model.GetVariableInto(model.ResolveAddress("unit.mode", nullptr), result));
+	CHECK(result.Get<String>() == "attack");
+
+	REQUIRE(model.GetVariable(model.ResolveAddress("unit.mode", nullptr)).Set(Variant("idle")));
+	CHECK(unit.mode == Mode::Idle);
+
+	// Enums without a custom definition are accessed as integers.
+	REQUIRE(model.GetVariableInto(model.ResolveAddress("unit.level", nullptr), result));
+	CHECK(result.Get<int>() == 1);
+
+	REQUIRE(model.GetVariable(model.ResolveAddress("unit.level", nullptr)).Set(Variant(0)));
+	CHECK(unit.level == Level::Low);
+}
@@ -212,3 +212,111 @@ TEST_CASE("ElementBackgroundBorder.background_edges_line_up_with_relative_offset
 	document->Close();
 	TestsShell::ShutdownShell();
 }
+
+static const String document_box_shadow_rml = R"(
+<rml>
+<head>
+<title>Demo</title>
+<link type="text/rcss" href="/assets/rml.rcss" />
+<link type="text/rcss" href="/../Tests/Data/style.rcss" />
+<style>
+	body {
+		width: 800px;
+		height: 800px;
+	}
+	.card {
+		float: left;
+		width: 100px;
+		height: 50px;
+		margin: 20px;
+		background-color: #fff;
+		border: 1px #ccc;
+		border-radius: 5px;
+		box-shadow: #0008 2px 3px 8px 1px, #f00 0 0 0 3px inset;
+	}
+</style>
+</head>
+<body id="body">
+</body>
+</rml>
+)";
+
+// Render interface which produces distinct textures from layers, so that the number of generated box-shadow textures can be counted.
+class BoxShadowRenderInterface : public TestsRenderInterface {
+public:
+	TextureHandle SaveLayerAsTexture() override
+	{
+		num_saved_layers += 1;
+		return TextureHandle(num_saved_layers);
+	}
+
+	int num_saved_layers = 0;
+};
+
+TEST_CASE("ElementBackgroundBorder.box_shadow_shared_texture")
+{
+	// Ensure the shell is initialized.
+	TestsShell::GetContext();
+
+	BoxShadowRenderInterface render_interface;
+	Context* context = Rml::CreateContext("box_shadow", {800, 800}, &render_interface);
+	REQUIRE(context);
+
+	constexpr int num_cards = 20;
+	bool nine_slice = false;
+	bool varying_sizes = false;
+
+	SUBCASE("Identical")
+	{
+		varying_sizes = false;
+	}
+	SUBCASE("VaryingSizes")
+	{
+		varying_sizes = true;
+	}
+	SUBCASE("VaryingSizesNineSlice")
+	{
+		varying_sizes = true;
+		nine_slice = true;
+	}
+
+	context->EnableBoxShadowNineSlice(nine_slice);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_box_shadow_rml);
+	REQUIRE(document);
+
+	String cards_rml;
+	for (int i = 0; i < num_cards; i++)
+	{
+		const int width = (varying_sizes ? 60 + 7 * i : 100);
+		cards_rml += CreateString("<div class='card' style='width: %dpx'/>", width);
+	}
+	document->GetElementById("body")->SetInnerRML(cards_rml);
+	document->Show();
+
+	context->Update();
+	context->Render();
+
+	const int expected_textures = (varying_sizes && !nine_slice ? num_cards : 1);
+	CHECK(render_interface.num_saved_layers == expected_textures);
+
+	// Rendering again should re-use the generated textures.
+	context->Update();
+	context->Render();
+	CHECK(render_interface.num_saved_layers == expected_textures);
+
+	// Changing the background of a single card requires a new texture for that card only.
+	document->GetElementById("body")->GetChild(0)->SetProperty(PropertyId::BackgroundColor, Property(Colourb(0, 0, 255), Unit::COLOUR));
+	context->Update();
+	context->Render();
+	CHECK(render_interface.num_saved_layers == expected_textures + 1);
+
+	document->Close();
+	REQUIRE(Rml::RemoveContext("box_shadow"));
+	ReleaseRenderManagers();
+
+	const auto counters = render_interface.GetCounters();
+	CHECK(counters.release_texture == size_t(render_interface.num_saved_layers));
+
+	TestsShell::ShutdownShell();
+}
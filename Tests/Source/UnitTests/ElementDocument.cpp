@@ -298,6 +298,54 @@ TEST_CASE("ReloadStyleSheet")
 	TestsShell::ShutdownShell();
 }
 
+TEST_CASE("SharedStyleSheet")
+{
+	static const String document_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/../Tests/Data/style.rcss"/>
+	<style>
+		div { height: %dpx; }
+	</style>
+</head>
+<body><div/></body>
+</rml>
+)";
+
+	Context* context = TestsShell::GetContext();
+
+	// Documents combining the same style sheets should share a single compiled sheet.
+	ElementDocument* document1 = context->LoadDocumentFromMemory(CreateString(document_rml.c_str(), 10));
+	ElementDocument* document2 = context->LoadDocumentFromMemory(CreateString(document_rml.c_str(), 10));
+	ElementDocument* document3 = context->LoadDocumentFromMemory(CreateString(document_rml.c_str(), 20));
+	REQUIRE(document1);
+	REQUIRE(document2);
+	REQUIRE(document3);
+
+	document1->Show();
+	document2->Show();
+	document3->Show();
+	context->Update();
+
+	REQUIRE(document1->GetStyleSheet());
+	CHECK(document1->GetStyleSheet() == document2->GetStyleSheet());
+	CHECK(document1->GetStyleSheet() != document3->GetStyleSheet());
+
+	CHECK(document2->GetChild(0)->GetProperty<float>("height") == 10.f);
+	CHECK(document3->GetChild(0)->GetProperty<float>("height") == 20.f);
+
+	// The shared sheet stays valid after the document which compiled it is closed.
+	document1->Close();
+	context->Update();
+	document2->GetChild(0)->SetClass("changed", true);
+	context->Update();
+	CHECK(document2->GetChild(0)->GetProperty<float>("height") == 10.f);
+
+	document2->Close();
+	document3->Close();
+	TestsShell::ShutdownShell();
+}
+
 TEST_CASE("Modal.MultipleDocuments")
 {
 	Context* context = TestsShell::GetContext();
@@ -0,0 +1,486 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../../../Source/Core/Elements/InputTypeText.h"
+#include "../../../Source/Core/Elements/WidgetTextInputMultiLine.h"
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/ElementText.h>
+#include <RmlUi/Core/Elements/ElementFormControlInput.h>
+#include <RmlUi/Core/Elements/ElementFormControlTextArea.h>
+#include <doctest.h>
+
+namespace Rml {
+
+class TestWidgetTextInput {
+public:
+	TestWidgetTextInput(ElementFormControlTextArea* element) : widget(element->widget.get()) {}
+	TestWidgetTextInput(ElementFormControlInput* element) : widget(rmlui_static_cast<InputTypeText*>(element->type.get())->widget.get()) {}
+
+	const String& GetValue() const { return widget->GetValue(); }
+
+	// Returns the current lines of the text field, along with the content they were formatted with.
+	String GetLines() const
+	{
+		RMLUI_ASSERT(widget->lines.size() == widget->formatted_lines.size());
+		String result;
+		for (size_t i = 0; i < widget->lines.size(); i++)
+		{
+			const WidgetTextInput::Line& line = widget->lines[i];
+			const WidgetTextInput::FormattedLine& formatted_line = widget->formatted_lines[i];
+			result += CreateString("%d %d %d [%s] %g\n", line.value_offset, line.size, line.editable_length, formatted_line.content.c_str(),
+				formatted_line.width);
+		}
+		return result;
+	}
+
+	// Formats all lines from scratch, without reusing any previously formatted lines.
+	void Reformat()
+	{
+		widget->ForceFormattingOnNextLayout();
+		widget->OnLayout();
+	}
+
+	void Insert(int index, const String& text)
+	{
+		widget->SetSelectionRange(index, index);
+		widget->AddCharacters(text);
+	}
+
+	void Erase(int begin, int end)
+	{
+		widget->SetSelectionRange(begin, end);
+		widget->DeleteSelection();
+	}
+
+	// Changes the displayed value without formatting the lines, so that the change is merged with any other changes made before the next
+	// formatting. Known edits are recorded like edits made by the widget itself, otherwise the changed range is found by comparing the values.
+	void EditWithoutFormatting(int offset, int removed_length, const String& text, bool known_edit)
+	{
+		String value = widget->GetValue();
+		value.replace((size_t)offset, (size_t)removed_length, text);
+
+		if (known_edit)
+			widget->pending_value_edit = {offset, removed_length, (int)text.size()};
+		widget->RecordValueChange(value);
+		widget->pending_value_edit = {};
+		widget->text_element->SetText(value);
+	}
+
+	void FormatText() { widget->FormatText(); }
+
+	void SetPendingEdit(int offset, int removed_length, int inserted_length) { widget->pending_value_edit = {offset, removed_length, inserted_length}; }
+
+	// Returns the number of cursor positions for which the cursor line and character indices differ from those found by a linear search through
+	// the lines.
+	int CountRelativeCursorIndexMismatches()
+	{
+		const int initial_cursor_index = widget->absolute_cursor_index;
+		const bool initial_cursor_wrap_down = widget->cursor_wrap_down;
+		int num_mismatches = 0;
+
+		for (int cursor_index = 0; cursor_index <= (int)widget->GetValue().size(); cursor_index++)
+		{
+			for (bool cursor_wrap_down : {false, true})
+			{
+				widget->absolute_cursor_index = cursor_index;
+				widget->cursor_wrap_down = cursor_wrap_down;
+
+				int line_index = -1, character_index = -1;
+				widget->GetRelativeCursorIndices(line_index, character_index);
+
+				int expected_line_index = -1, expected_character_index = -1;
+				GetRelativeCursorIndicesLinear(expected_line_index, expected_character_index);
+
+				if (line_index != expected_line_index || character_index != expected_character_index)
+					num_mismatches += 1;
+			}
+		}
+
+		widget->absolute_cursor_index = initial_cursor_index;
+		widget->cursor_wrap_down = initial_cursor_wrap_down;
+		return num_mismatches;
+	}
+
+	// Returns the absolute indices where soft-wrapped lines end.
+	Vector<int> GetSoftWraps() const
+	{
+		Vector<int> result;
+		for (size_t i = 0; i + 1 < widget->lines.size(); i++)
+		{
+			const WidgetTextInput::Line& line = widget->lines[i];
+			if (line.editable_length == line.size)
+				result.push_back(line.value_offset + line.size);
+		}
+		return result;
+	}
+
+	bool IsVisibleTextRendered() const { return widget->IsVisibleTextRendered(); }
+	int GetNumRenderedLines() const { return widget->rendered_lines_end - widget->rendered_lines_begin; }
+
+private:
+	void GetRelativeCursorIndicesLinear(int& out_cursor_line_index, int& out_cursor_character_index) const
+	{
+		const WidgetTextInput::LineList& lines = widget->lines;
+		int line_begin = 0;
+
+		for (size_t i = 0; i < lines.size(); i++)
+		{
+			const int cursor_relative_line_end = widget->absolute_cursor_index - (line_begin + lines[i].editable_length);
+			if (cursor_relative_line_end <= 0)
+			{
+				const bool soft_wrapped_line = (lines[i].editable_length == lines[i].size);
+				if (cursor_relative_line_end == 0 && soft_wrapped_line && widget->cursor_wrap_down && (int)i + 1 < (int)lines.size())
+				{
+					out_cursor_line_index = (int)i + 1;
+					out_cursor_character_index = 0;
+				}
+				else
+				{
+					out_cursor_line_index = (int)i;
+					out_cursor_character_index = Math::Max(widget->absolute_cursor_index - line_begin, 0);
+				}
+				return;
+			}
+
+			line_begin += lines[i].size;
+		}
+
+		out_cursor_line_index = (int)lines.size() - 1;
+		out_cursor_character_index = lines[out_cursor_line_index].editable_length;
+	}
+
+	WidgetTextInput* widget;
+};
+
+} // namespace Rml
+
+using namespace Rml;
+
+static const String document_textarea_rml = R"(
+<rml>
+<head>
+	<title>Test</title>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body {
+			left: 0;
+			top: 0;
+			right: 0;
+			bottom: 0;
+			font-family: LatoLatin;
+			font-size: 16px;
+		}
+		textarea {
+			display: block;
+			width: 200px;
+			height: 100px;
+			padding: 5px;
+			line-height: 20px;
+			overflow-y: auto;
+		}
+		input {
+			display: block;
+			width: 200px;
+		}
+		scrollbarvertical {
+			width: 10px;
+		}
+		scrollbarvertical sliderbar {
+			min-height: 10px;
+		}
+	</style>
+</head>
+
+<body>
+<textarea id="textarea"/>
+<input type="password" id="password"/>
+</body>
+</rml>
+)";
+
+static const String textarea_value = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna "
+									 "aliqua.\n\nUt enim ad minim veniam,        quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo "
+									 "consequat.    \nDuis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur.\n";
+
+// Checks that the lines formatted after the latest edit match the lines formatted from scratch.
+static void CheckLinesMatchReformat(Context* context, TestWidgetTextInput& widget)
+{
+	context->Update();
+	const String lines = widget.GetLines();
+	widget.Reformat();
+
+	INFO("Value: ", widget.GetValue());
+	CHECK(lines == widget.GetLines());
+}
+
+TEST_CASE("form.textarea.line_breaking")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_textarea_rml);
+	REQUIRE(document);
+	document->Show();
+
+	auto textarea = rmlui_dynamic_cast<ElementFormControlTextArea*>(document->GetElementById("textarea"));
+	REQUIRE(textarea);
+	TestWidgetTextInput widget(textarea);
+
+	textarea->SetValue(textarea_value);
+	textarea->Focus();
+	context->Update();
+	REQUIRE(widget.GetSoftWraps().size() > 5);
+
+	SUBCASE("soft_wrap")
+	{
+		const size_t num_soft_wraps = widget.GetSoftWraps().size();
+		for (size_t i = 0; i < num_soft_wraps; i++)
+		{
+			const Vector<int> soft_wraps = widget.GetSoftWraps();
+			if (i >= soft_wraps.size())
+				break;
+			const int wrap = soft_wraps[i];
+
+			widget.Insert(wrap, "x");
+			CheckLinesMatchReformat(context, widget);
+			widget.Erase(wrap, wrap + 1);
+			CheckLinesMatchReformat(context, widget);
+
+			widget.Insert(wrap - 1, "somewhat longer words ");
+			CheckLinesMatchReformat(context, widget);
+			widget.Erase(wrap - 1, wrap + 21);
+			CheckLinesMatchReformat(context, widget);
+
+			widget.Erase(wrap - 2, wrap + 2);
+			CheckLinesMatchReformat(context, widget);
+		}
+	}
+
+	SUBCASE("trailing_spaces")
+	{
+		const int spaces_begin = (int)textarea_value.find("        ");
+		REQUIRE(spaces_begin > 0);
+
+		for (int offset : {0, 1, 4, 8})
+		{
+			widget.Insert(spaces_begin + offset, "    ");
+			CheckLinesMatchReformat(context, widget);
+			widget.Insert(spaces_begin + offset + 2, "abc");
+			CheckLinesMatchReformat(context, widget);
+			widget.Erase(spaces_begin + offset, spaces_begin + offset + 7);
+			CheckLinesMatchReformat(context, widget);
+		}
+
+		const int end_spaces_begin = (int)textarea_value.find("    \n");
+		REQUIRE(end_spaces_begin > 0);
+		widget.Erase(end_spaces_begin, end_spaces_begin + 4);
+		CheckLinesMatchReformat(context, widget);
+		widget.Insert(end_spaces_begin, "                                        ");
+		CheckLinesMatchReformat(context, widget);
+		widget.Insert(end_spaces_begin + 10, "x");
+		CheckLinesMatchReformat(context, widget);
+	}
+
+	SUBCASE("newline")
+	{
+		const int newline = (int)textarea_value.find('\n');
+		widget.Erase(newline, newline + 1);
+		CheckLinesMatchReformat(context, widget);
+		widget.Erase(newline - 3, newline + 3);
+		CheckLinesMatchReformat(context, widget);
+		widget.Insert(newline - 3, "\n\nnew paragraph\n");
+		CheckLinesMatchReformat(context, widget);
+
+		const int last_newline = (int)widget.GetValue().rfind('\n', widget.GetValue().size() - 2);
+		widget.Erase(last_newline - 20, last_newline + 20);
+		CheckLinesMatchReformat(context, widget);
+		widget.Insert(20, "\n");
+		CheckLinesMatchReformat(context, widget);
+	}
+
+	SUBCASE("start_end")
+	{
+		widget.Insert(0, "Start ");
+		CheckLinesMatchReformat(context, widget);
+		widget.Erase(0, 1);
+		CheckLinesMatchReformat(context, widget);
+		widget.Insert(0, "\n");
+		CheckLinesMatchReformat(context, widget);
+
+		const int size = (int)widget.GetValue().size();
+		widget.Insert(size, "end");
+		CheckLinesMatchReformat(context, widget);
+		widget.Erase(size - 1, size + 3);
+		CheckLinesMatchReformat(context, widget);
+		widget.Insert(size - 1, " \n\n");
+		CheckLinesMatchReformat(context, widget);
+
+		widget.Erase(0, (int)widget.GetValue().size());
+		CheckLinesMatchReformat(context, widget);
+		widget.Insert(0, textarea_value);
+		CheckLinesMatchReformat(context, widget);
+	}
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("form.textarea.scroll_clamp")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_textarea_rml);
+	REQUIRE(document);
+	document->Show();
+
+	auto textarea = rmlui_dynamic_cast<ElementFormControlTextArea*>(document->GetElementById("textarea"));
+	REQUIRE(textarea);
+	TestWidgetTextInput widget(textarea);
+
+	String long_value;
+	for (int i = 0; i < 100; i++)
+		long_value += CreateString("Line %d\n", i);
+
+	textarea->SetValue(long_value);
+	context->Update();
+	textarea->SetScrollTop(textarea->GetScrollHeight());
+	context->Update();
+	REQUIRE(textarea->GetScrollTop() > 0.f);
+	CHECK(widget.IsVisibleTextRendered());
+
+	// Shrinking the value clamps the scroll offset, the lines which then become visible should be rendered.
+	textarea->SetValue("Line 0\nLine 1\nLine 2\n");
+	context->Update();
+	CHECK(textarea->GetScrollTop() == 0.f);
+	CHECK(widget.IsVisibleTextRendered());
+	CHECK(widget.GetNumRenderedLines() == 4);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("form.textarea.value_changes")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_textarea_rml);
+	REQUIRE(document);
+	document->Show();
+
+	auto textarea = rmlui_dynamic_cast<ElementFormControlTextArea*>(document->GetElementById("textarea"));
+	REQUIRE(textarea);
+	TestWidgetTextInput widget(textarea);
+
+	textarea->SetValue(textarea_value);
+	textarea->Focus();
+	context->Update();
+
+	SUBCASE("merged_edits")
+	{
+		const int newline = (int)textarea_value.find('\n');
+		for (bool known_edit : {false, true})
+		{
+			widget.EditWithoutFormatting(newline + 30, 10, "", known_edit);
+			widget.EditWithoutFormatting(10, 0, "several words at the beginning", !known_edit);
+			widget.EditWithoutFormatting(newline - 5, 20, "\n", known_edit);
+			widget.EditWithoutFormatting((int)widget.GetValue().size() - 10, 3, "an end", known_edit);
+			widget.FormatText();
+			CheckLinesMatchReformat(context, widget);
+		}
+	}
+
+	SUBCASE("rejected_edit")
+	{
+		// An edit pending when the new value is sanitized no longer describes the change, even if the sizes happen to match.
+		widget.SetPendingEdit((int)textarea_value.size(), 0, 1);
+		textarea->SetValue("X\t" + textarea_value);
+		CHECK(textarea->GetValue() == "X" + textarea_value);
+		CheckLinesMatchReformat(context, widget);
+	}
+
+	SUBCASE("cursor_lines")
+	{
+		CHECK(widget.CountRelativeCursorIndexMismatches() == 0);
+
+		const int wrap = widget.GetSoftWraps()[2];
+		widget.Insert(wrap, "\n\n");
+		widget.Erase(0, 5);
+		context->Update();
+		CHECK(widget.CountRelativeCursorIndexMismatches() == 0);
+
+		textarea->SetValue("");
+		context->Update();
+		CHECK(widget.CountRelativeCursorIndexMismatches() == 0);
+	}
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("form.input.password")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_textarea_rml);
+	REQUIRE(document);
+	document->Show();
+
+	auto password = rmlui_dynamic_cast<ElementFormControlInput*>(document->GetElementById("password"));
+	REQUIRE(password);
+	TestWidgetTextInput widget(password);
+
+	password->SetValue("p\xC3\xA4ssw\xC3\xB6rd\xE2\x82\xAC");
+	password->Focus();
+	context->Update();
+	CHECK(widget.GetValue() == "*********");
+
+	// Edits are made to the displayed value, with one character for each code point of the attribute value.
+	widget.Insert(2, "\xC3\xBC\xE2\x82\xAC");
+	CHECK(password->GetValue() == "p\xC3\xA4\xC3\xBC\xE2\x82\xACssw\xC3\xB6rd\xE2\x82\xAC");
+	CHECK(widget.GetValue() == "***********");
+	CheckLinesMatchReformat(context, widget);
+
+	widget.Erase(1, 4);
+	CHECK(password->GetValue() == "pssw\xC3\xB6rd\xE2\x82\xAC");
+	CHECK(widget.GetValue() == "********");
+	CheckLinesMatchReformat(context, widget);
+
+	widget.Insert(8, "!");
+	CHECK(password->GetValue() == "pssw\xC3\xB6rd\xE2\x82\xAC!");
+	CheckLinesMatchReformat(context, widget);
+	CHECK(widget.CountRelativeCursorIndexMismatches() == 0);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
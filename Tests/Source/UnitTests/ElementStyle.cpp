@@ -27,9 +27,11 @@
  */
 
 #include "../Common/TestsShell.h"
+#include <RmlUi/Core/ComputedValues.h>
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/PropertiesIteratorView.h>
 #include <doctest.h>
 
 using namespace Rml;
@@ -84,3 +86,112 @@ TEST_CASE("elementstyle.inline_decorator_images")
 
 	TestsShell::ShutdownShell();
 }
+
+TEST_CASE("elementstyle.iterate_local_properties")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<style>
+		p { width: 10px; height: 20px; color: #f00; }
+	</style>
+</head>
+<body>
+<p style="height: 30px; opacity: 0.5;"/>
+</body>
+</rml>
+)");
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+
+	Element* element = document->QuerySelector("p");
+	REQUIRE(element);
+
+	// Local style properties override definition properties, and each property is visited once in order of property id.
+	Vector<PropertyId> ids;
+	for (auto it = element->IterateLocalProperties(); !it.AtEnd(); ++it)
+	{
+		CHECK((ids.empty() || ids.back() < it.GetId()));
+		ids.push_back(it.GetId());
+		if (it.GetId() == PropertyId::Height)
+			CHECK(it.GetProperty().ToString() == "30px");
+	}
+	CHECK(ids.size() == 4);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("elementstyle.parallel_style_update")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	String rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body { font-family: LatoLatin; font-size: 16px; color: #000; }
+		body.large { font-size: 20px; color: #f00; }
+		div.row { height: 2em; }
+		span { padding-left: 1em; }
+	</style>
+</head>
+<body>
+)";
+	for (int i = 0; i < 100; i++)
+		rml += "<div class='row'><span>a</span><span>b</span><div><span>c</span></div></div>\n";
+	rml += "</body></rml>";
+
+	context->SetStyleUpdateThreads(3);
+	CHECK(context->GetStyleUpdateThreads() == 3);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(rml);
+	REQUIRE(document);
+	document->Show();
+	context->Update();
+
+	ElementList spans;
+	document->QuerySelectorAll(spans, "span");
+	REQUIRE(spans.size() == 300);
+	Element* row = document->QuerySelector("div.row");
+	REQUIRE(row);
+
+	CHECK(spans.back()->GetComputedValues().padding_left().value == 16.f);
+	CHECK(row->GetBox().GetSize().y == 32.f);
+
+	document->SetClass("large", true);
+	context->Update();
+
+	for (Element* span : spans)
+	{
+		CHECK(span->GetComputedValues().padding_left().value == 20.f);
+		CHECK(span->GetComputedValues().color() == Colourb(255, 0, 0));
+	}
+	// Layout is updated by the deferred property change notifications.
+	CHECK(row->GetBox().GetSize().y == 40.f);
+
+	// Only a few elements are dirty, their values are computed during the serial update.
+	spans.front()->SetProperty("padding-left", "5px");
+	context->Update();
+	CHECK(spans.front()->GetComputedValues().padding_left().value == 5.f);
+	CHECK(spans.back()->GetComputedValues().padding_left().value == 20.f);
+	spans.front()->RemoveProperty("padding-left");
+	context->Update();
+	CHECK(spans.front()->GetComputedValues().padding_left().value == 20.f);
+
+	context->SetStyleUpdateThreads(0);
+	CHECK(context->GetStyleUpdateThreads() == 0);
+
+	document->SetClass("large", false);
+	context->Update();
+	CHECK(spans.front()->GetComputedValues().padding_left().value == 16.f);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
@@ -161,3 +161,110 @@ TEST_CASE("event_listener.replace_current_element")
 	Rml::Factory::RegisterEventListenerInstancer(nullptr);
 	TestsShell::ShutdownShell();
 }
+
+class RecordingEventListener : public Rml::EventListener {
+public:
+	RecordingEventListener(Rml::String name, Rml::StringList& records) : name(std::move(name)), records(records) {}
+
+	void ProcessEvent(Rml::Event& event) override
+	{
+		records.push_back(name + ":" + event.GetType() + ":" + Rml::ToString(event.GetParameter("button", -1)));
+
+		// Dispatch an event recursively, which must not interfere with the event currently being dispatched.
+		if (event == EventId::Mousedown && event.GetPhase() == EventPhase::Target)
+			event.GetTargetElement()->DispatchEvent(EventId::Mouseup, Dictionary());
+	}
+
+private:
+	Rml::String name;
+	Rml::StringList& records;
+};
+
+TEST_CASE("event_listener.reused_dispatch_state")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_decorator_rml, "assets/");
+	REQUIRE(document);
+	Element* button = document->GetElementById("exit");
+	REQUIRE(button);
+	Element* div = button->GetParentNode();
+
+	StringList records;
+	RecordingEventListener capture_listener("capture", records), target_listener("target", records), bubble_listener("bubble", records);
+	div->AddEventListener(EventId::Mousedown, &capture_listener, true);
+	div->AddEventListener(EventId::Mouseup, &bubble_listener);
+	button->AddEventListener(EventId::Mousedown, &target_listener);
+
+	// Dispatch a few times, so that reused events and buffers are exercised, including stale parameters from previous events.
+	for (int i = 0; i < 3; i++)
+	{
+		records.clear();
+
+		Dictionary parameters;
+		parameters["button"] = 1;
+		button->DispatchEvent(EventId::Mousedown, parameters);
+
+		const StringList expected = {
+			"capture:mousedown:1",
+			"target:mousedown:1",
+			"bubble:mouseup:-1",
+		};
+		CHECK(records == expected);
+	}
+
+	div->RemoveEventListener(EventId::Mousedown, &capture_listener, true);
+	div->RemoveEventListener(EventId::Mouseup, &bubble_listener);
+	button->RemoveEventListener(EventId::Mousedown, &target_listener);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("event_listener.subtree_listener_summary")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_decorator_rml, "assets/");
+	REQUIRE(document);
+	Element* button = document->GetElementById("exit");
+	REQUIRE(button);
+
+	StringList records;
+	RecordingEventListener document_listener("document", records), sibling_listener("sibling", records), child_listener("child", records);
+
+	// Listeners attached to elements outside the document must be found once the elements are inserted.
+	ElementPtr sibling_ptr = document->CreateElement("div");
+	ElementPtr child_ptr = document->CreateElement("div");
+	sibling_ptr->AddEventListener(EventId::Mouseup, &sibling_listener);
+	child_ptr->AddEventListener(EventId::Mouseup, &child_listener);
+
+	Element* sibling = document->AppendChild(std::move(sibling_ptr));
+	Element* child = sibling->AppendChild(std::move(child_ptr));
+
+	child->DispatchEvent(EventId::Mouseup, Dictionary());
+	CHECK(records == StringList{"child:mouseup:-1", "sibling:mouseup:-1"});
+
+	// Listeners in other branches must not be collected.
+	records.clear();
+	button->DispatchEvent(EventId::Mouseup, Dictionary());
+	CHECK(records.empty());
+
+	document->AddEventListener(EventId::Mouseup, &document_listener);
+	button->DispatchEvent(EventId::Mouseup, Dictionary());
+	CHECK(records == StringList{"document:mouseup:-1"});
+
+	// Detached listeners must no longer be called.
+	records.clear();
+	child->RemoveEventListener(EventId::Mouseup, &child_listener);
+	child->DispatchEvent(EventId::Mouseup, Dictionary());
+	CHECK(records == StringList{"sibling:mouseup:-1", "document:mouseup:-1"});
+
+	sibling->RemoveEventListener(EventId::Mouseup, &sibling_listener);
+	document->RemoveEventListener(EventId::Mouseup, &document_listener);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
@@ -27,6 +27,7 @@
  */
 
 #include "../Common/TestsShell.h"
+#include <RmlUi/Core/ComputedValues.h>
 #include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Core.h>
 #include <RmlUi/Core/Element.h>
@@ -138,3 +139,172 @@ TEST_CASE("Layout.Position.Relative")
 
 	TestsShell::ShutdownShell();
 }
+
+static const String document_shrink_to_fit_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body {
+			width: 500px;
+			height: 300px;
+		}
+		.shrink {
+			float: left;
+			padding: 5px;
+		}
+		.flex {
+			display: flex;
+			float: left;
+		}
+		span {
+			display: inline-block;
+			width: 50px;
+			height: 10px;
+		}
+	</style>
+</head>
+
+<body>
+	<div class="shrink" id="outer"><div class="shrink"><div class="shrink" id="inner"><span/><span/></div></div></div>
+	<div class="flex" id="flex_outer"><div class="flex"><div class="flex" id="flex_inner"><span/><span/></div></div></div>
+</body>
+</rml>
+)";
+
+TEST_CASE("Layout.ShrinkToFit.Nested")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_shrink_to_fit_rml);
+	REQUIRE(document);
+	document->Show();
+
+	Element* outer = document->GetElementById("outer");
+	Element* inner = document->GetElementById("inner");
+	Element* flex_outer = document->GetElementById("flex_outer");
+	Element* flex_inner = document->GetElementById("flex_inner");
+	REQUIRE(outer);
+	REQUIRE(inner);
+	REQUIRE(flex_outer);
+	REQUIRE(flex_inner);
+
+	TestsShell::RenderLoop();
+
+	CHECK(inner->GetClientWidth() == 100.f + 2 * 5.f);
+	CHECK(outer->GetClientWidth() == 100.f + 6 * 5.f);
+	CHECK(flex_inner->GetClientWidth() == 100.f);
+	CHECK(flex_outer->GetClientWidth() == 100.f);
+
+	// Intrinsic sizes are measured anew for each layout pass, so they should reflect any changes to the content.
+	inner->AppendChild(document->CreateElement("span"));
+	flex_inner->AppendChild(document->CreateElement("span"));
+	TestsShell::RenderLoop();
+
+	CHECK(inner->GetClientWidth() == 150.f + 2 * 5.f);
+	CHECK(outer->GetClientWidth() == 150.f + 6 * 5.f);
+	CHECK(flex_inner->GetClientWidth() == 150.f);
+	CHECK(flex_outer->GetClientWidth() == 150.f);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
+
+static const String document_table_cell_layout_rml = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/assets/rml.rcss"/>
+	<style>
+		body {
+			width: 800px;
+			font-family: LatoLatin;
+			font-size: 15px;
+		}
+		table {
+			float: left;
+			width: 240px;
+		}
+		col:first-child {
+			width: 40px;
+		}
+		td {
+			padding: 3px;
+			border: 1px #000;
+		}
+		td.middle {
+			vertical-align: middle;
+		}
+		div.half {
+			height: 50%;
+		}
+		div.zero {
+			height: 0%;
+		}
+	</style>
+</head>
+
+<body>
+	<table id="table">
+		<col/><col/><col/>
+		<tr><td>1</td><td>One</td><td>Uniform</td></tr>
+		<tr><td>2</td><td>Two lines of text in a single cell</td><td>Top</td></tr>
+		<tr><td>3</td><td class="middle">Middle</td><td>Two lines of text in a single cell</td></tr>
+		<tr><td colspan="2">4</td><td>Span</td></tr>
+		<tr><td>5</td><td><div class="half">Half</div>Two lines of text in a single cell</td><td>Percent</td></tr>
+	</table>
+	<table id="reference">
+		<col/><col/><col/>
+		<tr><td>1<div class="zero"/></td><td>One<div class="zero"/></td><td>Uniform<div class="zero"/></td></tr>
+		<tr><td>2<div class="zero"/></td><td>Two lines of text in a single cell<div class="zero"/></td><td>Top<div class="zero"/></td></tr>
+		<tr><td>3<div class="zero"/></td><td class="middle">Middle<div class="zero"/></td><td>Two lines of text in a single cell<div class="zero"/></td></tr>
+		<tr><td colspan="2">4<div class="zero"/></td><td>Span<div class="zero"/></td></tr>
+		<tr><td>5<div class="zero"/></td><td><div class="half">Half</div>Two lines of text in a single cell</td><td>Percent<div class="zero"/></td></tr>
+	</table>
+</body>
+</rml>
+)";
+
+TEST_CASE("Layout.Table.CellLayoutReuse")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(document_table_cell_layout_rml);
+	REQUIRE(document);
+	document->Show();
+
+	TestsShell::RenderLoop();
+
+	Element* table = document->GetElementById("table");
+	Element* table_reference = document->GetElementById("reference");
+	REQUIRE(table);
+	REQUIRE(table_reference);
+
+	// The reference table has content depending on the cell height in every cell, thus all its cells are formatted again with their final
+	// height. Cells whose layout is reused from when the row heights were determined should end up with the same layout.
+	ElementList cells, cells_reference;
+	table->GetElementsByTagName(cells, "td");
+	table_reference->GetElementsByTagName(cells_reference, "td");
+	REQUIRE(cells.size() == 14);
+	REQUIRE(cells.size() == cells_reference.size());
+
+	for (size_t i = 0; i < cells.size(); i++)
+	{
+		CAPTURE(i);
+		CHECK(cells[i]->GetBox() == cells_reference[i]->GetBox());
+		CHECK(cells[i]->GetRelativeOffset() == cells_reference[i]->GetRelativeOffset());
+		CHECK(cells[i]->GetFirstChild()->GetRelativeOffset() == cells_reference[i]->GetFirstChild()->GetRelativeOffset());
+	}
+
+	CHECK(table->GetBox() == table_reference->GetBox());
+
+	// Percentage heights inside the cells resolve against the definite cell height.
+	Element* cell_percent = cells[12];
+	Element* element_half = cell_percent->GetFirstChild();
+	REQUIRE(element_half->GetClassNames() == "half");
+	CHECK(element_half->GetBox().GetSize().y == doctest::Approx(0.5f * cell_percent->GetBox().GetSize().y));
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
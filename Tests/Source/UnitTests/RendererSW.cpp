@@ -0,0 +1,319 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include "../Common/TestsShell.h"
+#include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi_Renderer_SW.h>
+#include <doctest.h>
+
+using namespace Rml;
+
+static constexpr int viewport_size = 32;
+
+static CompiledGeometryHandle CompileQuad(RenderInterface_SW& renderer, Vector2f top_left, Vector2f bottom_right, ColourbPremultiplied colour)
+{
+	Vertex vertices[4];
+	vertices[0] = {top_left, colour, {0.f, 0.f}};
+	vertices[1] = {{bottom_right.x, top_left.y}, colour, {1.f, 0.f}};
+	vertices[2] = {bottom_right, colour, {1.f, 1.f}};
+	vertices[3] = {{top_left.x, bottom_right.y}, colour, {0.f, 1.f}};
+	const int indices[6] = {0, 1, 2, 0, 2, 3};
+	return renderer.CompileGeometry({vertices, 4}, {indices, 6});
+}
+
+static ColourbPremultiplied GetPixel(const RenderInterface_SW& renderer, int x, int y)
+{
+	const Vector2i dimensions = renderer.GetFramebufferDimensions();
+	REQUIRE(x >= 0);
+	REQUIRE(y >= 0);
+	REQUIRE(x < dimensions.x);
+	REQUIRE(y < dimensions.y);
+	return renderer.GetFramebuffer()[y * dimensions.x + x];
+}
+
+static const ColourbPremultiplied black(0, 0, 0, 255);
+static const ColourbPremultiplied red(255, 0, 0, 255);
+static const ColourbPremultiplied green(0, 255, 0, 255);
+static const ColourbPremultiplied blue(0, 0, 255, 255);
+
+TEST_CASE("renderer_sw.quad")
+{
+	RenderInterface_SW renderer(1);
+	renderer.SetViewport(viewport_size, viewport_size);
+	renderer.BeginFrame();
+	renderer.Clear();
+
+	const CompiledGeometryHandle quad = CompileQuad(renderer, {4.f, 4.f}, {12.f, 12.f}, red);
+	renderer.RenderGeometry(quad, {}, {});
+
+	// Pixels are covered when their centers are inside the quad.
+	CHECK(GetPixel(renderer, 4, 4) == red);
+	CHECK(GetPixel(renderer, 11, 11) == red);
+	CHECK(GetPixel(renderer, 8, 8) == red);
+	CHECK(GetPixel(renderer, 3, 8) == black);
+	CHECK(GetPixel(renderer, 12, 8) == black);
+	CHECK(GetPixel(renderer, 8, 12) == black);
+
+	// Translation, and source-over blending of a half-transparent premultiplied colour.
+	const CompiledGeometryHandle translucent_quad = CompileQuad(renderer, {0.f, 0.f}, {8.f, 8.f}, ColourbPremultiplied(0, 0, 128, 128));
+	renderer.RenderGeometry(translucent_quad, {8.f, 8.f}, {});
+	CHECK(GetPixel(renderer, 10, 10) == ColourbPremultiplied(127, 0, 128, 255));
+	CHECK(GetPixel(renderer, 14, 14) == ColourbPremultiplied(0, 0, 128, 255));
+	CHECK(GetPixel(renderer, 16, 16) == black);
+
+	renderer.EndFrame();
+	renderer.ReleaseGeometry(translucent_quad);
+	renderer.ReleaseGeometry(quad);
+}
+
+TEST_CASE("renderer_sw.scissor_and_clip_mask")
+{
+	RenderInterface_SW renderer(1);
+	renderer.SetViewport(viewport_size, viewport_size);
+	renderer.BeginFrame();
+	renderer.Clear();
+
+	const CompiledGeometryHandle full_quad = CompileQuad(renderer, {0.f, 0.f}, {float(viewport_size), float(viewport_size)}, green);
+	const CompiledGeometryHandle mask_quad = CompileQuad(renderer, {8.f, 8.f}, {16.f, 16.f}, red);
+
+	renderer.EnableScissorRegion(true);
+	renderer.SetScissorRegion(Rectanglei::FromPositionSize({4, 0}, {8, viewport_size}));
+	renderer.RenderGeometry(full_quad, {}, {});
+	renderer.EnableScissorRegion(false);
+
+	CHECK(GetPixel(renderer, 3, 20) == black);
+	CHECK(GetPixel(renderer, 4, 20) == green);
+	CHECK(GetPixel(renderer, 11, 20) == green);
+	CHECK(GetPixel(renderer, 12, 20) == black);
+
+	SUBCASE("Set")
+	{
+		renderer.RenderToClipMask(ClipMaskOperation::Set, mask_quad, {});
+		renderer.EnableClipMask(true);
+		renderer.RenderGeometry(CompileQuad(renderer, {0.f, 0.f}, {float(viewport_size), float(viewport_size)}, blue), {}, {});
+
+		CHECK(GetPixel(renderer, 8, 8) == blue);
+		CHECK(GetPixel(renderer, 15, 15) == blue);
+		CHECK(GetPixel(renderer, 16, 15) == black);
+		CHECK(GetPixel(renderer, 7, 20) == green);
+	}
+
+	SUBCASE("SetInverse")
+	{
+		renderer.RenderToClipMask(ClipMaskOperation::SetInverse, mask_quad, {});
+		renderer.EnableClipMask(true);
+		renderer.RenderGeometry(CompileQuad(renderer, {0.f, 0.f}, {float(viewport_size), float(viewport_size)}, blue), {}, {});
+
+		CHECK(GetPixel(renderer, 8, 8) == green);
+		CHECK(GetPixel(renderer, 15, 15) == black);
+		CHECK(GetPixel(renderer, 16, 15) == blue);
+		CHECK(GetPixel(renderer, 7, 20) == blue);
+	}
+
+	SUBCASE("Intersect")
+	{
+		renderer.RenderToClipMask(ClipMaskOperation::Set, mask_quad, {});
+		renderer.RenderToClipMask(ClipMaskOperation::Intersect, mask_quad, {4.f, 4.f});
+		renderer.EnableClipMask(true);
+		renderer.RenderGeometry(CompileQuad(renderer, {0.f, 0.f}, {float(viewport_size), float(viewport_size)}, blue), {}, {});
+
+		CHECK(GetPixel(renderer, 13, 9) == black);
+		CHECK(GetPixel(renderer, 12, 12) == blue);
+		CHECK(GetPixel(renderer, 15, 15) == blue);
+		CHECK(GetPixel(renderer, 19, 19) == black);
+	}
+
+	renderer.EnableClipMask(false);
+	renderer.EndFrame();
+	renderer.ReleaseGeometry(mask_quad);
+	renderer.ReleaseGeometry(full_quad);
+}
+
+TEST_CASE("renderer_sw.texture")
+{
+	RenderInterface_SW renderer(1);
+	renderer.SetViewport(viewport_size, viewport_size);
+	renderer.BeginFrame();
+	renderer.Clear();
+
+	// A 4x4 texture with a differently coloured quadrant each.
+	const Vector2i texture_dimensions(4, 4);
+	Vector<byte> texture_data(4 * 4 * 4);
+	for (int y = 0; y < texture_dimensions.y; y++)
+	{
+		for (int x = 0; x < texture_dimensions.x; x++)
+		{
+			const ColourbPremultiplied colour = (y < 2 ? (x < 2 ? red : green) : (x < 2 ? blue : ColourbPremultiplied(255, 255, 255, 255)));
+			memcpy(&texture_data[(y * texture_dimensions.x + x) * 4], &colour, 4);
+		}
+	}
+	const TextureHandle texture = renderer.GenerateTexture(texture_data, texture_dimensions);
+	REQUIRE(texture);
+
+	// Texels map one-to-one to pixels, thus, the texture should be reproduced exactly.
+	const CompiledGeometryHandle quad = CompileQuad(renderer, {0.f, 0.f}, {4.f, 4.f}, ColourbPremultiplied(255, 255, 255, 255));
+	renderer.RenderGeometry(quad, {2.f, 2.f}, texture);
+
+	CHECK(GetPixel(renderer, 2, 2) == red);
+	CHECK(GetPixel(renderer, 3, 3) == red);
+	CHECK(GetPixel(renderer, 5, 2) == green);
+	CHECK(GetPixel(renderer, 2, 5) == blue);
+	CHECK(GetPixel(renderer, 5, 5) == ColourbPremultiplied(255, 255, 255, 255));
+	CHECK(GetPixel(renderer, 6, 6) == black);
+
+	// Texels are modulated by the vertex colour.
+	const CompiledGeometryHandle tinted_quad = CompileQuad(renderer, {0.f, 0.f}, {4.f, 4.f}, ColourbPremultiplied(0, 255, 0, 255));
+	renderer.RenderGeometry(tinted_quad, {10.f, 2.f}, texture);
+	CHECK(GetPixel(renderer, 10, 2) == ColourbPremultiplied(0, 0, 0, 255));
+	CHECK(GetPixel(renderer, 13, 2) == green);
+	CHECK(GetPixel(renderer, 13, 5) == green);
+
+	renderer.EndFrame();
+	renderer.ReleaseGeometry(tinted_quad);
+	renderer.ReleaseGeometry(quad);
+	renderer.ReleaseTexture(texture);
+}
+
+TEST_CASE("renderer_sw.transform")
+{
+	RenderInterface_SW renderer(1);
+	renderer.SetViewport(viewport_size, viewport_size);
+	renderer.BeginFrame();
+	renderer.Clear();
+
+	const CompiledGeometryHandle quad = CompileQuad(renderer, {0.f, 0.f}, {4.f, 4.f}, red);
+
+	const Matrix4f transform = Matrix4f::Translate(16.f, 8.f, 0.f) * Matrix4f::Scale(2.f, 3.f, 1.f);
+	renderer.SetTransform(&transform);
+	renderer.RenderGeometry(quad, {}, {});
+	renderer.SetTransform(nullptr);
+
+	CHECK(GetPixel(renderer, 0, 0) == black);
+	CHECK(GetPixel(renderer, 15, 8) == black);
+	CHECK(GetPixel(renderer, 16, 8) == red);
+	CHECK(GetPixel(renderer, 23, 19) == red);
+	CHECK(GetPixel(renderer, 24, 19) == black);
+	CHECK(GetPixel(renderer, 23, 20) == black);
+
+	renderer.EndFrame();
+	renderer.ReleaseGeometry(quad);
+}
+
+TEST_CASE("renderer_sw.bands")
+{
+	// Large draw calls are rasterized in bands on multiple threads, the result should be the same as on a single thread.
+	const int size = 300;
+	Vector<ColourbPremultiplied> results[2];
+
+	for (int i = 0; i < 2; i++)
+	{
+		RenderInterface_SW renderer(i == 0 ? 1 : 4);
+		renderer.SetViewport(size, size);
+		renderer.BeginFrame();
+		renderer.Clear();
+
+		Vertex vertices[3] = {
+			{{10.f, 5.f}, red, {}},
+			{{290.f, 150.f}, green, {}},
+			{{40.f, 295.f}, blue, {}},
+		};
+		const int indices[3] = {0, 1, 2};
+		const CompiledGeometryHandle triangle = renderer.CompileGeometry({vertices, 3}, {indices, 3});
+		renderer.RenderGeometry(triangle, {}, {});
+		renderer.EndFrame();
+		renderer.ReleaseGeometry(triangle);
+
+		const Span<const ColourbPremultiplied> framebuffer = renderer.GetFramebuffer();
+		results[i].assign(framebuffer.begin(), framebuffer.end());
+
+		const ColourbPremultiplied near_red_vertex = GetPixel(renderer, 12, 8);
+		CHECK(near_red_vertex.red > 245);
+		CHECK(near_red_vertex.alpha == 255);
+		const ColourbPremultiplied center = GetPixel(renderer, 113, 150);
+		CHECK(center.red > 70);
+		CHECK(center.green > 70);
+		CHECK(center.blue > 70);
+		CHECK(GetPixel(renderer, 299, 299) == black);
+	}
+
+	CHECK(results[0] == results[1]);
+}
+
+TEST_CASE("renderer_sw.document")
+{
+	RenderInterface_SW renderer(1);
+	Context* context = TestsShell::GetContext(false, &renderer);
+	REQUIRE(context);
+	renderer.SetViewport(context->GetDimensions().x, context->GetDimensions().y);
+
+	ElementDocument* document = context->LoadDocumentFromMemory(R"(
+<rml>
+<head>
+	<style>
+		body { display: block; position: absolute; top: 0; left: 0; width: 100%; height: 100%; }
+		div { position: absolute; width: 20px; height: 10px; }
+		#plain { left: 10px; top: 10px; background-color: #f00; }
+		#clipped { left: 50px; top: 10px; width: 10px; overflow: hidden; }
+		#clipped div { display: block; position: static; width: 40px; background-color: #0f0; }
+		#rotated { left: 100px; top: 10px; background-color: #00f; transform: rotate(90deg); }
+	</style>
+</head>
+<body>
+	<div id="plain"/>
+	<div id="clipped"><div/></div>
+	<div id="rotated"/>
+</body>
+</rml>
+)");
+	REQUIRE(document);
+	document->Show();
+
+	context->Update();
+	renderer.BeginFrame();
+	renderer.Clear();
+	context->Render();
+	renderer.EndFrame();
+
+	CHECK(GetPixel(renderer, 10, 10) == red);
+	CHECK(GetPixel(renderer, 29, 19) == red);
+	CHECK(GetPixel(renderer, 30, 19) == black);
+
+	// The child is clipped by the overflow of its parent.
+	CHECK(GetPixel(renderer, 59, 15) == green);
+	CHECK(GetPixel(renderer, 60, 15) == black);
+
+	// Rotated around its center (110, 15), the 20x10 box becomes 10x20.
+	CHECK(GetPixel(renderer, 110, 6) == blue);
+	CHECK(GetPixel(renderer, 110, 23) == blue);
+	CHECK(GetPixel(renderer, 101, 15) == black);
+	CHECK(GetPixel(renderer, 118, 15) == black);
+
+	document->Close();
+	TestsShell::ShutdownShell();
+}
@@ -26,13 +26,22 @@
  *
  */
 
+#include "../../../Source/Core/StyleSheetBinary.h"
+#include "../Common/TestsInterface.h"
 #include "../Common/TestsShell.h"
+#include <RmlUi/Core/Context.h>
 #include <RmlUi/Core/Core.h>
+#include <RmlUi/Core/Element.h>
+#include <RmlUi/Core/ElementDocument.h>
+#include <RmlUi/Core/Factory.h>
 #include <RmlUi/Core/Spritesheet.h>
 #include <RmlUi/Core/StreamMemory.h>
 #include <RmlUi/Core/StyleSheet.h>
 #include <RmlUi/Core/StyleSheetContainer.h>
+#include <RmlUi/Core/StyleSheetSpecification.h>
+#include <RmlUi/Core/Tween.h>
 #include <doctest.h>
+#include <string.h>
 
 static const char spritesheet[] = R"(
 @spritesheet test_sheet {
@@ -56,8 +65,132 @@ static const char spritesheet_with_path_string_encoding[] = R"(
 }
 )";
 
+static const char binary_style_sheet[] = R"(
+@spritesheet binary_sheet {
+	src: /assets/high_scores_alien_3.tga;
+	alien: 0px 0px 64px 64px;
+	resolution: 2x;
+}
+@decorator stripes : horizontal-gradient {
+	start-color: #f00;
+	stop-color: #00f;
+}
+@keyframes pulse {
+	from { opacity: 0; }
+	50% { opacity: 0.8; }
+	to { opacity: 1; }
+}
+body { font-family: LatoLatin; }
+div { display: block; height: 20px; transition: opacity 0.5s cubic-in-out; }
+#a { decorator: stripes; transform: rotate(10deg) translateX(5px); }
+.b:not(:first-child) > p, .c + p { color: #0f0; box-shadow: #000 2px 2px 4px; font-effect: outline(2px #fff); }
+p[lang|=en] { animation: 2s linear-in-out infinite pulse; filter: blur(2px) opacity(0.5); background-color: #123456; }
+span { decorator: image(alien), linear-gradient(45deg, #f00 10%, #0f0 50%) border-box; }
+@media (min-width: 100px) {
+	div { width: 50px; }
+}
+@media not (min-width: 100000px) {
+	#a { width: 70px; }
+}
+)";
+
+static const char binary_transition_style_sheet[] = R"(
+div { transition: opacity 1s cubic-in-out; }
+)";
+
+static const char binary_document_rml[] = R"(
+<rml>
+<head/>
+<body>
+	<div id="a"><span/></div>
+	<div class="b"><p/></div>
+	<div class="b"><p lang="en-US"/></div>
+	<div class="c"/>
+	<p/>
+</body>
+</rml>
+)";
+
+static const char preload_document_rml[] = R"(
+<rml>
+<head>
+	<link type="text/rcss" href="/../Tests/Data/style.rcss"/>
+	<link type="text/rcss" href="/../Tests/Data/UnitTests/Specificity_Basic.rcss"/>
+</head>
+<body class="a">
+	<h1/>
+	<div class="b"><p/></div>
+	<div class="c"/>
+</body>
+</rml>
+)";
+
 using namespace Rml;
 
+// Ignores the errors logged while loading invalid data, the tests instead check that the data is rejected.
+class IgnoreErrorsSystemInterface : public TestsSystemInterface {
+public:
+	bool LogMessage(Log::Type /*type*/, const String& /*message*/) override { return true; }
+};
+
+static String CompileStyleSheet(const char* source)
+{
+	StyleSheetContainer container;
+	StreamMemory stream{reinterpret_cast<const byte*>(source), strlen(source)};
+	String data;
+	REQUIRE(container.LoadStyleSheetContainer(&stream));
+	REQUIRE(container.SerializeStyleSheetContainer(data));
+	return data;
+}
+
+static bool LoadCompiledStyleSheet(const String& data, StyleSheetContainer& container)
+{
+	StreamMemory stream{reinterpret_cast<const byte*>(data.data()), data.size()};
+	return container.LoadStyleSheetContainer(&stream);
+}
+
+static bool LoadCompiledStyleSheet(const String& data)
+{
+	StyleSheetContainer container;
+	return LoadCompiledStyleSheet(data, container);
+}
+
+static int32_t GetInteger(const String& data, size_t offset)
+{
+	int32_t value = 0;
+	REQUIRE(offset + sizeof(value) <= data.size());
+	memcpy(&value, data.data() + offset, sizeof(value));
+	return value;
+}
+
+static String SetInteger(String data, size_t offset, int32_t value)
+{
+	REQUIRE(offset + sizeof(value) <= data.size());
+	memcpy(&data[offset], &value, sizeof(value));
+	return data;
+}
+
+static void CheckMatchingStyle(Element* expected, Element* actual)
+{
+	REQUIRE(expected->GetNumChildren() == actual->GetNumChildren());
+
+	for (PropertyId id : StyleSheetSpecification::GetRegisteredProperties())
+	{
+		const Property* expected_property = expected->GetProperty(id);
+		const Property* actual_property = actual->GetProperty(id);
+		CAPTURE(StyleSheetSpecification::GetPropertyName(id));
+		REQUIRE((expected_property != nullptr) == (actual_property != nullptr));
+		if (expected_property)
+		{
+			CHECK(expected_property->ToString() == actual_property->ToString());
+			CHECK(expected_property->specificity == actual_property->specificity);
+		}
+	}
+
+	for (int i = 0; i < expected->GetNumChildren(); i++)
+		CheckMatchingStyle(expected->GetChild(i), actual->GetChild(i));
+}
+
 TEST_CASE("style_sheet_parser.spritesheet")
 {
 	Context* context = TestsShell::GetContext();
@@ -156,3 +289,172 @@ TEST_CASE("style_sheet_parser.spritesheet_with_path_string_encoding")
 
 	TestsShell::ShutdownShell();
 }
+
+TEST_CASE("style_sheet_parser.binary")
+{
+	Context* context = TestsShell::GetContext();
+
+	auto source_container = MakeShared<StyleSheetContainer>();
+	StreamMemory source_stream{reinterpret_cast<const byte*>(binary_style_sheet), sizeof(binary_style_sheet) - 1};
+	REQUIRE(source_container->LoadStyleSheetContainer(&source_stream));
+
+	String data;
+	REQUIRE(source_container->SerializeStyleSheetContainer(data));
+
+	auto binary_container = MakeShared<StyleSheetContainer>();
+	StreamMemory binary_stream{reinterpret_cast<const byte*>(data.data()), data.size()};
+	REQUIRE(binary_container->LoadStyleSheetContainer(&binary_stream));
+
+	binary_container->UpdateCompiledStyleSheet(context);
+	const StyleSheet* style_sheet = binary_container->GetCompiledStyleSheet();
+	REQUIRE(style_sheet);
+
+	const Sprite* sprite = style_sheet->GetSprite("alien");
+	REQUIRE(sprite);
+	CHECK(sprite->sprite_sheet->name == "binary_sheet");
+	CHECK(sprite->sprite_sheet->display_scale == 0.5f);
+	CHECK(sprite->rectangle.BottomRight() == Vector2f(64.f, 64.f));
+
+	const Keyframes* keyframes = style_sheet->GetKeyframes("pulse");
+	REQUIRE(keyframes);
+	CHECK(keyframes->blocks.size() == 3);
+	CHECK(keyframes->property_ids == Vector<PropertyId>{PropertyId::Opacity});
+
+	CHECK(style_sheet->GetNamedDecorator("stripes") != nullptr);
+
+	// Both style sheets should produce identical styles on the same document.
+	ElementDocument* source_document = context->LoadDocumentFromMemory(binary_document_rml);
+	ElementDocument* binary_document = context->LoadDocumentFromMemory(binary_document_rml);
+	REQUIRE(source_document);
+	REQUIRE(binary_document);
+	source_document->SetStyleSheetContainer(source_container);
+	binary_document->SetStyleSheetContainer(binary_container);
+	source_document->Show();
+	binary_document->Show();
+	context->Update();
+
+	CheckMatchingStyle(source_document, binary_document);
+
+	// Truncated data must be rejected.
+	TestsShell::SetNumExpectedWarnings(1);
+	StyleSheetContainer truncated_container;
+	StreamMemory truncated_stream{reinterpret_cast<const byte*>(data.data()), data.size() / 2};
+	CHECK_FALSE(truncated_container.LoadStyleSheetContainer(&truncated_stream));
+
+	source_document->Close();
+	binary_document->Close();
+
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("style_sheet_parser.binary_invalid")
+{
+	IgnoreErrorsSystemInterface system_interface;
+	TestsRenderInterface render_interface;
+	SetRenderInterface(&render_interface);
+	SetSystemInterface(&system_interface);
+	Rml::Initialise();
+
+	const String data = CompileStyleSheet(binary_style_sheet);
+	REQUIRE(LoadCompiledStyleSheet(data));
+
+	// The header ends with the library version, and is followed by the number of media blocks.
+	const size_t header_size = data.find(GetVersion()) + GetVersion().size();
+	REQUIRE(header_size > StyleSheetBinary::SignatureSize);
+
+	SUBCASE("Truncated")
+	{
+		// Shorter data does not hold the full signature, and is parsed as RCSS instead.
+		for (size_t size = StyleSheetBinary::SignatureSize; size < data.size(); size++)
+		{
+			CAPTURE(size);
+			CHECK_FALSE(LoadCompiledStyleSheet(data.substr(0, size)));
+		}
+	}
+
+	SUBCASE("Garbage")
+	{
+		uint32_t seed = 1;
+		String garbage = data.substr(0, StyleSheetBinary::SignatureSize);
+		for (int i = 0; i < 4096; i++)
+		{
+			seed = seed * 1664525u + 1013904223u;
+			garbage += static_cast<char>(seed >> 24);
+		}
+		CHECK_FALSE(LoadCompiledStyleSheet(garbage));
+
+		// Any corrupted byte must either be rejected, or result in style sheets that are valid enough to be compiled again.
+		for (size_t i = header_size; i < data.size(); i++)
+		{
+			for (char value : {'\x02', '\x7f', '\xff'})
+			{
+				CAPTURE(i);
+				CAPTURE(int(value));
+				String corrupted = data;
+				corrupted[i] = value;
+				StyleSheetContainer container;
+				String recompiled;
+				if (LoadCompiledStyleSheet(corrupted, container))
+					CHECK(container.SerializeStyleSheetContainer(recompiled));
+			}
+		}
+	}
+
+	SUBCASE("Enumerations")
+	{
+		// The first media block modifier follows the header and the number of media blocks.
+		const size_t modifier_offset = header_size + sizeof(uint32_t);
+		REQUIRE(GetInteger(data, modifier_offset) == static_cast<int32_t>(MediaQueryModifier::None));
+		CHECK(LoadCompiledStyleSheet(SetInteger(data, modifier_offset, static_cast<int32_t>(MediaQueryModifier::Not))));
+		CHECK_FALSE(LoadCompiledStyleSheet(SetInteger(data, modifier_offset, 2)));
+		CHECK_FALSE(LoadCompiledStyleSheet(SetInteger(data, modifier_offset, -1)));
+
+		// The tween of the only transition is followed by its duration, delay, and reverse adjustment factor, and finally by the empty
+		// lists of node children, keyframes, decorators, and sprite sheets.
+		const String transition_data = CompileStyleSheet(binary_transition_style_sheet);
+		const size_t tween_out_offset = transition_data.size() - 8 * sizeof(int32_t);
+		const size_t tween_in_offset = tween_out_offset - sizeof(int32_t);
+		REQUIRE(GetInteger(transition_data, tween_in_offset) == Tween::Cubic);
+		REQUIRE(GetInteger(transition_data, tween_out_offset) == Tween::Cubic);
+
+		CHECK(LoadCompiledStyleSheet(SetInteger(transition_data, tween_out_offset, Tween::Bounce)));
+		CHECK(LoadCompiledStyleSheet(SetInteger(transition_data, tween_in_offset, Tween::None)));
+		CHECK_FALSE(LoadCompiledStyleSheet(SetInteger(transition_data, tween_in_offset, Tween::Callback)));
+		CHECK_FALSE(LoadCompiledStyleSheet(SetInteger(transition_data, tween_out_offset, Tween::Count)));
+		CHECK_FALSE(LoadCompiledStyleSheet(SetInteger(transition_data, tween_out_offset, -1)));
+	}
+
+	Rml::Shutdown();
+}
+
+TEST_CASE("style_sheet_parser.preload")
+{
+	Context* context = TestsShell::GetContext();
+
+	// Documents loaded with preloaded style sheets should be styled identically to those loading the sheets themselves.
+	Factory::ClearStyleSheetCache();
+	ElementDocument* serial_document = context->LoadDocumentFromMemory(preload_document_rml);
+	REQUIRE(serial_document);
+
+	Factory::ClearStyleSheetCache();
+	const StringList sheets = {"../Tests/Data/style.rcss", "../Tests/Data/UnitTests/Specificity_Basic.rcss", "../Tests/Data/style.rcss"};
+	CHECK(Factory::PreloadStyleSheets(sheets, 2));
+
+	ElementDocument* preloaded_document = context->LoadDocumentFromMemory(preload_document_rml);
+	REQUIRE(preloaded_document);
+
+	serial_document->Show();
+	preloaded_document->Show();
+	context->Update();
+
+	CheckMatchingStyle(serial_document, preloaded_document);
+
+	TestsShell::SetNumExpectedWarnings(1);
+	const StringList missing_sheets = {"../Tests/Data/UnitTests/Specificity_Basic.rcss", "does/not/exist.rcss"};
+	CHECK_FALSE(Factory::PreloadStyleSheets(missing_sheets, 0));
+
+	serial_document->Close();
+	preloaded_document->Close();
+
+	TestsShell::ShutdownShell();
+}
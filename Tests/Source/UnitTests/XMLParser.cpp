@@ -26,13 +26,18 @@
  *
  */
 
+#include "../../../Source/Core/XMLPrototype.h"
 #include "../Common/TestsShell.h"
 #include <RmlUi/Core/ComputedValues.h>
 #include <RmlUi/Core/Context.h>
+#include <RmlUi/Core/DataModelHandle.h>
 #include <RmlUi/Core/Element.h>
 #include <RmlUi/Core/ElementDocument.h>
 #include <RmlUi/Core/ElementText.h>
 #include <RmlUi/Core/Factory.h>
+#include <RmlUi/Core/URL.h>
+#include <RmlUi/Core/XMLNodeHandler.h>
+#include <RmlUi/Core/XMLParser.h>
 #include <doctest.h>
 
 using namespace Rml;
@@ -196,3 +201,145 @@ TEST_CASE("XMLParser.comments_and_cdata")
 	}
 	TestsShell::ShutdownShell();
 }
+
+class XMLNodeHandlerLineNumber : public XMLNodeHandler {
+public:
+	Element* ElementStart(XMLParser* parser, const String& /*name*/, const XMLAttributes& attributes) override
+	{
+		lines.push_back(CreateString("%s:%d:%s", parser->GetSourceURL().GetURL().c_str(), parser->GetLineNumberOpenTag(),
+			attributes.empty() ? "" : attributes.begin()->second.Get<String>().c_str()));
+		return nullptr;
+	}
+	bool ElementEnd(XMLParser* /*parser*/, const String& /*name*/) override { return true; }
+	bool ElementData(XMLParser* /*parser*/, const String& /*data*/, XMLDataType /*type*/) override { return true; }
+
+	StringList lines;
+};
+
+TEST_CASE("XMLParser.document_cache")
+{
+	const String document_source = R"(<rml>
+	<head>
+		<style>
+		body {
+			font-family: LatoLatin;
+		}
+		</style>
+	</head>
+	<body>
+		<p id="p">Hello <em>world</em>&#x20AC;</p>
+		<line-test value="a"/>
+		<div data-model="cache">
+			<p data-for="i : items">{{ i }}<line-test value="b"/></p>
+		</div>
+	</body>
+</rml>)";
+
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	auto line_handler = MakeShared<XMLNodeHandlerLineNumber>();
+	XMLParser::RegisterNodeHandler("line-test", line_handler);
+
+	Vector<int> items = {1, 2, 3};
+	DataModelConstructor constructor = context->CreateDataModel("cache");
+	REQUIRE(constructor);
+	REQUIRE(constructor.RegisterArray<Vector<int>>());
+	REQUIRE(constructor.Bind("items", &items));
+
+	String first_inner_rml;
+	StringList first_lines;
+
+	// Subsequent loads of the same source are instanced from the cached prototype, they should produce identical results.
+	for (int i = 0; i < 3; i++)
+	{
+		line_handler->lines.clear();
+
+		ElementDocument* document = context->LoadDocumentFromMemory(document_source, "cache_test.rml");
+		REQUIRE(document);
+		context->Update();
+
+		const String inner_rml = document->GetInnerRML();
+		if (i == 0)
+		{
+			first_inner_rml = inner_rml;
+			first_lines = line_handler->lines;
+			CHECK(first_lines.size() == 4);
+			CHECK(first_lines[0] == "cache_test.rml:11:a");
+		}
+		else
+		{
+			CHECK(inner_rml == first_inner_rml);
+			CHECK(line_handler->lines == first_lines);
+		}
+
+		Element* p = document->GetElementById("p");
+		REQUIRE(p);
+		CHECK(p->GetInnerRML() == "Hello <em>world</em>\xe2\x82\xac");
+
+		document->Close();
+		context->Update();
+
+		if (i == 1)
+			Factory::ClearDocumentCache();
+	}
+
+	// Changing the contents must not return the previously cached prototype.
+	const String modified_source = StringUtilities::Replace(document_source, "Hello", "Goodbye");
+	ElementDocument* document = context->LoadDocumentFromMemory(modified_source, "cache_test.rml");
+	REQUIRE(document);
+	Element* p = document->GetElementById("p");
+	REQUIRE(p);
+	CHECK(p->GetInnerRML() == "Goodbye <em>world</em>\xe2\x82\xac");
+	document->Close();
+
+	context->RemoveDataModel("cache");
+	TestsShell::ShutdownShell();
+}
+
+TEST_CASE("XMLParser.document_cache_policy")
+{
+	Context* context = TestsShell::GetContext();
+	REQUIRE(context);
+
+	Factory::ClearDocumentCache();
+	CHECK(XMLPrototype::GetNumCachedPrototypes() == 0);
+
+	// Documents are always cached.
+	ElementDocument* document = context->LoadDocumentFromMemory("<rml><body><div id='div'/></body></rml>", "cache_policy.rml");
+	REQUIRE(document);
+	CHECK(XMLPrototype::GetNumCachedPrototypes() == 1);
+
+	Element* div = document->GetElementById("div");
+	REQUIRE(div);
+
+	// Unique inner RML is not cached.
+	for (int i = 0; i < 10; i++)
+		div->SetInnerRML(CreateString("<span>%d</span>", i));
+	CHECK(XMLPrototype::GetNumCachedPrototypes() == 1);
+
+	// Repeated inner RML is cached the second time it is parsed.
+	div->SetInnerRML("<span>repeated</span>");
+	CHECK(XMLPrototype::GetNumCachedPrototypes() == 1);
+	div->SetInnerRML("<span>repeated</span>");
+	CHECK(XMLPrototype::GetNumCachedPrototypes() == 2);
+	div->SetInnerRML("<span>repeated</span>");
+	CHECK(XMLPrototype::GetNumCachedPrototypes() == 2);
+	CHECK(div->GetInnerRML() == "<span>repeated</span>");
+
+	// The least recently used prototypes are evicted when the cache is full, instead of flushing all of them.
+	for (int i = 0; i < 300; i++)
+	{
+		const String rml = CreateString("<p>%d</p>", i);
+		div->SetInnerRML(rml);
+		div->SetInnerRML(rml);
+	}
+	CHECK(XMLPrototype::GetNumCachedPrototypes() == 256);
+	CHECK(div->GetInnerRML() == "<p>299</p>");
+
+	document->Close();
+	Factory::ClearDocumentCache();
+	CHECK(XMLPrototype::GetNumCachedPrototypes() == 0);
+
+	TestsShell::ShutdownShell();
+}
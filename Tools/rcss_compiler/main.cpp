@@ -0,0 +1,79 @@
+/*
+ * This source file is part of RmlUi, the HTML/CSS Interface Middleware
+ *
+ * For the latest information, see http://github.com/mikke89/RmlUi
+ *
+ * Copyright (c) 2008-2010 CodePoint Ltd, Shift Technology Ltd
+ * Copyright (c) 2019-2023 The RmlUi Team, and contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ */
+
+#include <RmlUi/Core.h>
+#include <stdio.h>
+
+/*
+    Compiles RCSS style sheets into the binary style sheet format.
+
+    The compiled files can be referenced by documents and loaded in place of their sources, skipping all style sheet
+    parsing at startup. Compiled files are only compatible with the exact library version and platform they were made
+    with, thus they should be rebuilt as part of the application build. Relative image paths are resolved against the
+    location of the source style sheet as given on the command line, not the location of the compiled file.
+
+    Usage: rmlui_rcss_compiler <input.rcss> <output>
+*/
+
+int main(int argc, char** argv)
+{
+	if (argc != 3)
+	{
+		fprintf(stderr, "Usage: %s <input.rcss> <output>\n", argv[0]);
+		return 2;
+	}
+
+	const Rml::String input_path = argv[1];
+	const Rml::String output_path = argv[2];
+
+	if (!Rml::Initialise())
+		return 1;
+
+	Rml::String data;
+	const bool result = Rml::Factory::CompileStyleSheetFile(input_path, data);
+
+	Rml::Shutdown();
+
+	if (!result)
+	{
+		fprintf(stderr, "Failed to compile style sheet '%s'.\n", input_path.c_str());
+		return 1;
+	}
+
+	FILE* file = fopen(output_path.c_str(), "wb");
+	if (!file || fwrite(data.data(), 1, data.size(), file) != data.size())
+	{
+		fprintf(stderr, "Failed to write compiled style sheet to '%s'.\n", output_path.c_str());
+		if (file)
+			fclose(file);
+		return 1;
+	}
+	fclose(file);
+
+	return 0;
+}